@@ -0,0 +1,44 @@
+/**
+ * LVGL configuration for the headless UI tests.
+ * Only what differs from LVGL's defaults is set; rendering options follow the device
+ * (sdkconfig.defaults) so the captured frames match what the panel shows.
+ */
+#if 1 /* Enable content */
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+/* Color depth as configured on the device; the display itself renders RGB565 */
+#define LV_COLOR_DEPTH 32
+
+/* LVGL's own heap, sized generously: the tests measure rendering, not memory */
+#define LV_USE_STDLIB_MALLOC LV_STDLIB_BUILTIN
+#define LV_USE_STDLIB_STRING LV_STDLIB_BUILTIN
+#define LV_USE_STDLIB_SPRINTF LV_STDLIB_BUILTIN
+#define LV_MEM_SIZE (512 * 1024)
+
+/* Single-threaded, software rendering with one draw unit: frames are deterministic */
+#define LV_USE_OS LV_OS_NONE
+#define LV_DRAW_SW_DRAW_UNIT_CNT 1
+#define LV_DEF_REFR_PERIOD 33
+
+/* Features the UI relies on (matching sdkconfig.defaults) */
+#define LV_USE_FLOAT 1
+#define LV_USE_OBSERVER 1
+#define LV_USE_SNAPSHOT 1
+#define LV_USE_CANVAS 1
+
+/* Fonts used by main/ui */
+#define LV_FONT_MONTSERRAT_12 1
+#define LV_FONT_MONTSERRAT_14 1
+#define LV_FONT_MONTSERRAT_24 1
+#define LV_FONT_DEFAULT &lv_font_montserrat_14
+
+#define LV_USE_LOG 1
+#define LV_LOG_LEVEL LV_LOG_LEVEL_WARN
+#define LV_LOG_PRINTF 1
+
+#define LV_USE_ASSERT_NULL 1
+#define LV_USE_ASSERT_MALLOC 1
+
+#endif /* LV_CONF_H */
+#endif /* Enable content */
@@ -0,0 +1,19 @@
+#include "host_clock.h"
+#include "esp_timer.h"
+
+static uint32_t now_ms = 0;
+
+uint32_t host_clock_ms(void)
+{
+  return now_ms;
+}
+
+void host_clock_advance(uint32_t ms)
+{
+  now_ms += ms;
+}
+
+int64_t esp_timer_get_time(void)
+{
+  return (int64_t)now_ms * 1000;
+}
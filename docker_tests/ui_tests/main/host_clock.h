@@ -0,0 +1,8 @@
+#pragma once
+
+#include <stdint.h>
+
+/* Simulated time shared by lv_tick and esp_timer_get_time(); only moves when a scenario advances it */
+uint32_t host_clock_ms(void);
+
+void host_clock_advance(uint32_t ms);
@@ -0,0 +1,103 @@
+#include "host_display.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define STATS_TIME_UNIT_US 1000
+#define STATS_AREA_UNIT_PX 1024
+
+static uint16_t *framebuffer = NULL;
+static int32_t fb_width;
+static int32_t fb_height;
+
+static host_display_stats_t stats;
+static int64_t frame_start_us;
+static uint32_t frame_area_px;
+
+/* Render time is real CPU work, so it is measured on the host clock, not the simulated one */
+static int64_t monotonic_us(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+  int32_t width = lv_area_get_width(area);
+  const uint16_t *src = (const uint16_t *)px_map;
+  for (int32_t y = area->y1; y <= area->y2; y++)
+  {
+    memcpy(&framebuffer[y * fb_width + area->x1], src, width * sizeof(uint16_t));
+    src += width;
+  }
+  frame_area_px += lv_area_get_size(area);
+  lv_display_flush_ready(disp);
+}
+
+static void render_event_cb(lv_event_t *e)
+{
+  if (lv_event_get_code(e) == LV_EVENT_RENDER_START)
+  {
+    frame_start_us = monotonic_us();
+    frame_area_px = 0;
+    return;
+  }
+
+  frame_histogram_add(&stats.render_us, (uint32_t)(monotonic_us() - frame_start_us));
+  frame_histogram_add(&stats.area_px, frame_area_px);
+  stats.total_area_px += frame_area_px;
+  stats.frames++;
+}
+
+lv_display_t *host_display_create(int32_t width, int32_t height, uint32_t stripe_lines)
+{
+  fb_width = width;
+  fb_height = height;
+  framebuffer = calloc((size_t)width * height, sizeof(uint16_t));
+
+  size_t stripe_bytes = (size_t)width * stripe_lines * sizeof(uint16_t);
+  void *stripe = malloc(stripe_bytes);
+  lv_display_t *disp = lv_display_create(width, height);
+  if (framebuffer == NULL || stripe == NULL || disp == NULL)
+  {
+    return NULL;
+  }
+
+  lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+  lv_display_set_buffers(disp, stripe, NULL, stripe_bytes, LV_DISPLAY_RENDER_MODE_PARTIAL);
+  lv_display_set_flush_cb(disp, flush_cb);
+  lv_display_add_event_cb(disp, render_event_cb, LV_EVENT_RENDER_START, NULL);
+  lv_display_add_event_cb(disp, render_event_cb, LV_EVENT_RENDER_READY, NULL);
+  host_display_reset_stats();
+  return disp;
+}
+
+void host_display_reset_stats(void)
+{
+  memset(&stats, 0, sizeof(stats));
+  frame_histogram_init(&stats.render_us, STATS_TIME_UNIT_US);
+  frame_histogram_init(&stats.area_px, STATS_AREA_UNIT_PX);
+}
+
+const host_display_stats_t *host_display_get_stats(void)
+{
+  return &stats;
+}
+
+bool host_display_capture(png_image_t *img)
+{
+  if (!png_image_alloc(img, fb_width, fb_height))
+  {
+    return false;
+  }
+  for (int32_t i = 0; i < fb_width * fb_height; i++)
+  {
+    uint16_t px = framebuffer[i];
+    uint8_t *out = &img->rgb[i * 3];
+    out[0] = (uint8_t)(((px >> 11) & 0x1F) * 255 / 31);
+    out[1] = (uint8_t)(((px >> 5) & 0x3F) * 255 / 63);
+    out[2] = (uint8_t)((px & 0x1F) * 255 / 31);
+  }
+  return true;
+}
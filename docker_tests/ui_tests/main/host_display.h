@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdint.h>
+#include "lvgl.h"
+#include "frame_histogram.h"
+#include "png_image.h"
+
+/* Per-frame measurements since the last host_display_reset_stats() */
+typedef struct
+{
+  frame_histogram_t render_us; /* Wall-clock time from render start to render ready */
+  frame_histogram_t area_px;   /* Pixels flushed per frame */
+  uint32_t frames;
+  uint64_t total_area_px;
+} host_display_stats_t;
+
+/**
+ * Creates an LVGL display that renders into a memory framebuffer, configured like the device:
+ * RGB565, partial rendering through a stripe buffer of the given height.
+ */
+lv_display_t *host_display_create(int32_t width, int32_t height, uint32_t stripe_lines);
+
+void host_display_reset_stats(void);
+
+const host_display_stats_t *host_display_get_stats(void);
+
+/** Converts the framebuffer to an 8-bit RGB image (allocated; free with png_image_free()). */
+bool host_display_capture(png_image_t *img);
@@ -0,0 +1,90 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "lvgl.h"
+#include "product_pins.h"
+#include "ui/ui.h"
+#include "host_clock.h"
+#include "host_display.h"
+#include "ui_test.h"
+
+#define STRIPE_LINES 32 // Same as the DISPLAY_BUFFER_LINES default on the device
+
+static void usage(const char *argv0)
+{
+  printf("Usage: %s [--golden DIR] [--out DIR] [--update] [--tolerance N] [--render-budget-us N]\n", argv0);
+  printf("  --golden DIR           Reference images (default: golden)\n");
+  printf("  --out DIR              Captured frames and diffs (default: frames)\n");
+  printf("  --update               Rewrite the reference images from this run\n");
+  printf("  --tolerance N          Per-channel difference still accepted (default: 0)\n");
+  printf("  --render-budget-us N   Largest p95 render time per scenario (default: 16000)\n");
+}
+
+int main(int argc, char *argv[])
+{
+  ui_test_options_t options = {
+      .golden_dir = "golden",
+      .out_dir = "frames",
+      .update = false,
+      .tolerance = 0,
+      .render_budget_us = 16000,
+  };
+
+  for (int i = 1; i < argc; i++)
+  {
+    bool has_value = i + 1 < argc;
+    if (strcmp(argv[i], "--golden") == 0 && has_value)
+    {
+      options.golden_dir = argv[++i];
+    }
+    else if (strcmp(argv[i], "--out") == 0 && has_value)
+    {
+      options.out_dir = argv[++i];
+    }
+    else if (strcmp(argv[i], "--update") == 0)
+    {
+      options.update = true;
+    }
+    else if (strcmp(argv[i], "--tolerance") == 0 && has_value)
+    {
+      options.tolerance = (uint8_t)atoi(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--render-budget-us") == 0 && has_value)
+    {
+      options.render_budget_us = (uint32_t)strtoul(argv[++i], NULL, 10);
+    }
+    else
+    {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  mkdir(options.out_dir, 0755);
+  if (options.update)
+  {
+    mkdir(options.golden_dir, 0755);
+  }
+
+  lv_init();
+  lv_tick_set_cb(host_clock_ms);
+  if (host_display_create(AMOLED_WIDTH, AMOLED_HEIGHT, STRIPE_LINES) == NULL)
+  {
+    printf("Failed to create the host display\n");
+    return 1;
+  }
+  ui_test_init(&options);
+
+  printf("Starting UI scenario tests...\n");
+  init_ui();
+  for (int i = 0; i < ui_scenario_count; i++)
+  {
+    ui_test_begin(ui_scenarios[i].name);
+    ui_scenarios[i].run();
+    ui_test_end();
+  }
+
+  int failures = ui_test_failures();
+  printf("%d scenarios, %d failures\n", ui_scenario_count, failures);
+  return failures == 0 ? 0 : 1;
+}
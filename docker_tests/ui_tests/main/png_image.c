@@ -0,0 +1,314 @@
+#include "png_image.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFLATE_STORED_MAX 65535 // Largest uncompressed deflate block
+
+static const uint8_t png_signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+static uint32_t crc_table[256];
+
+static uint32_t crc32_update(uint32_t crc, const uint8_t *data, size_t len)
+{
+  if (crc_table[1] == 0)
+  {
+    for (uint32_t n = 0; n < 256; n++)
+    {
+      uint32_t c = n;
+      for (int k = 0; k < 8; k++)
+      {
+        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      }
+      crc_table[n] = c;
+    }
+  }
+  for (size_t i = 0; i < len; i++)
+  {
+    crc = crc_table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+static void put_be32(uint8_t *p, uint32_t v)
+{
+  p[0] = (uint8_t)(v >> 24);
+  p[1] = (uint8_t)(v >> 16);
+  p[2] = (uint8_t)(v >> 8);
+  p[3] = (uint8_t)v;
+}
+
+static uint32_t get_be32(const uint8_t *p)
+{
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+bool png_image_alloc(png_image_t *img, uint32_t width, uint32_t height)
+{
+  img->width = width;
+  img->height = height;
+  img->rgb = calloc((size_t)width * height, 3);
+  return img->rgb != NULL;
+}
+
+void png_image_free(png_image_t *img)
+{
+  free(img->rgb);
+  img->rgb = NULL;
+  img->width = 0;
+  img->height = 0;
+}
+
+static bool write_chunk(FILE *f, const char *type, const uint8_t *data, uint32_t len)
+{
+  uint8_t header[8];
+  put_be32(header, len);
+  memcpy(header + 4, type, 4);
+
+  uint32_t crc = crc32_update(0xFFFFFFFFu, header + 4, 4);
+  crc = crc32_update(crc, data, len) ^ 0xFFFFFFFFu;
+  uint8_t trailer[4];
+  put_be32(trailer, crc);
+
+  return fwrite(header, 1, 8, f) == 8 && (len == 0 || fwrite(data, 1, len, f) == len) &&
+         fwrite(trailer, 1, 4, f) == 4;
+}
+
+bool png_image_write(const char *path, const png_image_t *img)
+{
+  // Raw scanlines: filter byte 0 followed by the row
+  size_t row_bytes = (size_t)img->width * 3 + 1;
+  size_t raw_len = row_bytes * img->height;
+  size_t blocks = raw_len / DEFLATE_STORED_MAX + 1;
+  size_t zlib_len = 2 + raw_len + blocks * 5 + 4;
+
+  uint8_t *zlib = malloc(zlib_len);
+  uint8_t *raw = malloc(raw_len);
+  if (zlib == NULL || raw == NULL)
+  {
+    free(zlib);
+    free(raw);
+    return false;
+  }
+  for (uint32_t y = 0; y < img->height; y++)
+  {
+    raw[y * row_bytes] = 0;
+    memcpy(&raw[y * row_bytes + 1], &img->rgb[(size_t)y * img->width * 3], row_bytes - 1);
+  }
+
+  // zlib stream of stored deflate blocks
+  size_t n = 0;
+  zlib[n++] = 0x78;
+  zlib[n++] = 0x01;
+  uint32_t adler_a = 1, adler_b = 0;
+  size_t offset = 0;
+  do
+  {
+    size_t len = raw_len - offset < DEFLATE_STORED_MAX ? raw_len - offset : DEFLATE_STORED_MAX;
+    zlib[n++] = offset + len == raw_len ? 1 : 0; // BFINAL, BTYPE 00
+    zlib[n++] = (uint8_t)len;
+    zlib[n++] = (uint8_t)(len >> 8);
+    zlib[n++] = (uint8_t)~len;
+    zlib[n++] = (uint8_t)(~len >> 8);
+    memcpy(&zlib[n], &raw[offset], len);
+    for (size_t i = 0; i < len; i++)
+    {
+      adler_a = (adler_a + raw[offset + i]) % 65521;
+      adler_b = (adler_b + adler_a) % 65521;
+    }
+    n += len;
+    offset += len;
+  } while (offset < raw_len);
+  put_be32(&zlib[n], (adler_b << 16) | adler_a);
+  n += 4;
+  free(raw);
+
+  uint8_t ihdr[13];
+  put_be32(ihdr, img->width);
+  put_be32(ihdr + 4, img->height);
+  ihdr[8] = 8;  // Bit depth
+  ihdr[9] = 2;  // Truecolor
+  ihdr[10] = 0; // Deflate
+  ihdr[11] = 0; // Adaptive filtering
+  ihdr[12] = 0; // No interlace
+
+  FILE *f = fopen(path, "wb");
+  bool ok = f != NULL && fwrite(png_signature, 1, 8, f) == 8 && write_chunk(f, "IHDR", ihdr, sizeof(ihdr)) &&
+            write_chunk(f, "IDAT", zlib, (uint32_t)n) && write_chunk(f, "IEND", NULL, 0);
+  if (f != NULL && fclose(f) != 0)
+  {
+    ok = false;
+  }
+  free(zlib);
+  return ok;
+}
+
+static uint8_t *read_file(const char *path, size_t *len)
+{
+  FILE *f = fopen(path, "rb");
+  if (f == NULL)
+  {
+    return NULL;
+  }
+  fseek(f, 0, SEEK_END);
+  long size = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  uint8_t *data = size > 0 ? malloc((size_t)size) : NULL;
+  if (data != NULL && fread(data, 1, (size_t)size, f) != (size_t)size)
+  {
+    free(data);
+    data = NULL;
+  }
+  fclose(f);
+  *len = (size_t)size;
+  return data;
+}
+
+bool png_image_read(const char *path, png_image_t *img)
+{
+  size_t len = 0;
+  uint8_t *data = read_file(path, &len);
+  if (data == NULL)
+  {
+    return false;
+  }
+
+  bool ok = false;
+  uint8_t *zlib = NULL;
+  size_t zlib_len = 0;
+  uint32_t width = 0, height = 0;
+
+  if (len < 8 || memcmp(data, png_signature, 8) != 0)
+  {
+    goto done;
+  }
+  for (size_t pos = 8; pos + 12 <= len;)
+  {
+    uint32_t chunk_len = get_be32(&data[pos]);
+    const uint8_t *type = &data[pos + 4];
+    const uint8_t *body = &data[pos + 8];
+    if (chunk_len > len - pos - 12)
+    {
+      goto done;
+    }
+    if (memcmp(type, "IHDR", 4) == 0)
+    {
+      if (chunk_len != 13 || body[8] != 8 || body[9] != 2 || body[12] != 0)
+      {
+        goto done; // Only 8-bit RGB without interlacing
+      }
+      width = get_be32(body);
+      height = get_be32(body + 4);
+    }
+    else if (memcmp(type, "IDAT", 4) == 0)
+    {
+      uint8_t *grown = realloc(zlib, zlib_len + chunk_len);
+      if (grown == NULL)
+      {
+        goto done;
+      }
+      zlib = grown;
+      memcpy(&zlib[zlib_len], body, chunk_len);
+      zlib_len += chunk_len;
+    }
+    else if (memcmp(type, "IEND", 4) == 0)
+    {
+      break;
+    }
+    pos += 12 + chunk_len;
+  }
+
+  size_t row_bytes = (size_t)width * 3 + 1;
+  if (width == 0 || height == 0 || zlib_len < 2 || !png_image_alloc(img, width, height))
+  {
+    goto done;
+  }
+
+  // Walk the stored blocks, copying scanlines without their filter byte
+  size_t pos = 2, raw_pos = 0, raw_len = row_bytes * height;
+  bool final = false;
+  while (!final)
+  {
+    if (pos + 5 > zlib_len || (zlib[pos] & 0x06) != 0)
+    {
+      goto fail; // Truncated or compressed block
+    }
+    final = zlib[pos] & 1;
+    size_t block_len = zlib[pos + 1] | (zlib[pos + 2] << 8);
+    pos += 5;
+    if (block_len > zlib_len - pos || block_len > raw_len - raw_pos)
+    {
+      goto fail;
+    }
+    for (size_t i = 0; i < block_len; i++, raw_pos++)
+    {
+      size_t column = raw_pos % row_bytes;
+      if (column == 0)
+      {
+        if (zlib[pos + i] != 0)
+        {
+          goto fail; // Filtered scanline
+        }
+        continue;
+      }
+      img->rgb[(raw_pos / row_bytes) * width * 3 + column - 1] = zlib[pos + i];
+    }
+    pos += block_len;
+  }
+  ok = raw_pos == raw_len;
+
+fail:
+  if (!ok)
+  {
+    png_image_free(img);
+  }
+done:
+  free(zlib);
+  free(data);
+  return ok;
+}
+
+uint32_t png_image_compare(const png_image_t *a, const png_image_t *b, uint8_t tolerance, png_image_t *diff)
+{
+  if (a->width != b->width || a->height != b->height)
+  {
+    return UINT32_MAX;
+  }
+  if (diff != NULL && !png_image_alloc(diff, b->width, b->height))
+  {
+    diff = NULL;
+  }
+
+  uint32_t differing = 0;
+  size_t pixels = (size_t)a->width * a->height;
+  for (size_t i = 0; i < pixels; i++)
+  {
+    const uint8_t *pa = &a->rgb[i * 3];
+    const uint8_t *pb = &b->rgb[i * 3];
+    bool differs = false;
+    for (int c = 0; c < 3; c++)
+    {
+      int delta = pa[c] > pb[c] ? pa[c] - pb[c] : pb[c] - pa[c];
+      differs |= delta > tolerance;
+    }
+    differing += differs;
+
+    if (diff != NULL)
+    {
+      uint8_t *pd = &diff->rgb[i * 3];
+      if (differs)
+      {
+        pd[0] = 255;
+        pd[1] = 0;
+        pd[2] = 0;
+      }
+      else
+      {
+        pd[0] = pb[0] / 4;
+        pd[1] = pb[1] / 4;
+        pd[2] = pb[2] / 4;
+      }
+    }
+  }
+  return differing;
+}
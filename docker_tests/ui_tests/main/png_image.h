@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* 8-bit RGB image, rows top to bottom, 3 bytes per pixel */
+typedef struct
+{
+  uint32_t width;
+  uint32_t height;
+  uint8_t *rgb;
+} png_image_t;
+
+/**
+ * Allocates a black image.
+ * @return false if out of memory
+ */
+bool png_image_alloc(png_image_t *img, uint32_t width, uint32_t height);
+
+void png_image_free(png_image_t *img);
+
+/**
+ * Writes an 8-bit RGB PNG with uncompressed deflate blocks: no zlib dependency, and golden
+ * images stay byte-for-byte reproducible.
+ */
+bool png_image_write(const char *path, const png_image_t *img);
+
+/**
+ * Reads a PNG written by png_image_write(). Other encodings (compressed IDAT, palettes,
+ * filters, interlacing) are rejected rather than misread.
+ * @return false if the file is missing or not in that format
+ */
+bool png_image_read(const char *path, png_image_t *img);
+
+/**
+ * Counts pixels whose channels differ by more than tolerance.
+ * @param diff If not NULL, allocated and filled with the differing pixels in red over a dimmed copy of b
+ * @return Number of differing pixels, UINT32_MAX if the sizes differ
+ */
+uint32_t png_image_compare(const png_image_t *a, const png_image_t *b, uint8_t tolerance, png_image_t *diff);
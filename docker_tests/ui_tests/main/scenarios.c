@@ -0,0 +1,82 @@
+#include "ui_test.h"
+#include "host_display.h"
+#include "telemetry_bus.h"
+#include "product_pins.h"
+#include "ui/analog_dial.h"
+#include "ui/trend_chart.h"
+
+/* Largest area one frame may redraw while only the needle and readouts change: half the screen.
+ * A dial or layout that falls back to full-screen redraws fails here. */
+#define PARTIAL_FRAME_MAX_PX (AMOLED_WIDTH * AMOLED_HEIGHT / 2)
+
+/* Readings go through the telemetry bus and the subjects exactly as on the device */
+static void publish_readings(float air, float heater)
+{
+  telemetry_publish(TELEMETRY_TOPIC_AIR_TEMP, air);
+  telemetry_publish(TELEMETRY_TOPIC_HEATER_TEMP, heater);
+}
+
+/* Screen before any sensor data arrives */
+static void scenario_boot(void)
+{
+  ui_test_run_ms(2000);
+  ui_test_check_golden("boot");
+}
+
+/* All readouts populated, needle settled */
+static void scenario_readings(void)
+{
+  publish_readings(45.3f, 98.7f);
+  telemetry_publish(TELEMETRY_TOPIC_AIR_VOLTAGE, 1.65f);
+  telemetry_publish(TELEMETRY_TOPIC_AIR_RESISTANCE, 10240.0f);
+  telemetry_publish(TELEMETRY_TOPIC_HEATER_VOLTAGE, 0.82f);
+  telemetry_publish(TELEMETRY_TOPIC_HEATER_RESISTANCE, 3300.0f);
+  ui_test_run_ms(3000);
+  ui_test_check_golden("readings");
+}
+
+/* A large step moves the needle; every frame must stay a partial redraw */
+static void scenario_needle_step(void)
+{
+  publish_readings(45.3f, 30.0f);
+  ui_test_run_ms(3000);
+
+  const host_display_stats_t *stats = host_display_get_stats();
+  UI_TEST_EXPECT(stats->frames > 0, "the needle step rendered nothing");
+  UI_TEST_EXPECT(stats->area_px.max <= PARTIAL_FRAME_MAX_PX, "a frame redrew %u px, more than %u",
+                 (unsigned)stats->area_px.max, (unsigned)PARTIAL_FRAME_MAX_PX);
+  ui_test_check_golden("needle_step");
+}
+
+/* With no new data the screen must go quiet: only a trend chart column may be drawn */
+static void scenario_idle(void)
+{
+  ui_test_run_ms(5000);
+
+  const host_display_stats_t *stats = host_display_get_stats();
+  UI_TEST_EXPECT(stats->frames <= 1, "%u frames rendered while nothing changed", (unsigned)stats->frames);
+  UI_TEST_EXPECT(stats->total_area_px <= TREND_CHART_WIDTH * TREND_CHART_HEIGHT,
+                 "%llu px redrawn while nothing changed", (unsigned long long)stats->total_area_px);
+}
+
+/* A minute of warming up fills a few trend chart columns */
+static void scenario_trend(void)
+{
+  for (int s = 0; s < 60; s++)
+  {
+    publish_readings(30.0f + s * 0.5f, 30.0f + s * 1.2f);
+    ui_test_run_ms(1000);
+  }
+  ui_test_run_ms(3000); // Let the needle settle before the capture
+  ui_test_check_golden("trend");
+}
+
+const ui_scenario_t ui_scenarios[] = {
+    {"boot", scenario_boot},
+    {"readings", scenario_readings},
+    {"needle_step", scenario_needle_step},
+    {"idle", scenario_idle},
+    {"trend", scenario_trend},
+};
+
+const int ui_scenario_count = sizeof(ui_scenarios) / sizeof(ui_scenarios[0]);
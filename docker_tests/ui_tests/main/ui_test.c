@@ -0,0 +1,115 @@
+#include "ui_test.h"
+#include "host_clock.h"
+#include "host_display.h"
+#include "png_image.h"
+#include "lvgl.h"
+#include <stdarg.h>
+#include <stdio.h>
+
+#define STEP_MS 5 /* Simulated time per lv_timer_handler() call */
+
+static ui_test_options_t opts;
+static const char *current_scenario = "";
+static int failures = 0;
+
+void ui_test_init(const ui_test_options_t *options)
+{
+  opts = *options;
+}
+
+void ui_test_run_ms(uint32_t ms)
+{
+  for (uint32_t elapsed = 0; elapsed < ms; elapsed += STEP_MS)
+  {
+    host_clock_advance(STEP_MS);
+    lv_timer_handler();
+  }
+}
+
+void ui_test_expect(bool ok, const char *file, int line, const char *format, ...)
+{
+  if (ok)
+  {
+    return;
+  }
+
+  failures++;
+  va_list args;
+  printf("  FAIL %s (%s:%d): ", current_scenario, file, line);
+  va_start(args, format);
+  vprintf(format, args);
+  va_end(args);
+  printf("\n");
+}
+
+void ui_test_check_golden(const char *name)
+{
+  char golden_path[512];
+  char out_path[512];
+  snprintf(golden_path, sizeof(golden_path), "%s/%s.png", opts.golden_dir, name);
+  snprintf(out_path, sizeof(out_path), "%s/%s.png", opts.out_dir, name);
+
+  png_image_t frame = {0};
+  if (!host_display_capture(&frame))
+  {
+    UI_TEST_EXPECT(false, "out of memory capturing %s", name);
+    return;
+  }
+  png_image_write(out_path, &frame);
+
+  if (opts.update)
+  {
+    bool written = png_image_write(golden_path, &frame);
+    UI_TEST_EXPECT(written, "cannot write %s", golden_path);
+    printf("  updated %s\n", golden_path);
+    png_image_free(&frame);
+    return;
+  }
+
+  // A missing reference fails: comparing against nothing would pass on every fresh checkout
+  png_image_t golden = {0};
+  if (!png_image_read(golden_path, &golden))
+  {
+    UI_TEST_EXPECT(false, "no golden image %s; review %s and accept it with --update", golden_path, out_path);
+    png_image_free(&frame);
+    return;
+  }
+
+  png_image_t diff = {0};
+  uint32_t differing = png_image_compare(&frame, &golden, opts.tolerance, &diff);
+  if (differing != 0 && diff.rgb != NULL)
+  {
+    snprintf(out_path, sizeof(out_path), "%s/%s.diff.png", opts.out_dir, name);
+    png_image_write(out_path, &diff);
+  }
+  UI_TEST_EXPECT(differing == 0, "%s differs from the golden image in %u pixels (see %s)", name,
+                 (unsigned)differing, out_path);
+
+  png_image_free(&diff);
+  png_image_free(&golden);
+  png_image_free(&frame);
+}
+
+void ui_test_begin(const char *scenario)
+{
+  current_scenario = scenario;
+  host_display_reset_stats();
+}
+
+void ui_test_end(void)
+{
+  const host_display_stats_t *stats = host_display_get_stats();
+  uint32_t p95 = frame_histogram_percentile(&stats->render_us, 95);
+  printf("  %-18s frames %4u  area %8llu px (max %6u/frame)  render p50 %6u us  p95 %6u us  max %6u us\n",
+         current_scenario, (unsigned)stats->frames, (unsigned long long)stats->total_area_px,
+         (unsigned)stats->area_px.max, (unsigned)frame_histogram_percentile(&stats->render_us, 50), (unsigned)p95,
+         (unsigned)stats->render_us.max);
+
+  UI_TEST_EXPECT(stats->frames == 0 || p95 <= opts.render_budget_us, "render p95 %u us over the %u us budget",
+                 (unsigned)p95, (unsigned)opts.render_budget_us);
+}
+
+int ui_test_failures(void)
+{
+  return failures;
+}
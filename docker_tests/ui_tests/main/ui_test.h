@@ -0,0 +1,43 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct
+{
+  const char *golden_dir;    /* Reference PNGs */
+  const char *out_dir;       /* Captured frames and diff images */
+  bool update;               /* Overwrite the golden images instead of comparing */
+  uint8_t tolerance;         /* Largest per-channel difference that still matches */
+  uint32_t render_budget_us; /* Largest p95 render time a scenario may have */
+} ui_test_options_t;
+
+typedef struct
+{
+  const char *name;
+  void (*run)(void);
+} ui_scenario_t;
+
+/* Scenarios in the order they run; each continues from the screen the previous one left */
+extern const ui_scenario_t ui_scenarios[];
+extern const int ui_scenario_count;
+
+void ui_test_init(const ui_test_options_t *options);
+
+/** Advances simulated time, running LVGL timers and rendering as the device would. */
+void ui_test_run_ms(uint32_t ms);
+
+/** Captures the framebuffer and compares it with golden/<name>.png (or writes it with --update). */
+void ui_test_check_golden(const char *name);
+
+/** Starts a scenario: resets the frame statistics. */
+void ui_test_begin(const char *scenario);
+
+/** Ends a scenario: reports frames, area and render time and checks the render budget. */
+void ui_test_end(void);
+
+void ui_test_expect(bool ok, const char *file, int line, const char *format, ...);
+
+#define UI_TEST_EXPECT(cond, ...) ui_test_expect((cond), __FILE__, __LINE__, __VA_ARGS__)
+
+int ui_test_failures(void);
@@ -0,0 +1,29 @@
+#!/bin/bash
+set -e
+
+# Builds the UI natively against LVGL and runs the scenarios.
+# Extra arguments go to the test binary, e.g. --update to accept new golden images.
+# --compare-dial-cache instead prints the needle_step statistics with and without the dial scale snapshot.
+
+cd "$(dirname "$0")"
+
+if [ "$1" = "--compare-dial-cache" ]; then
+    for variant in cached live; do
+        live=$([ "$variant" = live ] && echo ON || echo OFF)
+        cmake -S . -B "build_$variant" -G Ninja -DUI_TESTS_LIVE_SCALE=$live > /dev/null
+        ninja -C "build_$variant" ui_tests > /dev/null
+        # Goldens and budgets are not the point here, only the statistics line
+        line=$("./build_$variant/ui_tests" --golden golden --out "build_$variant/frames" | grep ' needle_step ' || true)
+        echo "$variant: $line"
+    done
+    exit 0
+fi
+
+echo "Building UI tests with CMake..."
+mkdir -p build
+cmake -S . -B build -G Ninja
+ninja -C build ui_tests
+
+echo "Running UI scenario tests..."
+./build/ui_tests --golden golden --out build/frames "$@"
+echo "UI tests completed! Frames are in build/frames"
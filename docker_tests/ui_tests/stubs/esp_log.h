@@ -0,0 +1,12 @@
+#pragma once
+
+#include <stdio.h>
+
+// Host stand-in for ESP-IDF logging: one line per message on stdout
+#define ESP_HOST_LOG(level, tag, format, ...) printf("[" level "] %s: " format "\n", tag, ##__VA_ARGS__)
+
+#define ESP_LOGE(tag, format, ...) ESP_HOST_LOG("ERROR", tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) ESP_HOST_LOG("WARN", tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) ESP_HOST_LOG("INFO", tag, format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) ((void)(tag))
+#define ESP_LOGV(tag, format, ...) ((void)(tag))
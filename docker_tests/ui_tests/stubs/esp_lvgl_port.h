@@ -0,0 +1,16 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+
+// Single-threaded host build: the harness owns LVGL, so the port lock is a no-op
+static inline bool lvgl_port_lock(uint32_t timeout_ms)
+{
+  (void)timeout_ms;
+  return true;
+}
+
+static inline void lvgl_port_unlock(void)
+{
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+#include <stdint.h>
+
+// Runs on the harness clock (host_clock.h), so scenarios are deterministic
+int64_t esp_timer_get_time(void);
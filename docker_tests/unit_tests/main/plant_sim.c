@@ -0,0 +1,39 @@
+#include "plant_sim.h"
+
+void plant_sim_init(plant_sim_t *plant, float ambient_temp)
+{
+    plant->heater_power_w = 280.0f;
+    plant->heater_capacity = 150.0f;
+    plant->heater_to_air = 6.0f;
+    plant->air_capacity = 1500.0f;
+    plant->air_to_ambient = 2.0f;
+    plant->ambient_temp = ambient_temp;
+    plant->heater_temp = ambient_temp;
+    plant->air_temp = ambient_temp;
+    plant->limited = false;
+    plant->time_ms = 0;
+    plant->applied_power = 0;
+}
+
+void plant_sim_set_power_limit(plant_sim_t *plant, const power_limit_config_t *config)
+{
+    power_limiter_init(&plant->limiter, config);
+    plant->limited = true;
+}
+
+void plant_sim_step(plant_sim_t *plant, uint8_t power, float dt_s)
+{
+    if (plant->limited)
+    {
+        power = (uint8_t)power_limiter_apply(&plant->limiter, power, plant->time_ms);
+    }
+    plant->applied_power = power;
+    plant->time_ms += (int64_t)(dt_s * 1000.0f);
+
+    float heat_in = plant->heater_power_w * (float)power / 255.0f;
+    float heater_to_air = plant->heater_to_air * (plant->heater_temp - plant->air_temp);
+    float air_loss = plant->air_to_ambient * (plant->air_temp - plant->ambient_temp);
+
+    plant->heater_temp += (heat_in - heater_to_air) * dt_s / plant->heater_capacity;
+    plant->air_temp += (heater_to_air - air_loss) * dt_s / plant->air_capacity;
+}
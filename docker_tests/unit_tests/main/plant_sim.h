@@ -0,0 +1,50 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "power_limiter.h"
+
+/**
+ * @brief Lumped two-node thermal model of the dryer used to exercise the controller on the host.
+ *
+ * The heater element (small thermal mass) is driven by PWM and couples into the
+ * enclosure air (large thermal mass), which loses heat to ambient.
+ */
+typedef struct
+{
+    float heater_power_w;    // Element power at 100% duty (W)
+    float heater_capacity;   // Element thermal capacity (J/K)
+    float heater_to_air;     // Element-to-air conductance (W/K)
+    float air_capacity;      // Air + enclosure thermal capacity (J/K)
+    float air_to_ambient;    // Enclosure loss conductance (W/K)
+    float ambient_temp;      // Ambient temperature (C)
+    float heater_temp;       // Current element temperature (C)
+    float air_temp;          // Current air temperature (C)
+    bool limited;            // Power budget of the heater output layer modelled
+    power_limiter_t limiter; // Budget applied to every commanded level (0-255 units)
+    int64_t time_ms;         // Simulated time
+    uint8_t applied_power;   // Level the element actually received in the last step
+} plant_sim_t;
+
+/**
+ * @brief Initializes the plant with default dryer parameters, everything at ambient.
+ * @param plant Plant to initialize.
+ * @param ambient_temp Ambient temperature (C).
+ */
+void plant_sim_init(plant_sim_t *plant, float ambient_temp);
+
+/**
+ * @brief Models the heater output's power budget (see heater_set_power_limit()).
+ * @param plant Plant.
+ * @param config Budget in 0-255 power units.
+ */
+void plant_sim_set_power_limit(plant_sim_t *plant, const power_limit_config_t *config);
+
+/**
+ * @brief Advances the plant by one explicit Euler step.
+ * With a power budget set, the commanded level is limited first, as the heater output does.
+ * @param plant Plant to advance.
+ * @param power Heater PWM level, 0-255.
+ * @param dt_s Step length in seconds.
+ */
+void plant_sim_step(plant_sim_t *plant, uint8_t power, float dt_s);
@@ -1,5 +1,7 @@
+#include <math.h>
 #include "unity.h"
 #include "heater_controller.h"
+#include "controller_runaway.h"
 
 // Mocks - Include the generated mock headers
 #include "Mockmock_heater.h"
@@ -232,6 +234,465 @@ void test_controller_global_safety_override(void)
     teardown_controller_test();
 }
 
+// Ignores the mutex and heater calls so ramp tests can run many cycles
+static void ignore_control_cycle_mocks(void)
+{
+    xSemaphoreTake_IgnoreAndReturn(pdTRUE);
+    xSemaphoreGive_IgnoreAndReturn(pdTRUE);
+    set_heat_power_Ignore();
+}
+
+// Clears the ignores so later tests get strict expectations again
+static void reset_control_cycle_mocks(void)
+{
+    Mockmock_semphr_Destroy();
+    Mockmock_heater_Destroy();
+}
+
+void test_controller_ramp_linear(void)
+{
+    controller_config_t config = TEST_CONFIG;
+    config.ramp_rate = 6.0f; // 0.1 C/s
+    config.control_period_s = 1.0f;
+
+    setup_controller_test(&config, 50.0f);
+    controller_internal_state_t *state = controller_get_state();
+    ignore_control_cycle_mocks();
+
+    // Reference is seeded from the air temperature and rises at the configured rate
+    controller_run(20.0f, 20.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 20.1f, state->ramp_reference);
+    for (int i = 0; i < 9; i++)
+    {
+        controller_run(20.0f, 20.0f);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 21.0f, state->ramp_reference);
+
+    // Still within full_power_delta of the reference, so the heater is not pinned at full power
+    TEST_ASSERT_EQUAL(CONTROLLER_STATE_IDLE, state->state);
+
+    // Lowering the target applies immediately
+    controller_set_target_temp(15.0f);
+    controller_run(20.0f, 20.0f);
+    TEST_ASSERT_EQUAL_FLOAT(15.0f, state->ramp_reference);
+
+    reset_control_cycle_mocks();
+    teardown_controller_test();
+}
+
+void test_controller_ramp_s_curve(void)
+{
+    controller_config_t config = TEST_CONFIG;
+    config.ramp_rate = 6.0f;   // 0.1 C/s
+    config.ramp_accel = 36.0f; // 0.01 C/s^2
+    config.control_period_s = 1.0f;
+
+    setup_controller_test(&config, 30.0f);
+    controller_internal_state_t *state = controller_get_state();
+    ignore_control_cycle_mocks();
+
+    // Rate builds up gradually instead of jumping to ramp_rate
+    controller_run(20.0f, 20.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.01f, state->ramp_velocity);
+    controller_run(20.0f, 20.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.02f, state->ramp_velocity);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 20.03f, state->ramp_reference);
+
+    // Rate saturates at ramp_rate, then brakes and settles exactly on the target without overshoot
+    float peak_velocity = 0.0f;
+    for (int i = 0; i < 300; i++)
+    {
+        controller_run(20.0f, 20.0f);
+        TEST_ASSERT_TRUE(state->ramp_reference <= 30.0f);
+        if (state->ramp_velocity > peak_velocity)
+        {
+            peak_velocity = state->ramp_velocity;
+        }
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.1f, peak_velocity);
+    TEST_ASSERT_EQUAL_FLOAT(30.0f, state->ramp_reference);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, state->ramp_velocity);
+
+    reset_control_cycle_mocks();
+    teardown_controller_test();
+}
+
+void test_controller_ramp_reseeds_on_reactivation(void)
+{
+    controller_config_t config = TEST_CONFIG;
+    config.ramp_rate = 6.0f;
+    config.control_period_s = 1.0f;
+
+    setup_controller_test(&config, 50.0f);
+    controller_internal_state_t *state = controller_get_state();
+    ignore_control_cycle_mocks();
+
+    controller_run(20.0f, 20.0f);
+    controller_set_active(false);
+    controller_run(20.0f, 20.0f);
+    TEST_ASSERT_FALSE(state->ramp_valid);
+
+    // Air warmed up while inactive; the ramp restarts from the new air temperature
+    controller_set_active(true);
+    controller_run(35.0f, 30.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 30.1f, state->ramp_reference);
+
+    reset_control_cycle_mocks();
+    teardown_controller_test();
+}
+
+// Output stub for instance tests: records the last commanded power per zone
+static void record_power_output(uint8_t power, void *ctx)
+{
+    *(uint8_t *)ctx = power;
+}
+
+void test_controller_instances_are_independent(void)
+{
+    uint8_t zone_a_power = 0xAA;
+    uint8_t zone_b_power = 0xAA;
+    controller_instance_config_t zone_a = {
+        .name = "A",
+        .params = TEST_CONFIG,
+        .initial_target_temp = 50.0f,
+        .set_power = record_power_output,
+        .output_ctx = &zone_a_power,
+    };
+    controller_instance_config_t zone_b = zone_a;
+    zone_b.name = "B";
+    zone_b.initial_target_temp = 30.0f;
+    zone_b.output_ctx = &zone_b_power;
+
+    xSemaphoreCreateMutex_IgnoreAndReturn(s_test_mutex);
+    ignore_control_cycle_mocks();
+
+    controller_handle_t a = controller_create(&zone_a);
+    controller_handle_t b = controller_create(&zone_b);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_TRUE(a != b);
+    TEST_ASSERT_EQUAL_PTR(controller_get_default(), a); // First instance is the default one
+
+    // Pool exhausted
+    TEST_ASSERT_NULL(controller_create(&zone_a));
+
+    // Same temperatures, different targets: only zone A needs heat
+    controller_instance_run(a, 25.0f, 25.0f);
+    controller_instance_run(b, 25.0f, 25.0f);
+    TEST_ASSERT_EQUAL_UINT8(255, zone_a_power);
+    TEST_ASSERT_EQUAL_UINT8(0, zone_b_power);
+    TEST_ASSERT_EQUAL(CONTROLLER_STATE_HEATING_FULL_POWER, a->state);
+    TEST_ASSERT_EQUAL(CONTROLLER_STATE_IDLE, b->state);
+
+    // Deactivating one zone leaves the other running
+    controller_instance_set_active(a, false);
+    controller_instance_run(a, 25.0f, 25.0f);
+    controller_instance_run(b, 25.0f, 20.0f);
+    TEST_ASSERT_EQUAL_UINT8(0, zone_a_power);
+    TEST_ASSERT_EQUAL_UINT8(255, zone_b_power);
+
+    vSemaphoreDelete_Ignore();
+    controller_destroy(a);
+    controller_destroy(b);
+    reset_control_cycle_mocks();
+}
+
+// Interlock stub for instance tests: the flag it points at says whether the heater may run
+static bool flag_interlock(void *ctx)
+{
+    return *(bool *)ctx;
+}
+
+void test_controller_interlock_blocks_heat(void)
+{
+    uint8_t power = 0xAA;
+    bool airflow = false;
+    controller_snapshot_t snapshot;
+    controller_instance_config_t zone = {
+        .name = "fan",
+        .params = TEST_CONFIG,
+        .initial_target_temp = 50.0f,
+        .set_power = record_power_output,
+        .output_ctx = &power,
+        .interlock = flag_interlock,
+        .interlock_ctx = &airflow,
+    };
+
+    xSemaphoreCreateMutex_IgnoreAndReturn(s_test_mutex);
+    ignore_control_cycle_mocks();
+    controller_handle_t ctrl = controller_create(&zone);
+    TEST_ASSERT_NOT_NULL(ctrl);
+
+    // Heat is demanded but there is no airflow: the state machine runs, the heater stays off
+    controller_instance_run(ctrl, 25.0f, 25.0f);
+    controller_instance_run(ctrl, 25.0f, 25.0f);
+    TEST_ASSERT_EQUAL_UINT8(0, power);
+    TEST_ASSERT_EQUAL(CONTROLLER_STATE_HEATING_FULL_POWER, ctrl->state);
+    TEST_ASSERT_TRUE(controller_get_snapshot(ctrl, &snapshot));
+    TEST_ASSERT_TRUE(snapshot.interlocked);
+    TEST_ASSERT_EQUAL_UINT8(0, snapshot.power);
+    TEST_ASSERT_EQUAL_UINT32(1, snapshot.telemetry.interlock_trips); // Counted once per blocked episode
+    TEST_ASSERT_EQUAL_UINT32(0, snapshot.telemetry.heating_cycles);
+
+    // Airflow established: heating resumes on the next cycle
+    airflow = true;
+    controller_instance_run(ctrl, 25.0f, 25.0f);
+    TEST_ASSERT_EQUAL_UINT8(255, power);
+    TEST_ASSERT_TRUE(controller_get_snapshot(ctrl, &snapshot));
+    TEST_ASSERT_FALSE(snapshot.interlocked);
+
+    // The interlock is not consulted when no heat is wanted
+    airflow = false;
+    controller_instance_set_active(ctrl, false);
+    controller_instance_run(ctrl, 25.0f, 25.0f);
+    TEST_ASSERT_TRUE(controller_get_snapshot(ctrl, &snapshot));
+    TEST_ASSERT_FALSE(snapshot.interlocked);
+    TEST_ASSERT_EQUAL_UINT32(1, snapshot.telemetry.interlock_trips);
+
+    vSemaphoreDelete_Ignore();
+    controller_destroy(ctrl);
+    reset_control_cycle_mocks();
+}
+
+void test_controller_snapshot_and_telemetry(void)
+{
+    controller_snapshot_t snapshot;
+    setup_controller_test(&TEST_CONFIG, 50.0f);
+    ignore_control_cycle_mocks();
+
+    controller_run(30.0f, 40.0f);                           // Heats at full power
+    controller_run(TEST_CONFIG.max_heater_temp + 1.0f, 41.0f); // Safety override trips
+    controller_run(TEST_CONFIG.max_heater_temp + 1.0f, 41.0f); // Still tripped, not counted again
+
+    TEST_ASSERT_TRUE(controller_get_snapshot(controller_get_default(), &snapshot));
+    TEST_ASSERT_EQUAL(CONTROLLER_STATE_IDLE, snapshot.state);
+    TEST_ASSERT_TRUE(snapshot.heater_safety_override_active);
+    TEST_ASSERT_EQUAL_FLOAT(50.0f, snapshot.target_temp);
+    TEST_ASSERT_EQUAL_FLOAT(TEST_CONFIG.max_heater_temp + 1.0f, snapshot.heater_temp);
+    TEST_ASSERT_EQUAL_FLOAT(41.0f, snapshot.air_temp);
+    TEST_ASSERT_EQUAL_UINT8(0, snapshot.power);
+    TEST_ASSERT_EQUAL_UINT32(3, snapshot.telemetry.cycles);
+    TEST_ASSERT_EQUAL_UINT32(1, snapshot.telemetry.heating_cycles);
+    TEST_ASSERT_EQUAL_UINT32(1, snapshot.telemetry.safety_trips);
+
+    // No sensors bound: stepping forces the heater off and counts a sensor fault
+    TEST_ASSERT_FALSE(controller_step(controller_get_default()));
+    TEST_ASSERT_TRUE(controller_get_snapshot(controller_get_default(), &snapshot));
+    TEST_ASSERT_EQUAL_UINT32(1, snapshot.telemetry.sensor_faults);
+
+    reset_control_cycle_mocks();
+    teardown_controller_test();
+
+    // Not available once the instance is gone
+    TEST_ASSERT_FALSE(controller_get_snapshot(controller_get_default(), &snapshot));
+}
+
+void test_controller_rejects_invalid_temperatures(void)
+{
+    controller_snapshot_t snapshot;
+    setup_controller_test(&TEST_CONFIG, 50.0f);
+    controller_internal_state_t *state = controller_get_state();
+    ignore_control_cycle_mocks();
+
+    controller_run(30.0f, 40.0f);
+    TEST_ASSERT_EQUAL_UINT8(255, state->current_power);
+
+    // The -999 invalid marker and NAN must never be read as "cold"
+    controller_run(-999.0f, 40.0f);
+    TEST_ASSERT_EQUAL_UINT8(0, state->current_power);
+    controller_run(30.0f, -999.0f);
+    controller_run(NAN, 40.0f);
+    TEST_ASSERT_EQUAL_UINT8(0, state->current_power);
+
+    TEST_ASSERT_TRUE(controller_get_snapshot(controller_get_default(), &snapshot));
+    TEST_ASSERT_EQUAL_UINT32(3, snapshot.telemetry.sensor_faults);
+    TEST_ASSERT_EQUAL_UINT32(1, snapshot.telemetry.cycles); // Rejected cycles never reach the state machine
+
+    reset_control_cycle_mocks();
+    teardown_controller_test();
+}
+
+void test_controller_schedule_lookup(void)
+{
+    controller_config_t config = TEST_CONFIG;
+    controller_schedule_point_t point;
+
+    // Empty schedule falls back to the flat config values
+    controller_schedule_lookup(&config, 60.0f, &point);
+    TEST_ASSERT_EQUAL_FLOAT(TEST_CONFIG.air_temp_hysteresis, point.air_temp_hysteresis);
+    TEST_ASSERT_EQUAL_FLOAT(TEST_CONFIG.full_power_delta, point.full_power_delta);
+
+    config.schedule.count = 2;
+    config.schedule.points[0] = (controller_schedule_point_t){40.0f, 1.0f, 2.0f, 4.0f};
+    config.schedule.points[1] = (controller_schedule_point_t){80.0f, 0.5f, 6.0f, 8.0f};
+
+    // Interpolated between entries
+    controller_schedule_lookup(&config, 60.0f, &point);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.75f, point.air_temp_hysteresis);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 4.0f, point.heater_temp_hysteresis);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 6.0f, point.full_power_delta);
+
+    // Clamped outside the table
+    controller_schedule_lookup(&config, 20.0f, &point);
+    TEST_ASSERT_EQUAL_FLOAT(4.0f, point.full_power_delta);
+    controller_schedule_lookup(&config, 100.0f, &point);
+    TEST_ASSERT_EQUAL_FLOAT(8.0f, point.full_power_delta);
+}
+
+void test_controller_schedule_drives_state_machine(void)
+{
+    controller_config_t config = TEST_CONFIG; // Flat full_power_delta of 5
+    config.schedule.count = 2;
+    config.schedule.points[0] = (controller_schedule_point_t){40.0f, 1.0f, 2.0f, 2.0f};
+    config.schedule.points[1] = (controller_schedule_point_t){80.0f, 1.0f, 2.0f, 10.0f};
+
+    setup_controller_test(&config, 40.0f);
+    controller_internal_state_t *state = controller_get_state();
+    ignore_control_cycle_mocks();
+
+    // At 40C the scheduled delta is 2: air 3C below target engages full power
+    controller_run(30.0f, 37.0f);
+    TEST_ASSERT_EQUAL(CONTROLLER_STATE_HEATING_FULL_POWER, state->state);
+
+    // At 80C the scheduled delta is 10: air 7C below target stays IDLE
+    controller_set_active(false);
+    controller_run(30.0f, 73.0f);
+    controller_set_active(true);
+    controller_set_target_temp(80.0f);
+    controller_run(30.0f, 73.0f);
+    TEST_ASSERT_EQUAL(CONTROLLER_STATE_IDLE, state->state);
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, state->scheduled.full_power_delta);
+
+    reset_control_cycle_mocks();
+    teardown_controller_test();
+}
+
+void test_controller_runaway_window(void)
+{
+    controller_config_t config = TEST_CONFIG;
+    config.control_period_s = 1.0f;
+    config.runaway_window_s = 10.0f;
+    config.runaway_min_rise = 2.0f;
+    config.runaway_idle_max_rise = 3.0f;
+    runaway_monitor_t m;
+
+    runaway_reset(&m, &config);
+    TEST_ASSERT_EQUAL_UINT16(10, m.window);
+
+    // Heating normally at full power: 0.5C per cycle
+    for (int i = 0; i < 30; i++)
+    {
+        TEST_ASSERT_EQUAL(CONTROLLER_FAULT_NONE, runaway_update(&m, &config, 25.5f + 0.5f * i, 255));
+    }
+
+    // Sensor falls off the element: drops to ambient and reads flat while power stays on
+    int trip = -1;
+    for (int i = 0; i < 20 && trip < 0; i++)
+    {
+        if (runaway_update(&m, &config, 25.0f, 255) == CONTROLLER_FAULT_HEATING_FAILED)
+        {
+            trip = i;
+        }
+    }
+    TEST_ASSERT_TRUE(trip >= 5 && trip < 10); // Within one window of the sensor going flat
+
+    // Dead element from the start of a full-power run
+    runaway_reset(&m, &config);
+    controller_fault_t fault = CONTROLLER_FAULT_NONE;
+    for (int i = 0; i < 10; i++)
+    {
+        fault = runaway_update(&m, &config, 25.0f + 0.1f * i, 255);
+    }
+    TEST_ASSERT_EQUAL(CONTROLLER_FAULT_HEATING_FAILED, fault);
+
+    // Weak element: rises, then holds a plateau below max_heater_temp at full power for a long time
+    runaway_reset(&m, &config);
+    for (int i = 0; i < 300; i++)
+    {
+        float temp = i < 20 ? 25.0f + 1.5f * i : 55.0f + 0.01f * (i % 3);
+        TEST_ASSERT_EQUAL(CONTROLLER_FAULT_NONE, runaway_update(&m, &config, temp, 255));
+    }
+
+    // A short off period at the plateau re-arms the watch, and the element recovers its rise
+    for (int i = 0; i < 3; i++)
+    {
+        TEST_ASSERT_EQUAL(CONTROLLER_FAULT_NONE, runaway_update(&m, &config, 55.0f - 1.5f * i, 0));
+    }
+    for (int i = 0; i < 30; i++)
+    {
+        float temp = i < 6 ? 52.0f + 0.5f * i : 55.0f;
+        TEST_ASSERT_EQUAL(CONTROLLER_FAULT_NONE, runaway_update(&m, &config, temp, 255));
+    }
+
+    // Partial power never counts as a heating failure, however flat the reading
+    runaway_reset(&m, &config);
+    for (int i = 0; i < 30; i++)
+    {
+        TEST_ASSERT_EQUAL(CONTROLLER_FAULT_NONE, runaway_update(&m, &config, 40.0f, (i % 2) ? 255 : 0));
+    }
+
+    // Rising with the output off: stuck output stage
+    runaway_reset(&m, &config);
+    for (int i = 0; i < 10; i++)
+    {
+        fault = runaway_update(&m, &config, 40.0f + 0.5f * i, 0);
+    }
+    TEST_ASSERT_EQUAL(CONTROLLER_FAULT_RUNAWAY, fault);
+
+    // Cooling with the output off is fine
+    runaway_reset(&m, &config);
+    for (int i = 0; i < 30; i++)
+    {
+        TEST_ASSERT_EQUAL(CONTROLLER_FAULT_NONE, runaway_update(&m, &config, 90.0f - 0.5f * i, 0));
+    }
+
+    // Disabled without a window
+    config.runaway_window_s = 0.0f;
+    runaway_reset(&m, &config);
+    for (int i = 0; i < 30; i++)
+    {
+        TEST_ASSERT_EQUAL(CONTROLLER_FAULT_NONE, runaway_update(&m, &config, 40.0f, 255));
+    }
+}
+
+void test_controller_runaway_latches_until_cleared(void)
+{
+    controller_config_t config = TEST_CONFIG;
+    config.control_period_s = 1.0f;
+    config.runaway_window_s = 5.0f;
+    config.runaway_min_rise = 2.0f;
+    config.runaway_idle_max_rise = 3.0f;
+    controller_snapshot_t snapshot;
+
+    setup_controller_test(&config, 60.0f);
+    controller_internal_state_t *state = controller_get_state();
+    ignore_control_cycle_mocks();
+
+    // Full power demanded, heater reading stuck at 30C
+    for (int i = 0; i < 10; i++)
+    {
+        controller_run(30.0f, 40.0f);
+    }
+    TEST_ASSERT_EQUAL(CONTROLLER_FAULT_HEATING_FAILED, state->fault);
+    TEST_ASSERT_EQUAL_UINT8(0, state->current_power);
+    TEST_ASSERT_EQUAL(CONTROLLER_STATE_IDLE, state->state);
+    TEST_ASSERT_TRUE(controller_get_snapshot(controller_get_default(), &snapshot));
+    TEST_ASSERT_EQUAL(CONTROLLER_FAULT_HEATING_FAILED, snapshot.fault);
+
+    // Latched: the heater stays off whatever the temperatures do
+    controller_run(30.0f, 20.0f);
+    TEST_ASSERT_EQUAL_UINT8(0, state->current_power);
+
+    // Clearing hands control back to the state machine
+    controller_instance_clear_fault(controller_get_default());
+    TEST_ASSERT_EQUAL(CONTROLLER_FAULT_NONE, state->fault);
+    controller_run(30.0f, 40.0f);
+    TEST_ASSERT_EQUAL_UINT8(255, state->current_power);
+
+    reset_control_cycle_mocks();
+    teardown_controller_test();
+}
+
 // Test group runner for controller tests
 void test_controller_group_runner(void)
 {
@@ -247,5 +708,16 @@ void test_controller_group_runner(void)
     RUN_TEST(test_controller_run_idle_no_transition);
     RUN_TEST(test_controller_run_idle_transition_to_full_power);
     RUN_TEST(test_controller_global_safety_override); // Add new test
+    RUN_TEST(test_controller_ramp_linear);
+    RUN_TEST(test_controller_ramp_s_curve);
+    RUN_TEST(test_controller_ramp_reseeds_on_reactivation);
+    RUN_TEST(test_controller_instances_are_independent);
+    RUN_TEST(test_controller_snapshot_and_telemetry);
+    RUN_TEST(test_controller_rejects_invalid_temperatures);
+    RUN_TEST(test_controller_schedule_lookup);
+    RUN_TEST(test_controller_schedule_drives_state_machine);
+    RUN_TEST(test_controller_runaway_window);
+    RUN_TEST(test_controller_runaway_latches_until_cleared);
+    RUN_TEST(test_controller_interlock_blocks_heat);
     printf("Controller tests completed\n");
 }
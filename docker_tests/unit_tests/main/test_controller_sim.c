@@ -0,0 +1,314 @@
+#include <stdio.h>
+#include "unity.h"
+#include "heater_controller.h"
+#include "plant_sim.h"
+
+#include "Mockmock_heater.h"
+#include "Mockmock_semphr.h"
+
+#define SIM_AMBIENT_TEMP 25.0f
+#define SIM_TARGET_TEMP 60.0f
+#define SIM_DURATION_S 3600
+#define SIM_SETTLED_BAND 2.0f
+#define SIM_DEFAULT_HEATER_W 280.0f // plant_sim_init() default
+#define SIM_WEAK_HEATER_W 100.0f    // Element equilibrium ~17C above the air, under 2C/min near the target
+
+static const controller_config_t SIM_CONFIG = {
+    .max_heater_temp = 100.0f,
+    .air_temp_hysteresis = 1.0f,
+    .heater_temp_hysteresis = 2.0f,
+    .full_power_delta = 5.0f,
+    .control_period_s = 1.0f,
+};
+
+/** @brief Figures of merit for one closed-loop run. */
+typedef struct
+{
+    float peak_heater_temp;  // Highest element temperature seen (C)
+    int safety_override_s;   // Seconds spent with the heater safety override latched
+    int time_to_target_s;    // First time air was within SIM_SETTLED_BAND of target, -1 if never
+    uint8_t peak_power;      // Highest power the element received
+    float max_window_power;  // Highest mean power over any budget window (0-255), 0 without a budget
+} sim_result_t;
+
+/**
+ * @brief Runs the controller against the plant for SIM_DURATION_S with a 1 s control period
+ * @param limit Power budget of the heater output, NULL for none
+ */
+static sim_result_t run_closed_loop(const controller_config_t *config, const power_limit_config_t *limit)
+{
+    sim_result_t result = {.peak_heater_temp = SIM_AMBIENT_TEMP, .safety_override_s = 0, .time_to_target_s = -1};
+    static uint8_t applied[SIM_DURATION_S];
+    plant_sim_t plant;
+    plant_sim_init(&plant, SIM_AMBIENT_TEMP);
+    if (limit != NULL)
+    {
+        plant_sim_set_power_limit(&plant, limit);
+    }
+
+    xSemaphoreCreateMutex_IgnoreAndReturn((SemaphoreHandle_t)0x1234);
+    xSemaphoreTake_IgnoreAndReturn(pdTRUE);
+    xSemaphoreGive_IgnoreAndReturn(pdTRUE);
+    vSemaphoreDelete_Ignore();
+    set_heat_power_Ignore();
+
+    controller_init(config, SIM_TARGET_TEMP);
+    controller_internal_state_t *state = controller_get_state();
+
+    for (int t = 0; t < SIM_DURATION_S; t++)
+    {
+        controller_run(plant.heater_temp, plant.air_temp);
+        plant_sim_step(&plant, state->current_power, config->control_period_s);
+        applied[t] = plant.applied_power;
+        if (plant.applied_power > result.peak_power)
+        {
+            result.peak_power = plant.applied_power;
+        }
+
+        if (plant.heater_temp > result.peak_heater_temp)
+        {
+            result.peak_heater_temp = plant.heater_temp;
+        }
+        if (state->heater_safety_override_active)
+        {
+            result.safety_override_s++;
+        }
+        if (result.time_to_target_s < 0 && plant.air_temp >= SIM_TARGET_TEMP - SIM_SETTLED_BAND)
+        {
+            result.time_to_target_s = t;
+        }
+    }
+
+    controller_deinit();
+    Mockmock_semphr_Destroy();
+    Mockmock_heater_Destroy();
+
+    // Rolling mean over the budget window, checked independently of the limiter's own bookkeeping
+    int window_s = limit != NULL ? (int)(limit->window_ms / 1000) : 0;
+    uint32_t window_sum = 0;
+    for (int t = 0; window_s > 0 && t < SIM_DURATION_S; t++)
+    {
+        window_sum += applied[t];
+        if (t >= window_s)
+        {
+            window_sum -= applied[t - window_s];
+        }
+        if (t >= window_s - 1 && (float)window_sum / window_s > result.max_window_power)
+        {
+            result.max_window_power = (float)window_sum / window_s;
+        }
+    }
+
+    printf("ramp %.1f C/min accel %.1f C/min^2: peak heater %.1fC, override %ds, target after %ds\n",
+           config->ramp_rate, config->ramp_accel, result.peak_heater_temp, result.safety_override_s,
+           result.time_to_target_s);
+    return result;
+}
+
+void test_controller_sim_step_response_hits_safety_override(void)
+{
+    // Baseline: an instant 25C -> 60C step pins the heater until max_heater_temp trips
+    sim_result_t step = run_closed_loop(&SIM_CONFIG, NULL);
+
+    TEST_ASSERT_TRUE(step.peak_heater_temp >= SIM_CONFIG.max_heater_temp);
+    TEST_ASSERT_GREATER_THAN(0, step.safety_override_s);
+    TEST_ASSERT_NOT_EQUAL(-1, step.time_to_target_s);
+}
+
+void test_controller_sim_s_curve_ramp_limits_heater_peak(void)
+{
+    controller_config_t ramped_config = SIM_CONFIG;
+    ramped_config.ramp_rate = 1.0f;
+    ramped_config.ramp_accel = 2.0f;
+
+    sim_result_t step = run_closed_loop(&SIM_CONFIG, NULL);
+    sim_result_t ramped = run_closed_loop(&ramped_config, NULL);
+
+    // Tracking the ramped reference keeps the element below the safety limit
+    TEST_ASSERT_TRUE(ramped.peak_heater_temp < SIM_CONFIG.max_heater_temp);
+    TEST_ASSERT_TRUE(ramped.peak_heater_temp < step.peak_heater_temp);
+    TEST_ASSERT_EQUAL_INT(0, ramped.safety_override_s);
+
+    // The price is a slower approach, bounded by the ramp: 35C at 1C/min plus the S-curve ends
+    TEST_ASSERT_NOT_EQUAL(-1, ramped.time_to_target_s);
+    TEST_ASSERT_TRUE(ramped.time_to_target_s > step.time_to_target_s);
+    TEST_ASSERT_TRUE(ramped.time_to_target_s < 40 * 60);
+}
+
+void test_controller_sim_power_budget(void)
+{
+    // Half the element's 280 W on average, full power allowed in bursts, over a long and a short window
+    const power_limit_config_t long_window = {.max_average = 128, .peak = 255, .window_ms = 600000};
+    const power_limit_config_t short_window = {.max_average = 128, .peak = 255, .window_ms = 120000};
+    // A supply that can never deliver more than 60%
+    const power_limit_config_t peak_limit = {.max_average = 255, .peak = 153, .window_ms = 0};
+
+    sim_result_t unlimited = run_closed_loop(&SIM_CONFIG, NULL);
+    sim_result_t long_avg = run_closed_loop(&SIM_CONFIG, &long_window);
+    sim_result_t short_avg = run_closed_loop(&SIM_CONFIG, &short_window);
+    sim_result_t capped = run_closed_loop(&SIM_CONFIG, &peak_limit);
+    printf("heat-up to %.0fC: unlimited %ds, 50%%/10 min %ds, 50%%/2 min %ds, 60%% peak %ds\n", SIM_TARGET_TEMP,
+           unlimited.time_to_target_s, long_avg.time_to_target_s, short_avg.time_to_target_s, capped.time_to_target_s);
+
+    // The budget holds over every window, whatever the controller asked for
+    TEST_ASSERT_LESS_OR_EQUAL_FLOAT(128.0f * 1.02f, long_avg.max_window_power);
+    TEST_ASSERT_LESS_OR_EQUAL_FLOAT(128.0f * 1.02f, short_avg.max_window_power);
+    TEST_ASSERT_EQUAL_UINT8(255, short_avg.peak_power); // Bursts still allowed
+    TEST_ASSERT_LESS_OR_EQUAL_UINT8(153, capped.peak_power);
+
+    // A 10 minute window's cold-start burst covers the whole heat-up; a 2 minute one does not
+    TEST_ASSERT_EQUAL_INT(unlimited.time_to_target_s, long_avg.time_to_target_s);
+    TEST_ASSERT_NOT_EQUAL(-1, short_avg.time_to_target_s);
+    TEST_ASSERT_NOT_EQUAL(-1, capped.time_to_target_s);
+    TEST_ASSERT_TRUE(short_avg.time_to_target_s > unlimited.time_to_target_s);
+    TEST_ASSERT_TRUE(capped.time_to_target_s > unlimited.time_to_target_s);
+}
+
+void test_controller_sim_autotune_builds_schedule(void)
+{
+    static const float setpoints[] = {40.0f, 70.0f};
+    plant_sim_t plant;
+    plant_sim_init(&plant, SIM_AMBIENT_TEMP);
+
+    xSemaphoreCreateMutex_IgnoreAndReturn((SemaphoreHandle_t)0x1234);
+    xSemaphoreTake_IgnoreAndReturn(pdTRUE);
+    xSemaphoreGive_IgnoreAndReturn(pdTRUE);
+    vSemaphoreDelete_Ignore();
+    set_heat_power_Ignore();
+
+    controller_init(&SIM_CONFIG, SIM_AMBIENT_TEMP);
+    controller_internal_state_t *state = controller_get_state();
+    TEST_ASSERT_TRUE(controller_instance_start_autotune(controller_get_default(), setpoints, 2));
+
+    float peak_heater_temp = SIM_AMBIENT_TEMP;
+    int t = 0;
+    for (; t < 4 * 3600 && state->autotuning; t++)
+    {
+        controller_run(plant.heater_temp, plant.air_temp);
+        plant_sim_step(&plant, state->current_power, SIM_CONFIG.control_period_s);
+        if (plant.heater_temp > peak_heater_temp)
+        {
+            peak_heater_temp = plant.heater_temp;
+        }
+    }
+
+    controller_config_t tuned;
+    TEST_ASSERT_TRUE(controller_instance_get_config(controller_get_default(), &tuned));
+    bool still_active = state->active;
+    uint8_t final_power = state->current_power;
+
+    controller_deinit();
+    Mockmock_semphr_Destroy();
+    Mockmock_heater_Destroy();
+
+    printf("auto-tune finished after %ds, peak heater %.1fC\n", t, peak_heater_temp);
+    for (uint8_t i = 0; i < tuned.schedule.count; i++)
+    {
+        const controller_schedule_point_t *p = &tuned.schedule.points[i];
+        printf("  %.0fC: air hyst %.2f, heater hyst %.2f, full power delta %.2f\n",
+               p->setpoint, p->air_temp_hysteresis, p->heater_temp_hysteresis, p->full_power_delta);
+    }
+
+    // Finished, heater off and controller left inactive
+    TEST_ASSERT_FALSE(still_active);
+    TEST_ASSERT_EQUAL_UINT8(0, final_power);
+    TEST_ASSERT_TRUE(peak_heater_temp < SIM_CONFIG.max_heater_temp + 1.0f);
+
+    // One entry per setpoint, in order
+    TEST_ASSERT_EQUAL_UINT8(2, tuned.schedule.count);
+    TEST_ASSERT_EQUAL_FLOAT(40.0f, tuned.schedule.points[0].setpoint);
+    TEST_ASSERT_EQUAL_FLOAT(70.0f, tuned.schedule.points[1].setpoint);
+
+    // Holding 70C needs far more duty than 40C, so the heater band widens with the setpoint
+    TEST_ASSERT_TRUE(tuned.schedule.points[1].heater_temp_hysteresis > tuned.schedule.points[0].heater_temp_hysteresis);
+}
+
+/** @brief Injected hardware failure for the thermal protection runs. */
+typedef enum
+{
+    SIM_FAILURE_NONE,
+    SIM_FAILURE_SENSOR_DETACHED, // Heater thermistor falls off the element and reads ambient
+    SIM_FAILURE_OUTPUT_STUCK_ON, // Output stage shorted: full power whatever is commanded
+} sim_failure_t;
+
+/**
+ * @brief Runs a protected closed loop, injecting a failure at failure_at_s
+ * @param heater_power_w Element power at full duty
+ * @param[out] fault_at_s Time the controller latched a fault, -1 if it never did
+ * @return Fault latched at the end of the run
+ */
+static controller_fault_t run_protected_loop(float heater_power_w, sim_failure_t failure, int failure_at_s, int *fault_at_s)
+{
+    controller_config_t config = SIM_CONFIG;
+    config.runaway_window_s = 60.0f;
+    config.runaway_min_rise = 2.0f;
+    config.runaway_idle_max_rise = 5.0f;
+
+    plant_sim_t plant;
+    plant_sim_init(&plant, SIM_AMBIENT_TEMP);
+    plant.heater_power_w = heater_power_w;
+
+    xSemaphoreCreateMutex_IgnoreAndReturn((SemaphoreHandle_t)0x1234);
+    xSemaphoreTake_IgnoreAndReturn(pdTRUE);
+    xSemaphoreGive_IgnoreAndReturn(pdTRUE);
+    vSemaphoreDelete_Ignore();
+    set_heat_power_Ignore();
+
+    controller_init(&config, SIM_TARGET_TEMP);
+    controller_internal_state_t *state = controller_get_state();
+
+    *fault_at_s = -1;
+    for (int t = 0; t < SIM_DURATION_S; t++)
+    {
+        bool failed = failure != SIM_FAILURE_NONE && t >= failure_at_s;
+        float heater_reading = (failed && failure == SIM_FAILURE_SENSOR_DETACHED) ? SIM_AMBIENT_TEMP : plant.heater_temp;
+
+        controller_run(heater_reading, plant.air_temp);
+        uint8_t power = (failed && failure == SIM_FAILURE_OUTPUT_STUCK_ON) ? 255 : state->current_power;
+        plant_sim_step(&plant, power, config.control_period_s);
+
+        if (*fault_at_s < 0 && state->fault != CONTROLLER_FAULT_NONE)
+        {
+            *fault_at_s = t;
+        }
+    }
+
+    controller_fault_t fault = state->fault;
+    controller_deinit();
+    Mockmock_semphr_Destroy();
+    Mockmock_heater_Destroy();
+    return fault;
+}
+
+void test_controller_sim_thermal_protection(void)
+{
+    int fault_at_s;
+
+    // A healthy heater through a step warm-up (safety override included) and an hour of regulation never trips
+    TEST_ASSERT_EQUAL(CONTROLLER_FAULT_NONE, run_protected_loop(SIM_DEFAULT_HEATER_W, SIM_FAILURE_NONE, 0, &fault_at_s));
+
+    // A weak element creeps towards the target with the heater plateaued well below max_heater_temp
+    TEST_ASSERT_EQUAL(CONTROLLER_FAULT_NONE, run_protected_loop(SIM_WEAK_HEATER_W, SIM_FAILURE_NONE, 0, &fault_at_s));
+
+    // Thermistor detached during warm-up: flat reading at full power, caught within about one window
+    TEST_ASSERT_EQUAL(CONTROLLER_FAULT_HEATING_FAILED, run_protected_loop(SIM_DEFAULT_HEATER_W, SIM_FAILURE_SENSOR_DETACHED, 20, &fault_at_s));
+    printf("sensor detached at 20s, fault after %ds\n", fault_at_s - 20);
+    TEST_ASSERT_TRUE(fault_at_s > 20 && fault_at_s <= 20 + 61);
+
+    // Output stuck on once the air is regulating: the element heats with power commanded off
+    TEST_ASSERT_EQUAL(CONTROLLER_FAULT_RUNAWAY, run_protected_loop(SIM_DEFAULT_HEATER_W, SIM_FAILURE_OUTPUT_STUCK_ON, 2400, &fault_at_s));
+    printf("output stuck on at 2400s, fault after %ds\n", fault_at_s - 2400);
+    TEST_ASSERT_TRUE(fault_at_s > 2400);
+}
+
+// Test group runner for closed-loop controller simulation tests
+void test_controller_sim_group_runner(void)
+{
+    printf("Running controller simulation tests...\n");
+    RUN_TEST(test_controller_sim_step_response_hits_safety_override);
+    RUN_TEST(test_controller_sim_s_curve_ramp_limits_heater_peak);
+    RUN_TEST(test_controller_sim_power_budget);
+    RUN_TEST(test_controller_sim_autotune_builds_schedule);
+    RUN_TEST(test_controller_sim_thermal_protection);
+    printf("Controller simulation tests completed\n");
+}
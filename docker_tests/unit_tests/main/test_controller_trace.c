@@ -0,0 +1,134 @@
+#include <stdio.h>
+#include "unity.h"
+#include "controller_trace.h"
+#include "heater_controller.h"
+
+#include "Mockmock_esp_heap_caps.h"
+#include "Mockmock_esp_timer.h"
+#include "Mockmock_heater.h"
+#include "Mockmock_semphr.h"
+
+// Stand-in for the PSRAM ring
+static controller_trace_record_t s_test_ring[CONTROLLER_TRACE_CAPACITY];
+
+static void trace_setup(void)
+{
+    heap_caps_malloc_ExpectAnyArgsAndReturn(s_test_ring);
+    TEST_ASSERT_TRUE(controller_trace_init());
+}
+
+static void trace_teardown(void)
+{
+    heap_caps_free_Expect(s_test_ring);
+    controller_trace_deinit();
+}
+
+void test_controller_trace_disabled_without_init(void)
+{
+    controller_trace_record_t record = {0};
+    TEST_ASSERT_FALSE(controller_trace_enabled());
+    controller_trace_record(&record); // Must be a harmless no-op
+    TEST_ASSERT_EQUAL_size_t(0, controller_trace_read(0, &record, 1));
+}
+
+void test_controller_trace_alloc_failure(void)
+{
+    heap_caps_malloc_ExpectAnyArgsAndReturn(NULL);
+    TEST_ASSERT_FALSE(controller_trace_init());
+    TEST_ASSERT_FALSE(controller_trace_enabled());
+}
+
+void test_controller_trace_wraps_oldest_first(void)
+{
+    trace_setup();
+
+    // Overfill by 10 records
+    for (uint32_t i = 0; i < CONTROLLER_TRACE_CAPACITY + 10; i++)
+    {
+        controller_trace_record_t record = {.timestamp_ms = i};
+        controller_trace_record(&record);
+    }
+
+    TEST_ASSERT_EQUAL_size_t(CONTROLLER_TRACE_CAPACITY, controller_trace_count());
+    TEST_ASSERT_EQUAL_UINT32(CONTROLLER_TRACE_CAPACITY + 10, controller_trace_total());
+
+    controller_trace_record_t out[4];
+    TEST_ASSERT_EQUAL_size_t(4, controller_trace_read(0, out, 4));
+    TEST_ASSERT_EQUAL_UINT32(10, out[0].timestamp_ms); // Oldest surviving record
+    TEST_ASSERT_EQUAL_UINT32(13, out[3].timestamp_ms);
+    TEST_ASSERT_EQUAL_UINT16(10, out[0].sequence);
+
+    // Reading near the end returns only what is left
+    TEST_ASSERT_EQUAL_size_t(2, controller_trace_read(CONTROLLER_TRACE_CAPACITY - 2, out, 4));
+    TEST_ASSERT_EQUAL_UINT32(CONTROLLER_TRACE_CAPACITY + 9, out[1].timestamp_ms);
+    TEST_ASSERT_EQUAL_size_t(0, controller_trace_read(CONTROLLER_TRACE_CAPACITY, out, 4));
+
+    trace_teardown();
+}
+
+void test_controller_trace_temp_fixed_point(void)
+{
+    TEST_ASSERT_EQUAL_INT16(253, controller_trace_temp(25.3f));
+    TEST_ASSERT_EQUAL_INT16(-999, controller_trace_temp(-99.9f));
+    TEST_ASSERT_EQUAL_INT16(INT16_MAX, controller_trace_temp(5000.0f));
+}
+
+void test_controller_trace_records_control_cycles(void)
+{
+    static const controller_config_t config = {
+        .max_heater_temp = 100.0f,
+        .air_temp_hysteresis = 1.0f,
+        .heater_temp_hysteresis = 2.0f,
+        .full_power_delta = 5.0f,
+    };
+
+    trace_setup();
+    xSemaphoreCreateMutex_IgnoreAndReturn((SemaphoreHandle_t)0x1234);
+    xSemaphoreTake_IgnoreAndReturn(pdTRUE);
+    xSemaphoreGive_IgnoreAndReturn(pdTRUE);
+    set_heat_power_Ignore();
+    controller_init(&config, 50.0f);
+
+    // Cycle starts at t = 2 s and takes 40 us
+    esp_timer_get_time_ExpectAndReturn(2000000);
+    esp_timer_get_time_ExpectAndReturn(2000040);
+    controller_run(30.0f, 40.0f); // Full power
+
+    esp_timer_get_time_ExpectAndReturn(3000000);
+    esp_timer_get_time_ExpectAndReturn(3000025);
+    controller_run(101.0f, 41.0f); // Safety override
+
+    controller_trace_record_t out[2];
+    TEST_ASSERT_EQUAL_size_t(2, controller_trace_read(0, out, 2));
+
+    TEST_ASSERT_EQUAL_UINT32(2000, out[0].timestamp_ms);
+    TEST_ASSERT_EQUAL_INT16(300, out[0].heater_temp);
+    TEST_ASSERT_EQUAL_INT16(400, out[0].air_temp);
+    TEST_ASSERT_EQUAL_INT16(500, out[0].reference);
+    TEST_ASSERT_EQUAL_UINT8(255, out[0].power);
+    TEST_ASSERT_EQUAL_UINT16(40, out[0].loop_us);
+    TEST_ASSERT_EQUAL_UINT8(CONTROLLER_STATE_HEATING_FULL_POWER | CONTROLLER_TRACE_FLAG_ACTIVE, out[0].flags);
+
+    TEST_ASSERT_EQUAL_UINT8(0, out[1].power);
+    TEST_ASSERT_EQUAL_UINT16(25, out[1].loop_us);
+    TEST_ASSERT_EQUAL_UINT8(CONTROLLER_STATE_IDLE | CONTROLLER_TRACE_FLAG_ACTIVE | CONTROLLER_TRACE_FLAG_OVERRIDE,
+                            out[1].flags);
+
+    vSemaphoreDelete_Ignore();
+    controller_deinit();
+    Mockmock_semphr_Destroy();
+    Mockmock_heater_Destroy();
+    trace_teardown();
+}
+
+// Test group runner for controller trace tests
+void test_controller_trace_group_runner(void)
+{
+    printf("Running controller trace tests...\n");
+    RUN_TEST(test_controller_trace_disabled_without_init);
+    RUN_TEST(test_controller_trace_alloc_failure);
+    RUN_TEST(test_controller_trace_wraps_oldest_first);
+    RUN_TEST(test_controller_trace_temp_fixed_point);
+    RUN_TEST(test_controller_trace_records_control_cycles);
+    printf("Controller trace tests completed\n");
+}
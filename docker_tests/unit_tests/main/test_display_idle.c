@@ -0,0 +1,46 @@
+#include <stdio.h>
+#include "unity.h"
+#include "display_idle.h"
+
+static const display_idle_config_t s_config = {
+    .dim_after_ms = 60000,
+    .sleep_after_ms = 600000,
+    .throttle_after_ms = 1000,
+};
+
+void test_display_idle_state_thresholds(void)
+{
+    TEST_ASSERT_EQUAL(DISPLAY_IDLE_ACTIVE, display_idle_state(&s_config, 0));
+    TEST_ASSERT_EQUAL(DISPLAY_IDLE_ACTIVE, display_idle_state(&s_config, 59999));
+    TEST_ASSERT_EQUAL(DISPLAY_IDLE_DIM, display_idle_state(&s_config, 60000));
+    TEST_ASSERT_EQUAL(DISPLAY_IDLE_SLEEP, display_idle_state(&s_config, 600000));
+
+    // Zero disables a stage; sleep still follows without dimming first
+    display_idle_config_t no_dim = s_config;
+    no_dim.dim_after_ms = 0;
+    TEST_ASSERT_EQUAL(DISPLAY_IDLE_ACTIVE, display_idle_state(&no_dim, 599999));
+    TEST_ASSERT_EQUAL(DISPLAY_IDLE_SLEEP, display_idle_state(&no_dim, 600000));
+
+    display_idle_config_t never = {0};
+    TEST_ASSERT_EQUAL(DISPLAY_IDLE_ACTIVE, display_idle_state(&never, UINT32_MAX));
+}
+
+void test_display_idle_render_mode(void)
+{
+    // Recent screen changes or running animations keep the full rate, even when dimmed
+    TEST_ASSERT_EQUAL(DISPLAY_RENDER_FULL_RATE, display_idle_render_mode(&s_config, DISPLAY_IDLE_ACTIVE, 500, false));
+    TEST_ASSERT_EQUAL(DISPLAY_RENDER_FULL_RATE, display_idle_render_mode(&s_config, DISPLAY_IDLE_DIM, 5000, true));
+
+    TEST_ASSERT_EQUAL(DISPLAY_RENDER_THROTTLED, display_idle_render_mode(&s_config, DISPLAY_IDLE_ACTIVE, 1000, false));
+    TEST_ASSERT_EQUAL(DISPLAY_RENDER_THROTTLED, display_idle_render_mode(&s_config, DISPLAY_IDLE_DIM, 5000, false));
+
+    // Asleep nothing is rendered, whatever changes
+    TEST_ASSERT_EQUAL(DISPLAY_RENDER_PAUSED, display_idle_render_mode(&s_config, DISPLAY_IDLE_SLEEP, 0, true));
+}
+
+void test_display_idle_group_runner(void)
+{
+    RUN_TEST(test_display_idle_state_thresholds);
+    RUN_TEST(test_display_idle_render_mode);
+    printf("Display idle tests completed\n");
+}
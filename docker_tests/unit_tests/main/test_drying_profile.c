@@ -0,0 +1,166 @@
+#include "unity.h"
+#include "drying_profile.h"
+#include <string.h>
+
+// Two-step test profile: ramp to 60C at 2C/min and soak 10 min, then cool to 40C and hold
+static const char *TEST_PROFILE_TEXT =
+    "# test profile\n"
+    "60,2,10,time\n"
+    "\n"
+    "40,0,0,hold\n";
+
+void test_profile_parse_valid(void)
+{
+    drying_profile_t profile;
+    TEST_ASSERT_TRUE(profile_parse("TEST", TEST_PROFILE_TEXT, &profile));
+
+    TEST_ASSERT_EQUAL_STRING("TEST", profile.name);
+    TEST_ASSERT_EQUAL_UINT8(2, profile.step_count);
+    TEST_ASSERT_EQUAL_FLOAT(60.0f, profile.steps[0].setpoint);
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, profile.steps[0].ramp_rate);
+    TEST_ASSERT_EQUAL_UINT32(600, profile.steps[0].duration_s);
+    TEST_ASSERT_EQUAL(PROFILE_EXIT_DURATION, profile.steps[0].exit);
+    TEST_ASSERT_EQUAL(PROFILE_EXIT_HOLD, profile.steps[1].exit);
+}
+
+void test_profile_parse_limits(void)
+{
+    drying_profile_t profile;
+    TEST_ASSERT_TRUE(profile_parse("TEST", "0,0,0,hold\n90,10,4320,time\n", &profile)); // Every limit inclusive
+    TEST_ASSERT_EQUAL_FLOAT(PROFILE_SETPOINT_MAX, profile.steps[1].setpoint);
+    TEST_ASSERT_EQUAL_UINT32(PROFILE_DURATION_MAX_MIN * 60, profile.steps[1].duration_s);
+}
+
+void test_profile_parse_invalid(void)
+{
+    drying_profile_t profile;
+    TEST_ASSERT_FALSE(profile_parse("TEST", "", &profile));                 // No steps
+    TEST_ASSERT_FALSE(profile_parse("TEST", "# only a comment\n", &profile)); // No steps
+    TEST_ASSERT_FALSE(profile_parse("TEST", "60,2,10\n", &profile));         // Missing exit
+    TEST_ASSERT_FALSE(profile_parse("TEST", "60,2,10,forever\n", &profile)); // Unknown exit
+    TEST_ASSERT_FALSE(profile_parse("TEST", "60,-1,10,time\n", &profile));   // Negative ramp rate
+    TEST_ASSERT_FALSE(profile_parse("TEST", "-5,2,10,time\n", &profile));    // Negative setpoint
+    TEST_ASSERT_FALSE(profile_parse("TEST", "200,2,10,time\n", &profile));   // Setpoint above the air limit
+    TEST_ASSERT_FALSE(profile_parse("TEST", "nan,2,10,time\n", &profile));   // Not a number
+    TEST_ASSERT_FALSE(profile_parse("TEST", "60,50,10,time\n", &profile));   // Ramp rate too fast
+    TEST_ASSERT_FALSE(profile_parse("TEST", "60,nan,10,time\n", &profile));  // Ramp rate not a number
+    TEST_ASSERT_FALSE(profile_parse("TEST", "60,2,-1,time\n", &profile));    // Negative duration
+    TEST_ASSERT_FALSE(profile_parse("TEST", "60,2,1e9,time\n", &profile));   // Duration too long
+    TEST_ASSERT_FALSE(profile_parse("../x", "60,2,10,time\n", &profile));    // Unsafe name
+    TEST_ASSERT_FALSE(profile_parse("TEST", "1,0,1,time\n1,0,1,time\n1,0,1,time\n1,0,1,time\n"
+                                            "1,0,1,time\n1,0,1,time\n1,0,1,time\n1,0,1,time\n"
+                                            "1,0,1,time\n",
+                                    &profile)); // Too many steps
+}
+
+void test_profile_format_round_trip(void)
+{
+    drying_profile_t parsed;
+    drying_profile_t reparsed;
+    char text[PROFILE_TEXT_MAX];
+
+    TEST_ASSERT_TRUE(profile_parse("TEST", TEST_PROFILE_TEXT, &parsed));
+    TEST_ASSERT_GREATER_THAN(0, profile_format(&parsed, text, sizeof(text)));
+    TEST_ASSERT_TRUE(profile_parse("TEST", text, &reparsed));
+    TEST_ASSERT_EQUAL_MEMORY(&parsed, &reparsed, sizeof(parsed));
+
+    // Buffer too small
+    TEST_ASSERT_EQUAL_INT(-1, profile_format(&parsed, text, 16));
+}
+
+void test_profile_builtin_lookup(void)
+{
+    TEST_ASSERT_GREATER_THAN(0, profile_builtin_count());
+    TEST_ASSERT_NOT_NULL(profile_builtin_find("PLA"));
+    TEST_ASSERT_NOT_NULL(profile_builtin_find("petg")); // Case-insensitive
+    TEST_ASSERT_NULL(profile_builtin_find("UNKNOWN"));
+    TEST_ASSERT_NULL(profile_builtin_get(profile_builtin_count()));
+
+    // Every built-in must survive a format/parse round trip
+    for (size_t i = 0; i < profile_builtin_count(); i++)
+    {
+        const drying_profile_t *builtin = profile_builtin_get(i);
+        drying_profile_t parsed;
+        char text[PROFILE_TEXT_MAX];
+        TEST_ASSERT_GREATER_THAN(0, profile_format(builtin, text, sizeof(text)));
+        TEST_ASSERT_TRUE(profile_parse(builtin->name, text, &parsed));
+        TEST_ASSERT_EQUAL_UINT8(builtin->step_count, parsed.step_count);
+    }
+}
+
+void test_profile_runner_ramp_and_duration(void)
+{
+    drying_profile_t profile;
+    profile_runner_t runner;
+    TEST_ASSERT_TRUE(profile_parse("TEST", TEST_PROFILE_TEXT, &profile));
+
+    profile_runner_start(&runner, &profile, 20.0f, 0);
+    TEST_ASSERT_TRUE(runner.running);
+    TEST_ASSERT_EQUAL_FLOAT(20.0f, runner.setpoint);
+
+    // 60 s at 2 C/min moves the setpoint up by 2 C
+    TEST_ASSERT_TRUE(profile_runner_tick(&runner, 20.0f, 60));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 22.0f, runner.setpoint);
+    TEST_ASSERT_FALSE(runner.ramp_done);
+
+    // Remaining = 19 min of ramp + 10 min soak
+    TEST_ASSERT_EQUAL_UINT32(19 * 60 + 600, profile_runner_remaining_s(&runner, 60));
+
+    // Ramp completes after 20 min, then the soak starts
+    TEST_ASSERT_TRUE(profile_runner_tick(&runner, 55.0f, 1200));
+    TEST_ASSERT_EQUAL_FLOAT(60.0f, runner.setpoint);
+    TEST_ASSERT_TRUE(runner.ramp_done);
+    TEST_ASSERT_EQUAL_UINT8(0, runner.step);
+
+    // Soak not over yet
+    TEST_ASSERT_TRUE(profile_runner_tick(&runner, 60.0f, 1200 + 599));
+    TEST_ASSERT_EQUAL_UINT8(0, runner.step);
+
+    // Soak over, move to the hold step with a jump to 40 C
+    TEST_ASSERT_TRUE(profile_runner_tick(&runner, 60.0f, 1200 + 600));
+    TEST_ASSERT_EQUAL_UINT8(1, runner.step);
+    TEST_ASSERT_TRUE(profile_runner_tick(&runner, 60.0f, 1200 + 601));
+    TEST_ASSERT_EQUAL_FLOAT(40.0f, runner.setpoint);
+
+    // Hold never ends on its own
+    TEST_ASSERT_TRUE(profile_runner_tick(&runner, 40.0f, 100000));
+    TEST_ASSERT_EQUAL_UINT32(0, profile_runner_remaining_s(&runner, 100000));
+
+    profile_runner_stop(&runner);
+    TEST_ASSERT_FALSE(profile_runner_tick(&runner, 40.0f, 100001));
+}
+
+void test_profile_runner_temp_reached_exit(void)
+{
+    drying_profile_t profile;
+    profile_runner_t runner;
+    TEST_ASSERT_TRUE(profile_parse("COOL", "30,0,5,reached\n", &profile));
+
+    profile_runner_start(&runner, &profile, 50.0f, 0);
+
+    // Cooling step: air still warm, not reached
+    TEST_ASSERT_TRUE(profile_runner_tick(&runner, 45.0f, 10));
+
+    // Air within the reached band of the setpoint ends the (last) step
+    TEST_ASSERT_FALSE(profile_runner_tick(&runner, 30.0f + PROFILE_REACHED_BAND, 20));
+    TEST_ASSERT_FALSE(runner.running);
+
+    // The duration acts as a timeout when the temperature is never reached
+    profile_runner_start(&runner, &profile, 50.0f, 0);
+    TEST_ASSERT_TRUE(profile_runner_tick(&runner, 45.0f, 299));
+    TEST_ASSERT_FALSE(profile_runner_tick(&runner, 45.0f, 300));
+}
+
+// Test group runner for drying profile tests
+void test_drying_profile_group_runner(void)
+{
+    printf("Running drying profile tests...\n");
+    RUN_TEST(test_profile_parse_valid);
+    RUN_TEST(test_profile_parse_invalid);
+    RUN_TEST(test_profile_parse_limits);
+    RUN_TEST(test_profile_format_round_trip);
+    RUN_TEST(test_profile_builtin_lookup);
+    RUN_TEST(test_profile_runner_ramp_and_duration);
+    RUN_TEST(test_profile_runner_temp_reached_exit);
+    printf("Drying profile tests completed\n");
+}
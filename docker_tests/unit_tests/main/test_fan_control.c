@@ -0,0 +1,136 @@
+#include <stdio.h>
+#include "unity.h"
+#include "fan_control.h"
+
+#define TEST_PERIOD_MS 1000
+
+static const fan_control_config_t TEST_FAN_CONFIG = {
+    .max_rpm = 3000,
+    .pulses_per_rev = 2,
+    .min_duty = 20,
+    .kp = 0.01f,
+    .ki = 0.005f,
+    .stall_rpm = 300,
+    .stall_time_ms = 3000,
+    .spinup_ms = 3000,
+};
+
+/**
+ * Host fan model: a weaker fan than the nominal max_rpm with a dead zone below 10% duty and a
+ * first-order speed response. Returns the tach pulses of one period.
+ */
+static uint32_t fan_model_step(float *rpm, uint8_t duty)
+{
+    float steady = duty > 10 ? (duty - 10) / 90.0f * 2600.0f : 0.0f;
+    *rpm += 0.5f * (steady - *rpm);
+    return (uint32_t)(*rpm * TEST_FAN_CONFIG.pulses_per_rev / 60.0f * TEST_PERIOD_MS / 1000.0f);
+}
+
+void test_fan_control_rpm_from_pulses(void)
+{
+    fan_control_t fc;
+    fan_control_reset(&fc);
+    fan_control_set_target(&fc, &TEST_FAN_CONFIG, 1500);
+
+    // 50 pulses in 1 s at 2 pulses/rev is 1500 RPM
+    fan_control_update(&fc, &TEST_FAN_CONFIG, 50, 1000);
+    TEST_ASSERT_EQUAL_UINT16(1500, fc.rpm);
+    fan_control_update(&fc, &TEST_FAN_CONFIG, 10, 250);
+    TEST_ASSERT_EQUAL_UINT16(1200, fc.rpm);
+
+    // Targets are capped at max_rpm
+    fan_control_set_target(&fc, &TEST_FAN_CONFIG, 9000);
+    TEST_ASSERT_EQUAL_UINT16(TEST_FAN_CONFIG.max_rpm, fc.target_rpm);
+}
+
+void test_fan_control_closed_loop_reaches_target(void)
+{
+    fan_control_t fc;
+    float rpm = 0.0f;
+    uint8_t duty = 0;
+    fan_control_reset(&fc);
+    fan_control_set_target(&fc, &TEST_FAN_CONFIG, 2000);
+
+    for (int t = 0; t < 60; t++)
+    {
+        duty = fan_control_update(&fc, &TEST_FAN_CONFIG, fan_model_step(&rpm, duty), TEST_PERIOD_MS);
+        TEST_ASSERT_FALSE(fc.stalled); // Spinning up is not a stall
+    }
+
+    // Feed-forward alone (67%) would leave this fan at ~1640 RPM; the integral makes up the rest
+    TEST_ASSERT_UINT16_WITHIN(60, 2000, fc.rpm);
+    TEST_ASSERT_GREATER_THAN_UINT8(70, duty);
+    TEST_ASSERT_TRUE(fan_control_airflow_ok(&fc, &TEST_FAN_CONFIG));
+
+    // Switching off drops the duty to 0 at once and clears the loop
+    fan_control_set_target(&fc, &TEST_FAN_CONFIG, 0);
+    TEST_ASSERT_EQUAL_UINT8(0, fan_control_update(&fc, &TEST_FAN_CONFIG, fan_model_step(&rpm, duty), TEST_PERIOD_MS));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, fc.integral);
+    TEST_ASSERT_FALSE(fan_control_airflow_ok(&fc, &TEST_FAN_CONFIG));
+}
+
+void test_fan_control_stall_detection(void)
+{
+    fan_control_t fc;
+    fan_control_reset(&fc);
+    fan_control_set_target(&fc, &TEST_FAN_CONFIG, 2000);
+
+    // A blocked fan never reports pulses: no stall during spin-up grace, then after stall_time_ms
+    uint32_t t = 0;
+    for (; t < TEST_FAN_CONFIG.spinup_ms + TEST_FAN_CONFIG.stall_time_ms - TEST_PERIOD_MS; t += TEST_PERIOD_MS)
+    {
+        fan_control_update(&fc, &TEST_FAN_CONFIG, 0, TEST_PERIOD_MS);
+        TEST_ASSERT_FALSE(fc.stalled);
+        TEST_ASSERT_FALSE(fan_control_airflow_ok(&fc, &TEST_FAN_CONFIG)); // Not turning yet
+    }
+    TEST_ASSERT_EQUAL_UINT8(100, fan_control_update(&fc, &TEST_FAN_CONFIG, 0, TEST_PERIOD_MS));
+    TEST_ASSERT_TRUE(fc.stalled);
+    TEST_ASSERT_FALSE(fan_control_airflow_ok(&fc, &TEST_FAN_CONFIG));
+
+    // Freed: recovers on the first period above stall_rpm and goes back to closed loop
+    fan_control_update(&fc, &TEST_FAN_CONFIG, 60, TEST_PERIOD_MS); // 1800 RPM
+    TEST_ASSERT_FALSE(fc.stalled);
+    TEST_ASSERT_TRUE(fan_control_airflow_ok(&fc, &TEST_FAN_CONFIG));
+    TEST_ASSERT_LESS_THAN_UINT8(100, fc.duty);
+
+    // A fan that slows down mid-run stalls without a new grace period
+    for (t = 0; t < TEST_FAN_CONFIG.stall_time_ms; t += TEST_PERIOD_MS)
+    {
+        fan_control_update(&fc, &TEST_FAN_CONFIG, 5, TEST_PERIOD_MS); // 150 RPM
+    }
+    TEST_ASSERT_TRUE(fc.stalled);
+
+    // A fan that is switched off is never stalled
+    fan_control_set_target(&fc, &TEST_FAN_CONFIG, 0);
+    fan_control_update(&fc, &TEST_FAN_CONFIG, 0, TEST_PERIOD_MS);
+    TEST_ASSERT_FALSE(fc.stalled);
+}
+
+void test_fan_control_duty_limits(void)
+{
+    fan_control_t fc;
+    fan_control_reset(&fc);
+    fan_control_set_target(&fc, &TEST_FAN_CONFIG, 300);
+
+    // A fan running far too fast is held at min_duty, and the integral does not wind down meanwhile
+    for (int i = 0; i < 20; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT8(TEST_FAN_CONFIG.min_duty, fan_control_update(&fc, &TEST_FAN_CONFIG, 100, TEST_PERIOD_MS));
+    }
+    float held = fc.integral;
+    fan_control_update(&fc, &TEST_FAN_CONFIG, 100, TEST_PERIOD_MS);
+    TEST_ASSERT_EQUAL_FLOAT(held, fc.integral);
+
+    // Zero-length intervals are ignored
+    TEST_ASSERT_EQUAL_UINT8(fc.duty, fan_control_update(&fc, &TEST_FAN_CONFIG, 1000, 0));
+    TEST_ASSERT_EQUAL_UINT16(3000, fc.rpm);
+}
+
+void test_fan_control_group_runner(void)
+{
+    RUN_TEST(test_fan_control_rpm_from_pulses);
+    RUN_TEST(test_fan_control_closed_loop_reaches_target);
+    RUN_TEST(test_fan_control_stall_detection);
+    RUN_TEST(test_fan_control_duty_limits);
+    printf("Fan control tests completed\n");
+}
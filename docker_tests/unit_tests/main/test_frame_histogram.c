@@ -0,0 +1,59 @@
+#include <stdio.h>
+#include <stdint.h>
+#include "unity.h"
+#include "frame_histogram.h"
+
+void test_frame_histogram_buckets(void)
+{
+  frame_histogram_t h;
+  frame_histogram_init(&h, 1000); // Microseconds in 1 ms steps
+
+  frame_histogram_add(&h, 999);     // < 1 ms
+  frame_histogram_add(&h, 1000);    // [1, 2) ms
+  frame_histogram_add(&h, 3999);    // [2, 4) ms
+  frame_histogram_add(&h, 4000);    // [4, 8) ms
+  frame_histogram_add(&h, 9000000); // Far past the top bucket
+
+  TEST_ASSERT_EQUAL_UINT32(1, h.counts[0]);
+  TEST_ASSERT_EQUAL_UINT32(1, h.counts[1]);
+  TEST_ASSERT_EQUAL_UINT32(1, h.counts[2]);
+  TEST_ASSERT_EQUAL_UINT32(1, h.counts[3]);
+  TEST_ASSERT_EQUAL_UINT32(1, h.counts[FRAME_HISTOGRAM_BUCKETS - 1]);
+  TEST_ASSERT_EQUAL_UINT32(5, h.samples);
+  TEST_ASSERT_EQUAL_UINT32(9000000, h.max);
+
+  TEST_ASSERT_EQUAL_UINT32(1000, frame_histogram_bucket_limit(&h, 0));
+  TEST_ASSERT_EQUAL_UINT32(8000, frame_histogram_bucket_limit(&h, 3));
+  TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, frame_histogram_bucket_limit(&h, FRAME_HISTOGRAM_BUCKETS - 1));
+}
+
+void test_frame_histogram_mean_and_percentiles(void)
+{
+  frame_histogram_t h;
+  frame_histogram_init(&h, 1000);
+  TEST_ASSERT_EQUAL_UINT32(0, frame_histogram_mean(&h));
+  TEST_ASSERT_EQUAL_UINT32(0, frame_histogram_percentile(&h, 50));
+
+  // 90 fast frames around 1.5 ms, 10 slow ones at 20 ms
+  for (int i = 0; i < 90; i++)
+  {
+    frame_histogram_add(&h, 1500);
+  }
+  for (int i = 0; i < 10; i++)
+  {
+    frame_histogram_add(&h, 20000);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32((90 * 1500 + 10 * 20000) / 100, frame_histogram_mean(&h));
+  TEST_ASSERT_EQUAL_UINT32(2000, frame_histogram_percentile(&h, 50));
+  TEST_ASSERT_EQUAL_UINT32(2000, frame_histogram_percentile(&h, 90));
+  TEST_ASSERT_EQUAL_UINT32(20000, frame_histogram_percentile(&h, 95)); // Bucket bound 32 ms capped at the max
+  TEST_ASSERT_EQUAL_UINT32(20000, frame_histogram_percentile(&h, 100));
+}
+
+void test_frame_histogram_group_runner(void)
+{
+  RUN_TEST(test_frame_histogram_buckets);
+  RUN_TEST(test_frame_histogram_mean_and_percentiles);
+  printf("Frame histogram tests completed\n");
+}
@@ -0,0 +1,85 @@
+#include <stdio.h>
+#include "unity.h"
+#include "heater_energy.h"
+#include "heater.h"
+
+#define TEST_WATTS 150.0f
+#define US_PER_S 1000000LL
+
+void test_heater_energy_integrates_duty(void)
+{
+    heater_energy_t e;
+    energy_session_t session;
+    heater_energy_reset(&e, HEATER_DUTY_MAX, HEATER_DUTY_MAX, 0);
+
+    // Half an hour at full power, half an hour off, in 1 s control periods
+    int64_t t = 0;
+    for (int i = 0; i < 3600; i++)
+    {
+        t += US_PER_S;
+        heater_energy_update(&e, i < 1799 ? HEATER_DUTY_MAX : 0, t);
+    }
+
+    heater_energy_summarize(&e, TEST_WATTS, &session);
+    TEST_ASSERT_EQUAL_UINT32(3600, session.duration_s);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 75.0f, session.energy_wh);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 75.0f, session.avg_power_w);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 50.0f, session.duty_percent);
+    TEST_ASSERT_EQUAL_UINT16(500, session.histogram_permille[0]);
+    TEST_ASSERT_EQUAL_UINT16(500, session.histogram_permille[HEATER_ENERGY_HISTOGRAM_BINS - 1]);
+    for (int i = 1; i < HEATER_ENERGY_HISTOGRAM_BINS - 1; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT16(0, session.histogram_permille[i]);
+    }
+}
+
+void test_heater_energy_no_accumulation_drift(void)
+{
+    heater_energy_t e;
+    heater_energy_reset(&e, HEATER_DUTY_MAX, 1234, 0);
+
+    // A million irregular periods: a float accumulator would have lost the low digits long ago
+    int64_t t = 0;
+    for (int i = 0; i < 1000000; i++)
+    {
+        t += 997 + (i % 7);
+        heater_energy_update(&e, 1234, t);
+    }
+    TEST_ASSERT_TRUE(e.elapsed_us == (uint64_t)t);
+    TEST_ASSERT_TRUE(e.duty_us == 1234ULL * (uint64_t)t);
+    TEST_ASSERT_TRUE(e.histogram_us[1234 * HEATER_ENERGY_HISTOGRAM_BINS / (HEATER_DUTY_MAX + 1)] == (uint64_t)t);
+}
+
+void test_heater_energy_duty_changes(void)
+{
+    heater_energy_t e;
+    energy_session_t session;
+    heater_energy_reset(&e, HEATER_DUTY_MAX, 0, 5 * US_PER_S);
+
+    // A duty applies from the update that sets it; a timestamp that does not advance only switches duty
+    heater_energy_update(&e, HEATER_DUTY_MAX, 5 * US_PER_S);
+    heater_energy_update(&e, 0, 5 * US_PER_S - 1);
+    heater_energy_update(&e, HEATER_DUTY_MAX * 2, 6 * US_PER_S); // Clamped to full power
+    TEST_ASSERT_TRUE(e.duty_us == 0);
+    TEST_ASSERT_EQUAL_UINT32(HEATER_DUTY_MAX, e.duty);
+    heater_energy_update(&e, 0, 8 * US_PER_S);
+
+    heater_energy_summarize(&e, 3600.0f, &session);
+    TEST_ASSERT_EQUAL_UINT32(3, session.duration_s);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 2.0f, session.energy_wh); // 2 s at 3600 W
+    TEST_ASSERT_EQUAL_UINT16(667, session.histogram_permille[HEATER_ENERGY_HISTOGRAM_BINS - 1]);
+
+    // Nothing integrated yet: all zeros rather than a division by zero
+    heater_energy_reset(&e, HEATER_DUTY_MAX, HEATER_DUTY_MAX, 0);
+    heater_energy_summarize(&e, TEST_WATTS, &session);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, session.energy_wh);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, session.avg_power_w);
+}
+
+void test_heater_energy_group_runner(void)
+{
+    RUN_TEST(test_heater_energy_integrates_duty);
+    RUN_TEST(test_heater_energy_no_accumulation_drift);
+    RUN_TEST(test_heater_energy_duty_changes);
+    printf("Heater energy tests completed\n");
+}
@@ -0,0 +1,150 @@
+#include <stdio.h>
+#include "unity.h"
+#include "sigma_delta.h"
+#include "heater.h"
+#include "plant_sim.h"
+
+#define SIM_PWM_PERIOD_S (1.0f / HEATER_PWM_FREQ_HZ)
+#define SIM_SD_PERIOD_S (HEATER_SIGMA_DELTA_PERIOD_MS / 1000.0f)
+#define SIM_DURATION_S 400.0f  // Element settles (time constant ~25 s) with the air held constant
+#define SIM_MEASURE_S 20.0f    // Ripple and switching measured over the last part of the run
+
+typedef struct
+{
+    float ripple;        // Peak-to-peak element temperature at steady state (C)
+    float mean_power;    // Average fraction of full power
+    uint32_t switches;   // Output edges per second
+} modulation_result_t;
+
+// Plant with the air pinned at ambient so the element reaches a true steady state
+static void sim_init(plant_sim_t *plant)
+{
+    plant_sim_init(plant, 25.0f);
+    plant->air_capacity = 1e12f;
+}
+
+static void track(modulation_result_t *r, const plant_sim_t *plant, float t, float *min, float *max)
+{
+    if (t >= SIM_DURATION_S - SIM_MEASURE_S)
+    {
+        *min = plant->heater_temp < *min ? plant->heater_temp : *min;
+        *max = plant->heater_temp > *max ? plant->heater_temp : *max;
+    }
+}
+
+// Fixed-frequency PWM: on for duty/max of every period, two edges per period
+static modulation_result_t simulate_pwm(uint32_t duty)
+{
+    plant_sim_t plant;
+    modulation_result_t r = {0};
+    float min = 1000.0f, max = -1000.0f, on_time = 0.0f;
+    float on_s = SIM_PWM_PERIOD_S * duty / HEATER_DUTY_MAX;
+    sim_init(&plant);
+
+    for (float t = 0.0f; t < SIM_DURATION_S; t += SIM_PWM_PERIOD_S)
+    {
+        plant_sim_step(&plant, 255, on_s);
+        track(&r, &plant, t, &min, &max);
+        plant_sim_step(&plant, 0, SIM_PWM_PERIOD_S - on_s);
+        track(&r, &plant, t, &min, &max);
+        on_time += on_s;
+        if (duty > 0 && duty < HEATER_DUTY_MAX && t >= SIM_DURATION_S - SIM_MEASURE_S)
+        {
+            r.switches += 2;
+        }
+    }
+    r.ripple = max - min;
+    r.mean_power = on_time / SIM_DURATION_S;
+    r.switches = (uint32_t)(r.switches / SIM_MEASURE_S);
+    return r;
+}
+
+// Sigma-delta: each slot fully on or off
+static modulation_result_t simulate_sigma_delta(uint32_t duty)
+{
+    plant_sim_t plant;
+    sigma_delta_t sd;
+    modulation_result_t r = {0};
+    float min = 1000.0f, max = -1000.0f;
+    uint32_t on_slots = 0, slots = 0;
+    bool previous = false;
+    sim_init(&plant);
+    sigma_delta_init(&sd, HEATER_DUTY_MAX);
+    sigma_delta_set_level(&sd, duty);
+
+    for (float t = 0.0f; t < SIM_DURATION_S; t += SIM_SD_PERIOD_S)
+    {
+        bool on = sigma_delta_step(&sd);
+        plant_sim_step(&plant, on ? 255 : 0, SIM_SD_PERIOD_S);
+        track(&r, &plant, t, &min, &max);
+        on_slots += on;
+        slots++;
+        if (on != previous && t >= SIM_DURATION_S - SIM_MEASURE_S)
+        {
+            r.switches++;
+        }
+        previous = on;
+    }
+    r.ripple = max - min;
+    r.mean_power = (float)on_slots / slots;
+    r.switches = (uint32_t)(r.switches / SIM_MEASURE_S);
+    return r;
+}
+
+void test_sigma_delta_average_is_exact(void)
+{
+    sigma_delta_t sd;
+    sigma_delta_init(&sd, HEATER_DUTY_MAX);
+
+    // Every level, including the smallest step, averages exactly over full_scale steps
+    const uint32_t levels[] = {0, 1, 41, 1000, 2048, HEATER_DUTY_MAX - 1, HEATER_DUTY_MAX};
+    for (size_t i = 0; i < sizeof(levels) / sizeof(levels[0]); i++)
+    {
+        sigma_delta_init(&sd, HEATER_DUTY_MAX);
+        sigma_delta_set_level(&sd, levels[i]);
+        uint32_t on = 0;
+        for (uint32_t step = 0; step < HEATER_DUTY_MAX; step++)
+        {
+            on += sigma_delta_step(&sd);
+        }
+        TEST_ASSERT_EQUAL_UINT32(levels[i], on);
+    }
+
+    // Clamped above full scale; a level change keeps the carried error
+    sigma_delta_set_level(&sd, HEATER_DUTY_MAX * 3);
+    TEST_ASSERT_EQUAL_UINT32(HEATER_DUTY_MAX, sd.level);
+    sigma_delta_init(&sd, 4);
+    sigma_delta_set_level(&sd, 3);
+    sigma_delta_step(&sd); // accumulator 3, off
+    sigma_delta_set_level(&sd, 1);
+    TEST_ASSERT_TRUE(sigma_delta_step(&sd)); // 3 + 1 carries over
+}
+
+void test_sigma_delta_vs_pwm_sim(void)
+{
+    const uint32_t duties[] = {HEATER_DUTY_MAX / 100, HEATER_DUTY_MAX / 10, HEATER_DUTY_MAX / 2};
+    for (size_t i = 0; i < sizeof(duties) / sizeof(duties[0]); i++)
+    {
+        modulation_result_t pwm = simulate_pwm(duties[i]);
+        modulation_result_t sd = simulate_sigma_delta(duties[i]);
+        printf("  duty %4lu/%u: PWM ripple %.4f C, %lu edges/s | sigma-delta ripple %.4f C, %lu edges/s\n",
+               (unsigned long)duties[i], HEATER_DUTY_MAX, pwm.ripple, (unsigned long)pwm.switches, sd.ripple,
+               (unsigned long)sd.switches);
+
+        // Same average power
+        float expected = (float)duties[i] / HEATER_DUTY_MAX;
+        TEST_ASSERT_FLOAT_WITHIN(expected * 0.01f, expected, pwm.mean_power);
+        TEST_ASSERT_FLOAT_WITHIN(expected * 0.01f, expected, sd.mean_power);
+
+        // Far fewer edges; the element ripple stays well under the thermistor's resolution
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(pwm.switches / 2, sd.switches);
+        TEST_ASSERT_LESS_THAN_FLOAT(0.1f, sd.ripple);
+    }
+}
+
+void test_heater_modulation_group_runner(void)
+{
+    RUN_TEST(test_sigma_delta_average_is_exact);
+    RUN_TEST(test_sigma_delta_vs_pwm_sim);
+    printf("Heater modulation tests completed\n");
+}
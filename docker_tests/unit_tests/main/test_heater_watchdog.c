@@ -0,0 +1,183 @@
+#include <stdio.h>
+#include "unity.h"
+#include "heater_watchdog.h"
+
+#include "Mockmock_esp_timer.h"
+
+#define TEST_TIMEOUT_MS 5000
+#define TEST_CHECK_PERIOD_MS 250
+#define TEST_CONTROL_PERIOD_MS 1000
+
+static int s_cutoff_calls;
+static int s_trip_calls;
+
+static void test_cutoff(void)
+{
+    s_cutoff_calls++;
+}
+
+static void test_on_trip(void)
+{
+    s_trip_calls++;
+}
+
+static void watchdog_setup(int64_t now_ms)
+{
+    static const heater_watchdog_config_t config = {
+        .timeout_ms = TEST_TIMEOUT_MS,
+        .cutoff = test_cutoff,
+        .on_trip = test_on_trip,
+    };
+    s_cutoff_calls = 0;
+    s_trip_calls = 0;
+    esp_timer_get_time_ExpectAndReturn(now_ms * 1000);
+    TEST_ASSERT_TRUE(heater_watchdog_init(&config));
+}
+
+static bool check_at(int64_t now_ms)
+{
+    esp_timer_get_time_ExpectAndReturn(now_ms * 1000);
+    return heater_watchdog_check();
+}
+
+void test_heater_watchdog_rejects_invalid_config(void)
+{
+    heater_watchdog_config_t config = {.timeout_ms = TEST_TIMEOUT_MS, .cutoff = NULL};
+    TEST_ASSERT_FALSE(heater_watchdog_init(NULL));
+    TEST_ASSERT_FALSE(heater_watchdog_init(&config)); // No cutoff
+    config.cutoff = test_cutoff;
+    config.timeout_ms = 0;
+    TEST_ASSERT_FALSE(heater_watchdog_init(&config));
+}
+
+void test_heater_watchdog_healthy_loop_never_trips(void)
+{
+    watchdog_setup(0);
+
+    // One feed per control period, checked at the timer rate for ten minutes
+    for (int64_t t = 0; t <= 600000; t += TEST_CHECK_PERIOD_MS)
+    {
+        if (t % TEST_CONTROL_PERIOD_MS == 0)
+        {
+            esp_timer_get_time_ExpectAndReturn(t * 1000);
+            TEST_ASSERT_TRUE(heater_watchdog_feed(60.0f, (uint32_t)(t / TEST_CONTROL_PERIOD_MS)));
+        }
+        TEST_ASSERT_FALSE(check_at(t));
+    }
+    TEST_ASSERT_EQUAL_INT(0, s_cutoff_calls);
+
+    heater_watchdog_deinit();
+}
+
+void test_heater_watchdog_stalled_loop_cut_within_deadline(void)
+{
+    watchdog_setup(0);
+
+    // Loop runs for 10 s, then hangs with the heater at whatever it last commanded
+    const int64_t stall_ms = 10000;
+    for (int64_t t = 0; t <= stall_ms; t += TEST_CONTROL_PERIOD_MS)
+    {
+        esp_timer_get_time_ExpectAndReturn(t * 1000);
+        heater_watchdog_feed(95.0f, (uint32_t)(t / TEST_CONTROL_PERIOD_MS));
+    }
+
+    int64_t cutoff_ms = -1;
+    for (int64_t t = stall_ms; t <= stall_ms + 3 * TEST_TIMEOUT_MS; t += TEST_CHECK_PERIOD_MS)
+    {
+        if (check_at(t) && cutoff_ms < 0)
+        {
+            cutoff_ms = t;
+        }
+    }
+
+    // Cut no earlier than the timeout and no later than one timer period after it
+    TEST_ASSERT_TRUE(cutoff_ms > stall_ms + TEST_TIMEOUT_MS);
+    TEST_ASSERT_TRUE(cutoff_ms <= stall_ms + TEST_TIMEOUT_MS + TEST_CHECK_PERIOD_MS);
+    TEST_ASSERT_TRUE(heater_watchdog_tripped());
+    TEST_ASSERT_EQUAL_INT(1, s_trip_calls);       // Reported once
+    TEST_ASSERT_GREATER_THAN(1, s_cutoff_calls); // Re-asserted on every later check
+
+    heater_watchdog_deinit();
+}
+
+void test_heater_watchdog_invalid_feeds_do_not_count(void)
+{
+    watchdog_setup(0);
+
+    // Loop still running, but on a dead heater sensor
+    esp_timer_get_time_ExpectAndReturn(1000 * 1000);
+    TEST_ASSERT_TRUE(heater_watchdog_feed(50.0f, 1));
+    TEST_ASSERT_FALSE(heater_watchdog_feed(-999.0f, 2));
+    TEST_ASSERT_FALSE(heater_watchdog_feed(HEATER_WATCHDOG_MAX_VALID_TEMP + 1.0f, 3));
+    TEST_ASSERT_FALSE(heater_watchdog_feed(0.0f / 0.0f, 4));
+
+    TEST_ASSERT_FALSE(check_at(1000 + TEST_TIMEOUT_MS));
+    TEST_ASSERT_TRUE(check_at(1000 + TEST_TIMEOUT_MS + 1));
+
+    heater_watchdog_deinit();
+}
+
+void test_heater_watchdog_frozen_sample_trips(void)
+{
+    watchdog_setup(0);
+
+    // Control loop keeps running, but temp_task hung and the same sample comes back every period
+    esp_timer_get_time_ExpectAndReturn(0);
+    TEST_ASSERT_TRUE(heater_watchdog_feed(80.0f, 7));
+    int64_t cutoff_ms = -1;
+    for (int64_t t = TEST_CHECK_PERIOD_MS; t <= 3 * TEST_TIMEOUT_MS; t += TEST_CHECK_PERIOD_MS)
+    {
+        if (t % TEST_CONTROL_PERIOD_MS == 0)
+        {
+            TEST_ASSERT_FALSE(heater_watchdog_feed(80.0f, 7));
+        }
+        if (check_at(t) && cutoff_ms < 0)
+        {
+            cutoff_ms = t;
+        }
+    }
+
+    TEST_ASSERT_TRUE(cutoff_ms > TEST_TIMEOUT_MS);
+    TEST_ASSERT_TRUE(cutoff_ms <= TEST_TIMEOUT_MS + TEST_CHECK_PERIOD_MS);
+    TEST_ASSERT_TRUE(heater_watchdog_tripped());
+    TEST_ASSERT_EQUAL_INT(1, s_trip_calls);
+
+    heater_watchdog_deinit();
+}
+
+void test_heater_watchdog_fault_latches_until_cleared(void)
+{
+    watchdog_setup(0);
+    TEST_ASSERT_TRUE(check_at(TEST_TIMEOUT_MS + 1));
+
+    // A late feed does not unlatch the fault
+    esp_timer_get_time_ExpectAndReturn((TEST_TIMEOUT_MS + 2) * 1000);
+    heater_watchdog_feed(40.0f, 1);
+    TEST_ASSERT_TRUE(check_at(TEST_TIMEOUT_MS + 3));
+
+    // Clearing restarts the deadline
+    esp_timer_get_time_ExpectAndReturn(20000 * 1000);
+    heater_watchdog_clear();
+    TEST_ASSERT_FALSE(heater_watchdog_tripped());
+    TEST_ASSERT_FALSE(check_at(20000 + TEST_TIMEOUT_MS));
+    TEST_ASSERT_TRUE(check_at(20000 + TEST_TIMEOUT_MS + 1));
+    TEST_ASSERT_EQUAL_INT(2, s_trip_calls);
+
+    // Disarmed watchdog never trips
+    heater_watchdog_deinit();
+    TEST_ASSERT_FALSE(heater_watchdog_check());
+    TEST_ASSERT_FALSE(heater_watchdog_feed(40.0f, 2));
+}
+
+// Test group runner for heater watchdog tests
+void test_heater_watchdog_group_runner(void)
+{
+    printf("Running heater watchdog tests...\n");
+    RUN_TEST(test_heater_watchdog_rejects_invalid_config);
+    RUN_TEST(test_heater_watchdog_healthy_loop_never_trips);
+    RUN_TEST(test_heater_watchdog_stalled_loop_cut_within_deadline);
+    RUN_TEST(test_heater_watchdog_invalid_feeds_do_not_count);
+    RUN_TEST(test_heater_watchdog_frozen_sample_trips);
+    RUN_TEST(test_heater_watchdog_fault_latches_until_cleared);
+    printf("Heater watchdog tests completed\n");
+}
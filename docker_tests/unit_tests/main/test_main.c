@@ -8,6 +8,21 @@ void test_temp(void);
 void test_version(void);
 void test_temperature(void);
 void test_controller_group_runner(void); // New: Controller test runner
+void test_drying_profile_group_runner(void);
+void test_controller_sim_group_runner(void);
+void test_controller_trace_group_runner(void);
+void test_heater_watchdog_group_runner(void);
+void test_fan_control_group_runner(void);
+void test_heater_energy_group_runner(void);
+void test_heater_modulation_group_runner(void);
+void test_power_limiter_group_runner(void);
+void test_subject_mailbox_group_runner(void);
+void test_telemetry_bus_group_runner(void);
+void test_needle_physics_group_runner(void);
+void test_frame_histogram_group_runner(void);
+void test_value_text_group_runner(void);
+void test_trend_plot_group_runner(void);
+void test_display_idle_group_runner(void);
 
 // Global setUp and tearDown functions for Unity
 void setUp(void) {
@@ -33,6 +48,21 @@ int main(int argc, char *argv[])
   test_version();
   test_temperature();
   test_controller_group_runner(); // New: Call controller tests
+  test_drying_profile_group_runner();
+  test_controller_sim_group_runner();
+  test_controller_trace_group_runner();
+  test_heater_watchdog_group_runner();
+  test_fan_control_group_runner();
+  test_heater_energy_group_runner();
+  test_heater_modulation_group_runner();
+  test_power_limiter_group_runner();
+  test_subject_mailbox_group_runner();
+  test_telemetry_bus_group_runner();
+  test_needle_physics_group_runner();
+  test_frame_histogram_group_runner();
+  test_value_text_group_runner();
+  test_trend_plot_group_runner();
+  test_display_idle_group_runner();
 
   return UNITY_END();
 }
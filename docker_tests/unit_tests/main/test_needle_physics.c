@@ -0,0 +1,81 @@
+#include <stdio.h>
+#include <math.h>
+#include "unity.h"
+#include "ui/needle_physics.h"
+
+#define TEST_DT_S 0.016f
+
+void test_needle_physics_settles_and_snaps(void)
+{
+  needle_model_t needle;
+  needle_model_init(&needle, 0.0f);
+  TEST_ASSERT_FALSE(needle_model_step(&needle, TEST_DT_S)); // At rest: nothing to do
+
+  needle_model_set_target(&needle, 100.0f);
+  int steps = 0;
+  float peak = 0.0f;
+  while (needle_model_step(&needle, TEST_DT_S) && steps < 1000)
+  {
+    peak = needle.position > peak ? needle.position : peak;
+    steps++;
+  }
+
+  // Underdamped, so it overshoots, but it comes to rest exactly on the target within a few seconds
+  TEST_ASSERT_GREATER_THAN_FLOAT(100.0f, peak);
+  TEST_ASSERT_LESS_THAN_INT(250, steps);
+  TEST_ASSERT_TRUE(needle.settled);
+  TEST_ASSERT_EQUAL_FLOAT(100.0f, needle.position);
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, needle.velocity);
+  TEST_ASSERT_FALSE(needle_model_step(&needle, TEST_DT_S));
+}
+
+void test_needle_physics_ignores_tiny_target_changes(void)
+{
+  needle_model_t needle;
+  needle_model_init(&needle, 42.0f);
+
+  // Sensor noise below the epsilon does not wake the needle
+  needle_model_set_target(&needle, 42.0f + NEEDLE_SETTLE_EPSILON / 2.0f);
+  TEST_ASSERT_TRUE(needle.settled);
+  TEST_ASSERT_FALSE(needle_model_step(&needle, TEST_DT_S));
+
+  needle_model_set_target(&needle, 43.0f);
+  TEST_ASSERT_FALSE(needle.settled);
+  TEST_ASSERT_TRUE(needle_model_step(&needle, TEST_DT_S));
+}
+
+// Position after stepping to t_s in equal steps of dt_s
+static float position_at(float t_s, float dt_s)
+{
+  needle_model_t needle;
+  needle_model_init(&needle, 0.0f);
+  needle_model_set_target(&needle, 80.0f);
+  for (int i = 0; i < (int)(t_s / dt_s + 0.5f); i++)
+  {
+    needle_model_step(&needle, dt_s);
+  }
+  return needle.position;
+}
+
+void test_needle_physics_frame_rate_independent(void)
+{
+  // 60, 30 and 20 fps trace the same curve
+  for (int i = 1; i <= 6; i++)
+  {
+    float t = i * 0.1f;
+    float reference = position_at(t, 1.0f / 60.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, reference, position_at(t, 1.0f / 30.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, reference, position_at(t, 1.0f / 20.0f));
+  }
+
+  // A long stall is clamped to one NEEDLE_MAX_DT_S step instead of teleporting the needle
+  TEST_ASSERT_EQUAL_FLOAT(position_at(NEEDLE_MAX_DT_S, NEEDLE_MAX_DT_S), position_at(2.0f, 2.0f));
+}
+
+void test_needle_physics_group_runner(void)
+{
+  RUN_TEST(test_needle_physics_settles_and_snaps);
+  RUN_TEST(test_needle_physics_ignores_tiny_target_changes);
+  RUN_TEST(test_needle_physics_frame_rate_independent);
+  printf("Needle physics tests completed\n");
+}
@@ -0,0 +1,70 @@
+#include <stdio.h>
+#include "unity.h"
+#include "power_limiter.h"
+#include "heater.h"
+
+#define TEST_WINDOW_S 60
+#define TEST_RUN_S 600
+
+static const power_limit_config_t TEST_LIMIT = {
+    .max_average = HEATER_DUTY_MAX / 2,
+    .peak = HEATER_DUTY_MAX,
+    .window_ms = TEST_WINDOW_S * 1000,
+};
+
+void test_power_limiter_held_request_stays_in_budget(void)
+{
+    // One full-power request, then re-applied every 1 s control period as heater_tick() does.
+    // The output holds each returned duty until the next call.
+    static uint32_t output[TEST_RUN_S];
+    power_limiter_t pl;
+    power_limiter_init(&pl, &TEST_LIMIT);
+
+    output[0] = power_limiter_apply(&pl, HEATER_DUTY_MAX, 0);
+    TEST_ASSERT_EQUAL_UINT32(HEATER_DUTY_MAX, output[0]); // Cold start: the full burst
+    for (int t = 1; t < TEST_RUN_S; t++)
+    {
+        output[t] = power_limiter_apply(&pl, pl.requested, (int64_t)t * 1000);
+    }
+    TEST_ASSERT_EQUAL_UINT32(HEATER_DUTY_MAX, pl.requested);
+    TEST_ASSERT_TRUE(pl.limiting);
+
+    // Rolling mean over the budget window, checked independently of the limiter's own bookkeeping
+    uint64_t window_sum = 0;
+    for (int t = 0; t < TEST_RUN_S; t++)
+    {
+        window_sum += output[t];
+        if (t >= TEST_WINDOW_S)
+        {
+            window_sum -= output[t - TEST_WINDOW_S];
+        }
+        if (t >= TEST_WINDOW_S - 1)
+        {
+            TEST_ASSERT_LESS_OR_EQUAL_UINT32(TEST_LIMIT.max_average, (uint32_t)(window_sum / TEST_WINDOW_S));
+        }
+    }
+
+    // The budget is used, not just respected
+    TEST_ASSERT_UINT32_WITHIN(TEST_LIMIT.max_average / 50, TEST_LIMIT.max_average, power_limiter_average(&pl));
+}
+
+void test_power_limiter_request_below_budget_untouched(void)
+{
+    power_limiter_t pl;
+    power_limiter_init(&pl, &TEST_LIMIT);
+
+    uint32_t duty = power_limiter_apply(&pl, TEST_LIMIT.max_average, 0);
+    for (int t = 1; t < TEST_RUN_S; t++)
+    {
+        duty = power_limiter_apply(&pl, pl.requested, (int64_t)t * 1000);
+        TEST_ASSERT_EQUAL_UINT32(TEST_LIMIT.max_average, duty);
+    }
+    TEST_ASSERT_FALSE(pl.limiting);
+}
+
+void test_power_limiter_group_runner(void)
+{
+    RUN_TEST(test_power_limiter_held_request_stays_in_budget);
+    RUN_TEST(test_power_limiter_request_below_budget_untouched);
+    printf("Power limiter tests completed\n");
+}
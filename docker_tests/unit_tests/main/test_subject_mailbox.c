@@ -0,0 +1,42 @@
+#include <stdio.h>
+#include "unity.h"
+#include "ui/subject_mailbox.h"
+
+void test_subject_mailbox_latest_value_wins(void)
+{
+    subject_slot_t slot = {0};
+    float value = 0.0f;
+
+    TEST_ASSERT_FALSE(subject_slot_take_float(&slot, &value));
+
+    // A burst between two frames collapses into one update carrying the newest value
+    TEST_ASSERT_FALSE(subject_slot_post_float(&slot, 41.5f));
+    TEST_ASSERT_TRUE(subject_slot_post_float(&slot, 42.0f)); // Overwrote a value nobody took
+    TEST_ASSERT_TRUE(subject_slot_post_float(&slot, -12.25f));
+    TEST_ASSERT_TRUE(subject_slot_take_float(&slot, &value));
+    TEST_ASSERT_EQUAL_FLOAT(-12.25f, value);
+    TEST_ASSERT_FALSE(subject_slot_take_float(&slot, &value));
+    TEST_ASSERT_EQUAL_FLOAT(-12.25f, value);
+}
+
+void test_subject_mailbox_int_values(void)
+{
+    subject_slot_t slot = {0};
+    int32_t value = 0;
+
+    subject_slot_post_int(&slot, -1); // "No profile running" must survive the round trip
+    TEST_ASSERT_TRUE(subject_slot_take_int(&slot, &value));
+    TEST_ASSERT_EQUAL_INT32(-1, value);
+
+    subject_slot_post_int(&slot, 86400);
+    TEST_ASSERT_TRUE(subject_slot_take_int(&slot, &value));
+    TEST_ASSERT_EQUAL_INT32(86400, value);
+    TEST_ASSERT_FALSE(subject_slot_take_int(&slot, &value));
+}
+
+void test_subject_mailbox_group_runner(void)
+{
+    RUN_TEST(test_subject_mailbox_latest_value_wins);
+    RUN_TEST(test_subject_mailbox_int_values);
+    printf("Subject mailbox tests completed\n");
+}
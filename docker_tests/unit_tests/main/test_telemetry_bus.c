@@ -0,0 +1,104 @@
+#include <stdio.h>
+#include "unity.h"
+#include "telemetry_bus.h"
+
+#include "Mockmock_esp_timer.h"
+
+typedef struct
+{
+    int calls;
+    float value;
+} recorder_t;
+
+static void record(telemetry_topic_t topic, float value, void *ctx)
+{
+    recorder_t *r = (recorder_t *)ctx;
+    r->calls++;
+    r->value = value;
+}
+
+static void publish_at(uint32_t now_us, telemetry_topic_t topic, float value)
+{
+    esp_timer_get_time_ExpectAndReturn(now_us);
+    telemetry_publish(topic, value);
+}
+
+static void dispatch_at(uint32_t now_us, telemetry_context_t context)
+{
+    esp_timer_get_time_ExpectAndReturn(now_us);
+    telemetry_dispatch(context);
+}
+
+void test_telemetry_bus_delivers_latest_once_per_subscriber(void)
+{
+    recorder_t ui_air = {0}, web_air = {0}, ui_heater = {0};
+    telemetry_topic_stats_t stats;
+    float latest;
+
+    telemetry_reset();
+    TEST_ASSERT_TRUE(telemetry_subscribe(TELEMETRY_TOPIC_AIR_TEMP, TELEMETRY_CONTEXT_LVGL, 0.0f, record, &ui_air));
+    TEST_ASSERT_TRUE(telemetry_subscribe(TELEMETRY_TOPIC_AIR_TEMP, TELEMETRY_CONTEXT_WEB, 0.0f, record, &web_air));
+    TEST_ASSERT_TRUE(telemetry_subscribe(TELEMETRY_TOPIC_HEATER_TEMP, TELEMETRY_CONTEXT_LVGL, 0.0f, record, &ui_heater));
+    TEST_ASSERT_FALSE(telemetry_get_latest(TELEMETRY_TOPIC_AIR_TEMP, &latest));
+
+    publish_at(1000, TELEMETRY_TOPIC_AIR_TEMP, 20.0f);
+    publish_at(2000, TELEMETRY_TOPIC_AIR_TEMP, 21.5f);
+    TEST_ASSERT_TRUE(telemetry_get_latest(TELEMETRY_TOPIC_AIR_TEMP, &latest));
+    TEST_ASSERT_EQUAL_FLOAT(21.5f, latest);
+    TEST_ASSERT_TRUE(telemetry_context_pending(TELEMETRY_CONTEXT_LVGL));
+    TEST_ASSERT_TRUE(telemetry_context_pending(TELEMETRY_CONTEXT_WEB));
+    TEST_ASSERT_FALSE(telemetry_context_pending(TELEMETRY_CONTEXT_CONTROL));
+
+    // Each context runs only its own subscribers, once, with the newest value
+    dispatch_at(5000, TELEMETRY_CONTEXT_LVGL);
+    TEST_ASSERT_EQUAL_INT(1, ui_air.calls);
+    TEST_ASSERT_EQUAL_FLOAT(21.5f, ui_air.value);
+    TEST_ASSERT_EQUAL_INT(0, ui_heater.calls);
+    TEST_ASSERT_EQUAL_INT(0, web_air.calls);
+    telemetry_dispatch(TELEMETRY_CONTEXT_LVGL); // Nothing pending: no clock read, no callbacks
+    TEST_ASSERT_EQUAL_INT(1, ui_air.calls);
+
+    dispatch_at(6000, TELEMETRY_CONTEXT_WEB);
+    TEST_ASSERT_EQUAL_INT(1, web_air.calls);
+    TEST_ASSERT_FALSE(telemetry_context_pending(TELEMETRY_CONTEXT_WEB));
+
+    telemetry_get_stats(TELEMETRY_TOPIC_AIR_TEMP, &stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.publishes);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.deliveries);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.coalesced); // 20.0 was replaced before either subscriber ran
+    TEST_ASSERT_EQUAL_UINT32(4000, stats.last_latency_us);
+    TEST_ASSERT_EQUAL_UINT32(4000, stats.max_latency_us);
+}
+
+void test_telemetry_bus_rate_limit_keeps_newest_value(void)
+{
+    recorder_t web = {0};
+
+    telemetry_reset();
+    TEST_ASSERT_FALSE(telemetry_subscribe(TELEMETRY_TOPIC_COUNT, TELEMETRY_CONTEXT_WEB, 1.0f, record, &web));
+    TEST_ASSERT_TRUE(telemetry_subscribe(TELEMETRY_TOPIC_HEATER_TEMP, TELEMETRY_CONTEXT_WEB, 1.0f, record, &web));
+
+    publish_at(0, TELEMETRY_TOPIC_HEATER_TEMP, 50.0f);
+    dispatch_at(100, TELEMETRY_CONTEXT_WEB);
+    TEST_ASSERT_EQUAL_INT(1, web.calls);
+
+    // Within the 1 s interval: held back, context stays pending
+    publish_at(200, TELEMETRY_TOPIC_HEATER_TEMP, 51.0f);
+    publish_at(300, TELEMETRY_TOPIC_HEATER_TEMP, 52.0f);
+    dispatch_at(500000, TELEMETRY_CONTEXT_WEB);
+    TEST_ASSERT_EQUAL_INT(1, web.calls);
+    TEST_ASSERT_TRUE(telemetry_context_pending(TELEMETRY_CONTEXT_WEB));
+
+    dispatch_at(1000100, TELEMETRY_CONTEXT_WEB);
+    TEST_ASSERT_EQUAL_INT(2, web.calls);
+    TEST_ASSERT_EQUAL_FLOAT(52.0f, web.value);
+    TEST_ASSERT_FALSE(telemetry_context_pending(TELEMETRY_CONTEXT_WEB));
+}
+
+void test_telemetry_bus_group_runner(void)
+{
+    RUN_TEST(test_telemetry_bus_delivers_latest_once_per_subscriber);
+    RUN_TEST(test_telemetry_bus_rate_limit_keeps_newest_value);
+    telemetry_reset();
+    printf("Telemetry bus tests completed\n");
+}
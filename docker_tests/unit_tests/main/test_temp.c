@@ -15,6 +15,7 @@
 #include "Mockmock_esp_adc.h"
 #include "Mockmock_esp_heap_caps.h"
 #include "Mockmock_sysmon_wrapper.h"
+#include "Mockmock_esp_timer.h"
 
 // Declare the function from temp.c (we'll include temp.c in the build but not in this header)
 extern steinhart_hart_coeffs_t calculate_steinhart_hart_coefficients(
@@ -174,6 +175,84 @@ void test_temp_sensor_get_reading(void)
   circular_buffer_free(&test_buffer);
 }
 
+/**
+ * @brief Test temp_sensor_read_ok, the check every control consumer goes through
+ */
+void test_temp_sensor_read_ok(void)
+{
+  float temperature = 42.0f;
+  TEST_ASSERT_FALSE(temp_sensor_read_ok(NULL, &temperature));
+  TEST_ASSERT_EQUAL_FLOAT(42.0f, temperature); // Untouched on failure
+
+  static uint8_t mock_buffer[5 * sizeof(temp_sample_t)];
+  circular_buffer_t test_buffer;
+  heap_caps_malloc_ExpectAndReturn(5 * sizeof(temp_sample_t), MALLOC_CAP_SPIRAM, mock_buffer);
+  xSemaphoreCreateMutex_ExpectAndReturn((SemaphoreHandle_t)0x3000);
+  TEST_ASSERT_TRUE(circular_buffer_init(&test_buffer, sizeof(temp_sample_t), 5));
+  struct temp_sensor_handle sensor = {.buffer = &test_buffer};
+  const int64_t read_us = 10000000; // Sample taken 10 s after boot
+
+  // A faulted reading is never handed out, even though a sample exists
+  temp_sample_t faulted = {.temperature = -999.0f, .status = TEMP_STATUS_OPEN_CIRCUIT, .time_us = read_us};
+  xSemaphoreTake_ExpectAndReturn(test_buffer.mutex, portMAX_DELAY, pdTRUE);
+  xSemaphoreGive_ExpectAndReturn(test_buffer.mutex, pdTRUE);
+  TEST_ASSERT_TRUE(circular_buffer_push(&test_buffer, &faulted));
+  xSemaphoreTake_ExpectAndReturn(test_buffer.mutex, portMAX_DELAY, pdTRUE);
+  xSemaphoreGive_ExpectAndReturn(test_buffer.mutex, pdTRUE);
+  TEST_ASSERT_FALSE(temp_sensor_read_ok(&sensor, &temperature));
+  TEST_ASSERT_EQUAL_FLOAT(42.0f, temperature);
+
+  temp_sample_t ok = {.temperature = 55.5f, .status = TEMP_STATUS_OK, .sequence = 3, .time_us = read_us};
+  xSemaphoreTake_ExpectAndReturn(test_buffer.mutex, portMAX_DELAY, pdTRUE);
+  xSemaphoreGive_ExpectAndReturn(test_buffer.mutex, pdTRUE);
+  TEST_ASSERT_TRUE(circular_buffer_push(&test_buffer, &ok));
+  xSemaphoreTake_ExpectAndReturn(test_buffer.mutex, portMAX_DELAY, pdTRUE);
+  xSemaphoreGive_ExpectAndReturn(test_buffer.mutex, pdTRUE);
+  esp_timer_get_time_ExpectAndReturn(read_us + TEMP_MAX_SAMPLE_AGE_MS * 1000);
+  TEST_ASSERT_TRUE(temp_sensor_read_ok(&sensor, &temperature));
+  TEST_ASSERT_EQUAL_FLOAT(55.5f, temperature);
+
+  // The same sample past the age limit means temp_task stopped: no reading, not the frozen value
+  temperature = 42.0f;
+  xSemaphoreTake_ExpectAndReturn(test_buffer.mutex, portMAX_DELAY, pdTRUE);
+  xSemaphoreGive_ExpectAndReturn(test_buffer.mutex, pdTRUE);
+  esp_timer_get_time_ExpectAndReturn(read_us + TEMP_MAX_SAMPLE_AGE_MS * 1000 + 1);
+  TEST_ASSERT_FALSE(temp_sensor_read_ok(&sensor, &temperature));
+  TEST_ASSERT_EQUAL_FLOAT(42.0f, temperature);
+
+  vSemaphoreDelete_Expect(test_buffer.mutex);
+  heap_caps_free_Expect(mock_buffer);
+  circular_buffer_free(&test_buffer);
+}
+
+/**
+ * @brief Test reading classification (open/short circuit, ADC error, implausible values)
+ */
+void test_temp_classify_reading(void)
+{
+  // Normal reading, with and without a previous one
+  TEST_ASSERT_EQUAL(TEMP_STATUS_OK, temp_classify_reading(2000.0f, 250, 45.0f, NAN));
+  TEST_ASSERT_EQUAL(TEMP_STATUS_OK, temp_classify_reading(2000.0f, 250, 45.0f, 44.0f));
+
+  // Circuit faults are recognised from the raw counts even when the conversion looks plausible
+  TEST_ASSERT_EQUAL(TEMP_STATUS_OPEN_CIRCUIT, temp_classify_reading(4095.0f, 250, 8.0f, 8.0f));
+  TEST_ASSERT_EQUAL(TEMP_STATUS_SHORT_CIRCUIT, temp_classify_reading(0.0f, 250, 140.0f, NAN));
+  TEST_ASSERT_EQUAL(TEMP_STATUS_ADC_ERROR, temp_classify_reading(0.0f, 0, -273.15f, NAN));
+
+  // Out of range or not a number
+  TEST_ASSERT_EQUAL(TEMP_STATUS_IMPLAUSIBLE, temp_classify_reading(2000.0f, 250, -273.15f, NAN));
+  TEST_ASSERT_EQUAL(TEMP_STATUS_IMPLAUSIBLE, temp_classify_reading(2000.0f, 250, 151.0f, NAN));
+  TEST_ASSERT_EQUAL(TEMP_STATUS_IMPLAUSIBLE, temp_classify_reading(2000.0f, 250, NAN, NAN));
+
+  // Jumps beyond the limit between consecutive readings
+  TEST_ASSERT_EQUAL(TEMP_STATUS_IMPLAUSIBLE,
+                    temp_classify_reading(2000.0f, 250, 45.0f + TEMP_MAX_JUMP_CELSIUS + 1.0f, 45.0f));
+  TEST_ASSERT_EQUAL(TEMP_STATUS_OK, temp_classify_reading(2000.0f, 250, 45.0f + TEMP_MAX_JUMP_CELSIUS, 45.0f));
+
+  TEST_ASSERT_EQUAL_STRING("open", temp_status_name(TEMP_STATUS_OPEN_CIRCUIT));
+  TEST_ASSERT_EQUAL_STRING("implausible", temp_status_name(TEMP_STATUS_IMPLAUSIBLE));
+}
+
 /**
  * @brief Test group runner
  */
@@ -181,7 +260,9 @@ void test_temp(void)
 {
   printf("Running temperature sensor tests...\n");
   RUN_TEST(test_calculate_steinhart_hart_coefficients);
+  RUN_TEST(test_temp_classify_reading);
   RUN_TEST(test_temp_sensor_get_reading); // Run this first to avoid global state issues
+  RUN_TEST(test_temp_sensor_read_ok);
   RUN_TEST(test_temp_sensor_init);
   printf("Temperature sensor tests completed\n");
 }
@@ -0,0 +1,88 @@
+#include <stdio.h>
+#include <math.h>
+#include "unity.h"
+#include "ui/trend_plot.h"
+
+#define W 8
+#define H 11
+#define STRIDE 10 // Padding past the width must never be touched
+
+static uint16_t s_pixels[H * STRIDE];
+
+static trend_plot_t plot_setup(void)
+{
+  trend_plot_t plot;
+  for (int i = 0; i < H * STRIDE; i++)
+  {
+    s_pixels[i] = 0xDEAD;
+  }
+  trend_plot_init(&plot, s_pixels, W, H, STRIDE, 0.0f, 100.0f);
+  plot.background = 0x0000;
+  plot.grid = 0x1111;
+  plot.grid_step = 50.0f;
+  trend_plot_add_series(&plot, 0xF800);
+  trend_plot_clear(&plot);
+  return plot;
+}
+
+static uint16_t px(int x, int y)
+{
+  return s_pixels[y * STRIDE + x];
+}
+
+void test_trend_plot_row_mapping(void)
+{
+  trend_plot_t plot = plot_setup();
+
+  TEST_ASSERT_EQUAL_INT16(10, trend_plot_row(&plot, 0.0f));
+  TEST_ASSERT_EQUAL_INT16(0, trend_plot_row(&plot, 100.0f));
+  TEST_ASSERT_EQUAL_INT16(5, trend_plot_row(&plot, 50.0f));
+  TEST_ASSERT_EQUAL_INT16(0, trend_plot_row(&plot, 250.0f)); // Clamped
+  TEST_ASSERT_EQUAL_INT16(10, trend_plot_row(&plot, -20.0f));
+  TEST_ASSERT_EQUAL_INT16(-1, trend_plot_row(&plot, NAN));
+  TEST_ASSERT_EQUAL_INT16(-1, trend_plot_row(&plot, -999.0f));
+
+  // Grid on 0, 50 and 100, background elsewhere, padding untouched
+  TEST_ASSERT_EQUAL_HEX16(0x1111, px(3, 5));
+  TEST_ASSERT_EQUAL_HEX16(0x1111, px(W - 1, 0));
+  TEST_ASSERT_EQUAL_HEX16(0x0000, px(3, 4));
+  TEST_ASSERT_EQUAL_HEX16(0xDEAD, px(W, 4));
+}
+
+void test_trend_plot_push_scrolls(void)
+{
+  trend_plot_t plot = plot_setup();
+
+  float value = 80.0f; // Row 2
+  trend_plot_push(&plot, &value);
+  TEST_ASSERT_EQUAL_HEX16(0xF800, px(W - 1, 2));
+
+  value = 40.0f; // Row 6: joined to row 2 in the new column
+  trend_plot_push(&plot, &value);
+  TEST_ASSERT_EQUAL_HEX16(0xF800, px(W - 2, 2)); // Previous point moved left
+  TEST_ASSERT_EQUAL_HEX16(0x0000, px(W - 2, 4));
+  for (int y = 2; y <= 6; y++)
+  {
+    TEST_ASSERT_EQUAL_HEX16(0xF800, px(W - 1, y));
+  }
+  TEST_ASSERT_EQUAL_HEX16(0x0000, px(W - 1, 7));
+
+  // A gap leaves only background and grid, and the next point starts fresh
+  value = NAN;
+  trend_plot_push(&plot, &value);
+  TEST_ASSERT_EQUAL_HEX16(0x0000, px(W - 1, 6));
+  TEST_ASSERT_EQUAL_HEX16(0x1111, px(W - 1, 5));
+  value = 0.0f;
+  trend_plot_push(&plot, &value);
+  TEST_ASSERT_EQUAL_HEX16(0xF800, px(W - 1, 10));
+  TEST_ASSERT_EQUAL_HEX16(0x0000, px(W - 1, 9));
+
+  TEST_ASSERT_EQUAL_HEX16(0xDEAD, px(W, 2));
+}
+
+void test_trend_plot_group_runner(void)
+{
+  RUN_TEST(test_trend_plot_row_mapping);
+  RUN_TEST(test_trend_plot_push_scrolls);
+  printf("Trend plot tests completed\n");
+}
@@ -0,0 +1,44 @@
+#include <stdio.h>
+#include <math.h>
+#include "unity.h"
+#include "ui/value_text.h"
+
+void test_value_text_quantize(void)
+{
+  // Values that display the same digits quantize to the same integer
+  TEST_ASSERT_EQUAL_INT32(235, value_text_quantize(23.46f, 1.0f, 1));
+  TEST_ASSERT_EQUAL_INT32(235, value_text_quantize(23.54f, 1.0f, 1));
+  TEST_ASSERT_EQUAL_INT32(165, value_text_quantize(1.6512f, 1.0f, 2));
+  TEST_ASSERT_EQUAL_INT32(102, value_text_quantize(10240.0f, 0.001f, 1)); // Ohms shown as kilo-ohms
+  TEST_ASSERT_EQUAL_INT32(-5, value_text_quantize(-0.5f, 1.0f, 1));
+
+  TEST_ASSERT_EQUAL_INT32(VALUE_TEXT_INVALID, value_text_quantize(-999.0f, 1.0f, 1));
+  TEST_ASSERT_EQUAL_INT32(VALUE_TEXT_INVALID, value_text_quantize(NAN, 1.0f, 1));
+}
+
+void test_value_text_format(void)
+{
+  char buf[32];
+
+  value_text_format(buf, sizeof(buf), 235, 1, NULL, "\xC2\xB0" "C");
+  TEST_ASSERT_EQUAL_STRING("23.5\xC2\xB0" "C", buf);
+
+  value_text_format(buf, sizeof(buf), 105, 2, NULL, "V");
+  TEST_ASSERT_EQUAL_STRING("1.05V", buf);
+
+  value_text_format(buf, sizeof(buf), -5, 1, "T ", NULL);
+  TEST_ASSERT_EQUAL_STRING("T -0.5", buf);
+
+  value_text_format(buf, sizeof(buf), 42, 0, NULL, "%");
+  TEST_ASSERT_EQUAL_STRING("42%", buf);
+
+  value_text_format(buf, sizeof(buf), VALUE_TEXT_INVALID, 1, NULL, "k");
+  TEST_ASSERT_EQUAL_STRING("--k", buf);
+}
+
+void test_value_text_group_runner(void)
+{
+  RUN_TEST(test_value_text_quantize);
+  RUN_TEST(test_value_text_format);
+  printf("Value text tests completed\n");
+}
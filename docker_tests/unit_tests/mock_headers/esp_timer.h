@@ -0,0 +1,4 @@
+#pragma once
+
+// Include our mock ESP timer header
+#include "mock_esp_timer.h"
@@ -0,0 +1,6 @@
+#pragma once
+
+#include <stdint.h>
+
+// Mock ESP timer function (will be mocked by CMock)
+int64_t esp_timer_get_time(void);
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <stdint.h>
+
+// Fan driver runtime functions (fan_init() needs the LEDC/PCNT drivers and is not mocked)
+void fan_set_duty(uint8_t percent);
+uint8_t fan_get_duty(void);
+uint32_t fan_read_tach_pulses(void);
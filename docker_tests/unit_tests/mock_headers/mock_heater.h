@@ -3,4 +3,9 @@
 #include <stdint.h>
 
 void heater_init(void);
-void set_heat_power(uint8_t power);
\ No newline at end of file
+void set_heat_power(uint8_t power);
+void heater_force_off(void);
+void heater_clear_force_off(void);
+void heater_set_duty(uint32_t duty);
+uint32_t heater_get_duty(void);
+void heater_set_fade_time(uint32_t fade_ms);
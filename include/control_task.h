@@ -0,0 +1,105 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "drying_profile.h"
+#include "heater_energy.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// Control loop task configuration
+#define CONTROL_TASK_STACK_SIZE 4096
+#define CONTROL_TASK_PRIORITY 3 // Above temp_task so control is not starved by sampling
+#define CONTROL_PERIOD_MS 1000  // Matches TEMP_READ_INTERVAL_MS; faster gains nothing
+#define CONTROL_WATCHDOG_TIMEOUT_MS 5000   // Heater cut after 5 control periods without a valid update
+#define CONTROL_WATCHDOG_CHECK_MS 250      // Watchdog timer period; cutoff within timeout + this
+
+// Default controller parameters for the dryer enclosure
+#define CONTROL_MAX_HEATER_TEMP 100.0f
+#define CONTROL_AIR_TEMP_HYSTERESIS 1.0f
+#define CONTROL_HEATER_TEMP_HYSTERESIS 2.0f
+#define CONTROL_FULL_POWER_DELTA 5.0f
+#define CONTROL_RAMP_RATE 2.0f  // Reference rise limit (C/min), matches the built-in profile ramps
+#define CONTROL_RAMP_ACCEL 4.0f // S-curve shaping (C/min^2): full rate after 30 s
+#define CONTROL_AUTOTUNE_SETPOINTS {40.0f, 60.0f, 80.0f} // Spans PLA to Nylon drying temperatures
+#define CONTROL_RUNAWAY_WINDOW_S 60.0f     // Thermal protection window
+#define CONTROL_RUNAWAY_MIN_RISE 2.0f      // Element must gain at least this much over the first window of a full-power run
+#define CONTROL_RUNAWAY_IDLE_MAX_RISE 5.0f // Allows for sensor lag after the heater is switched off
+
+// Enclosure fan (CONFIG_ENABLE_FAN)
+#define CONTROL_FAN_RPM 2000              // Airflow while a profile or auto-tune runs
+#define CONTROL_FAN_MAX_RPM 3000          // Fan speed at 100% duty
+#define CONTROL_FAN_MIN_DUTY 20           // Below this most fans stop
+#define CONTROL_FAN_KP 0.01f              // % duty per RPM of error
+#define CONTROL_FAN_KI 0.005f             // % duty per RPM of error per second
+#define CONTROL_FAN_STALL_RPM 300         // Driven fan slower than this counts as not turning
+#define CONTROL_FAN_STALL_TIME_MS 3000    // Stall declared after 3 control periods below CONTROL_FAN_STALL_RPM
+#define CONTROL_FAN_SPINUP_MS 3000        // Spin-up grace when starting from rest
+#define CONTROL_FAN_COOLDOWN_TEMP 45.0f   // Fan keeps running until the heater element is below this
+
+// g_subject_heater_fault codes
+#define CONTROL_FAULT_NONE 0
+#define CONTROL_FAULT_WATCHDOG 1       // Control loop stalled, heater cut by the watchdog
+#define CONTROL_FAULT_HEATING_FAILED 2 // Heater not heating at full power (sensor detached or heater dead)
+#define CONTROL_FAULT_RUNAWAY 3        // Heater heating with the output off
+#define CONTROL_FAULT_FAN_STALLED 4    // Fan driven but not turning, heater held off until it recovers
+
+  /** @brief Snapshot of the running drying profile. */
+  typedef struct
+  {
+    bool running;                // True while a profile is executing
+    char name[PROFILE_NAME_MAX]; // Name of the running (or last) profile
+    uint8_t step;                // Index of the current step
+    uint8_t step_count;          // Number of steps in the profile
+    float setpoint;              // Current ramped setpoint
+    uint32_t remaining_s;        // Estimated remaining time in seconds
+  } profile_status_t;
+
+  /**
+   * @brief Initializes the controller (inactive) and starts the periodic control task
+   * The task reads both sensors, advances the active drying profile and runs the controller.
+   * @return ESP_OK on success, ESP_FAIL if the task could not be created
+   */
+  esp_err_t control_task_start(void);
+
+  /**
+   * @brief Starts a drying profile, replacing any profile that is already running
+   * Also clears a latched heater watchdog or thermal protection fault.
+   * @param profile Profile to run (copied)
+   * @return ESP_OK on success, ESP_ERR_INVALID_ARG for an empty profile
+   */
+  esp_err_t control_start_profile(const drying_profile_t *profile);
+
+  /**
+   * @brief Stops the running drying profile or auto-tune and turns the heater off
+   */
+  void control_stop_profile(void);
+
+  /**
+   * @brief Stops any running profile and auto-tunes the controller at CONTROL_AUTOTUNE_SETPOINTS
+   * The resulting gain schedule is saved to NVS when tuning completes.
+   * @return ESP_OK if tuning started, ESP_FAIL otherwise
+   */
+  esp_err_t control_start_autotune(void);
+
+  /**
+   * @brief Gets the status of the drying profile
+   * @param[out] status Status to fill
+   */
+  void control_get_profile_status(profile_status_t *status);
+
+  /**
+   * @brief Gets the energy summary of the running drying session
+   * Finished sessions are persisted, see energy_session_load().
+   * @param[out] session Summary to fill
+   * @return true if a session is running, false otherwise (session untouched)
+   */
+  bool control_get_energy_session(energy_session_t *session);
+
+#ifdef __cplusplus
+}
+#endif
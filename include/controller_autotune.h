@@ -0,0 +1,80 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "heater_controller.h"
+
+#define AUTOTUNE_RELAY_HYSTERESIS 0.5f // Relay switching band around each setpoint (C)
+#define AUTOTUNE_RELAY_CYCLES 3        // Oscillation cycles measured per setpoint
+#define AUTOTUNE_TARGET_SWING 1.5f     // Air deviation from the setpoint the tuned band aims for (C)
+#define AUTOTUNE_TIMEOUT_S 7200.0f     // Give up if one setpoint takes longer than this
+
+/** @brief Progress of an auto-tune run. */
+typedef enum
+{
+    AUTOTUNE_IDLE,
+    AUTOTUNE_HEATING, // Full power up to the setpoint, then measuring how far the air coasts
+    AUTOTUNE_RELAY,   // Relay oscillation around the setpoint
+    AUTOTUNE_DONE,    // All setpoints tuned, result is valid
+    AUTOTUNE_FAILED,  // Timed out
+} autotune_phase_t;
+
+/**
+ * @brief Relay auto-tuner producing one gain schedule entry per setpoint.
+ *
+ * At each setpoint the heater is run at full power until the air reaches the setpoint,
+ * the coast (air overshoot after power is cut) is measured, then the heater is switched
+ * as a relay around the setpoint for AUTOTUNE_RELAY_CYCLES cycles while the thermal lag
+ * (air overshoot/undershoot past the relay band) and duty cycle are recorded.
+ */
+typedef struct
+{
+    autotune_phase_t phase;
+    float setpoints[CONTROLLER_SCHEDULE_MAX_POINTS];
+    uint8_t count;         // Number of setpoints to tune
+    uint8_t index;         // Setpoint being tuned
+    float elapsed_s;       // Time spent on the current setpoint
+    bool heater_on;        // Current relay output
+    bool coasting;         // Power cut during HEATING, tracking the coast peak
+    float coast_start;     // Air temp when full power was cut
+    float coast_peak;      // Highest air temp seen while coasting
+    float coast;           // Measured coast (C)
+    uint8_t cycles;        // Completed relay cycles
+    float air_min;         // Lowest air temp of the current on half-cycle
+    float air_max;         // Highest air temp of the current off half-cycle
+    float overshoot_sum;   // Sum of air excursions above the relay band
+    float undershoot_sum;  // Sum of air excursions below the relay band
+    uint8_t overshoot_n;
+    uint8_t undershoot_n;
+    float on_time_s;       // Heater-on time during the relay phase
+    float relay_time_s;    // Total relay phase time
+    controller_gain_schedule_t result; // Tuned schedule, valid once phase is AUTOTUNE_DONE
+} autotune_t;
+
+/**
+ * @brief Starts a tuning run.
+ * @param at Tuner state.
+ * @param setpoints Setpoints to tune at, ascending.
+ * @param count Number of setpoints (1 to CONTROLLER_SCHEDULE_MAX_POINTS).
+ * @return true if started, false for an invalid setpoint list.
+ */
+bool autotune_start(autotune_t *at, const float *setpoints, uint8_t count);
+
+/**
+ * @brief Advances the tuner by one control period.
+ * @param at Tuner state.
+ * @param air_temp Current air temperature.
+ * @param dt_s Time since the previous step in seconds.
+ * @return Heater power to apply, 0-255 (always 0 once done or failed).
+ */
+uint8_t autotune_step(autotune_t *at, float air_temp, float dt_s);
+
+/**
+ * @brief Derives schedule parameters from relay measurements.
+ * @param setpoint Setpoint the measurements were taken at.
+ * @param coast Air overshoot after cutting full power (C).
+ * @param lag Mean air excursion past the relay band (C).
+ * @param duty Heater duty cycle needed to hold the setpoint (0-1).
+ * @param[out] point Resulting schedule entry.
+ */
+void autotune_compute_point(float setpoint, float coast, float lag, float duty, controller_schedule_point_t *point);
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "esp_err.h"
+#include "heater_controller.h"
+
+#define CONTROLLER_NVS_NAMESPACE "controller"
+#define CONTROLLER_NVS_KEY "schedule"
+#define CONTROLLER_SCHEDULE_VERSION 1 // Bump when controller_gain_schedule_t changes layout
+
+/**
+ * @brief Loads the auto-tuned gain schedule from NVS.
+ * @note Only the schedule is persisted; safety limits and the other controller
+ *       parameters always come from the firmware.
+ * @note NVS must already be initialized (done by wifi_init()).
+ * @param[out] schedule Schedule to fill; untouched on failure.
+ * @return ESP_OK on success, ESP_ERR_NVS_NOT_FOUND if nothing is stored,
+ *         ESP_ERR_INVALID_VERSION if the stored layout is outdated,
+ *         ESP_ERR_INVALID_STATE if the stored schedule is not usable.
+ */
+esp_err_t controller_schedule_load(controller_gain_schedule_t *schedule);
+
+/**
+ * @brief Persists the gain schedule to NVS.
+ * @param schedule Schedule to store.
+ * @return ESP_OK on success, or the NVS error.
+ */
+esp_err_t controller_schedule_save(const controller_gain_schedule_t *schedule);
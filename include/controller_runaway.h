@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "heater_controller.h"
+
+#define RUNAWAY_MAX_SAMPLES 120 // Longest window in control cycles (2 min at 1 Hz)
+
+/**
+ * @brief Rate-based thermal protection over a sliding window of control cycles.
+ *
+ * Each cycle records the heater temperature together with the power that was applied while it
+ * developed. Both checks are O(1) per cycle:
+ * - heating failed: a watch is armed when a full-power run starts, and again when the reading falls
+ *   more than runaway_min_rise below the run's peak (sensor detached, element died). If the first
+ *   window of the watch is all at full power and rises less than runaway_min_rise, the heater is not
+ *   heating. Once a watch passes, a flat reading at full power is the element's equilibrium (weak
+ *   element, strong airflow) and is left to the max_heater_temp limit.
+ * - runaway: every entry at zero power and the rise across the window above runaway_idle_max_rise.
+ */
+typedef struct
+{
+    float temps[RUNAWAY_MAX_SAMPLES];   // Heater temperature per cycle
+    uint8_t powers[RUNAWAY_MAX_SAMPLES]; // Power in effect during the interval ending at that sample
+    uint16_t window;           // Window length in samples (0 = disabled)
+    uint16_t head;             // Next slot to write
+    uint16_t count;            // Valid samples, up to window
+    uint16_t zero_power_count; // Samples in the window at power 0
+    uint16_t watch;            // Full-power samples into the armed heating watch, 0 = not watching
+    bool in_full_power_run;    // Previous sample was at power 255
+    float run_peak;            // Highest reading since the full-power run (or last re-arm) began
+} runaway_monitor_t;
+
+/**
+ * @brief Sizes the window from the configuration and clears it.
+ * @param m Monitor state.
+ * @param config Controller configuration (runaway_* fields and control_period_s).
+ */
+void runaway_reset(runaway_monitor_t *m, const controller_config_t *config);
+
+/**
+ * @brief Adds one control cycle and evaluates the window.
+ * @param m Monitor state.
+ * @param config Controller configuration with the rise thresholds.
+ * @param heater_temp Heater temperature measured this cycle.
+ * @param power Power that was applied since the previous cycle.
+ * @return Detected fault, CONTROLLER_FAULT_NONE while the heater behaves.
+ */
+controller_fault_t runaway_update(runaway_monitor_t *m, const controller_config_t *config, float heater_temp, uint8_t power);
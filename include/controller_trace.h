@@ -0,0 +1,112 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define CONTROLLER_TRACE_CAPACITY 16384 // Records, power of two: ~4.5 h at 1 Hz, 256 KB of PSRAM
+#define CONTROLLER_TRACE_MAGIC 0x43525443 // "CTRC" little-endian, starts the HTTP export
+#define CONTROLLER_TRACE_VERSION 1
+
+// controller_trace_record_t.flags layout
+#define CONTROLLER_TRACE_STATE_MASK 0x03      // controller_state_t
+#define CONTROLLER_TRACE_FLAG_OVERRIDE 0x04   // Heater safety override latched
+#define CONTROLLER_TRACE_FLAG_ACTIVE 0x08     // Controller active
+#define CONTROLLER_TRACE_FLAG_AUTOTUNE 0x10   // Auto-tune owns the heater
+#define CONTROLLER_TRACE_ZONE_SHIFT 5         // Bits 5-6: controller instance index
+#define CONTROLLER_TRACE_ZONE_MASK 0x60
+#define CONTROLLER_TRACE_FLAG_FAULT 0x80      // Thermal protection fault latched
+
+/** @brief One controller cycle, 16 bytes. Temperatures are in 0.1 C. */
+typedef struct
+{
+    uint32_t timestamp_ms; // Milliseconds since boot
+    int16_t heater_temp;   // Heater element temperature (0.1 C)
+    int16_t air_temp;      // Air temperature (0.1 C)
+    int16_t reference;     // Setpoint tracked this cycle (0.1 C)
+    uint8_t power;         // Commanded heater power 0-255
+    uint8_t flags;         // CONTROLLER_TRACE_* bits
+    uint16_t loop_us;      // controller_run() duration, saturates at 65535
+    uint16_t sequence;     // Low 16 bits of the record number, detects gaps when decoding
+} controller_trace_record_t;
+
+_Static_assert(sizeof(controller_trace_record_t) == 16, "trace record must stay 16 bytes");
+
+/** @brief Header sent ahead of the records by the HTTP export. */
+typedef struct
+{
+    uint32_t magic;       // CONTROLLER_TRACE_MAGIC
+    uint16_t version;     // CONTROLLER_TRACE_VERSION
+    uint16_t record_size; // sizeof(controller_trace_record_t)
+    uint32_t count;       // Records that follow, oldest first
+    uint32_t dropped;     // Older records overwritten since boot
+} controller_trace_header_t;
+
+/**
+ * @brief Allocates the trace ring in PSRAM and enables recording.
+ * @return true on success, false if the allocation failed (recording stays disabled).
+ */
+bool controller_trace_init(void);
+
+/** @brief Disables recording and frees the ring. */
+void controller_trace_deinit(void);
+
+/**
+ * @brief Tells whether recording is enabled.
+ * @return true once controller_trace_init() succeeded.
+ */
+bool controller_trace_enabled(void);
+
+/**
+ * @brief Time source for trace timestamps and loop durations.
+ * @return Microseconds since boot.
+ */
+int64_t controller_trace_now_us(void);
+
+/**
+ * @brief Appends a record, overwriting the oldest one when full.
+ * @note Lock-free and allocation-free; safe to call every control cycle. The sequence
+ *       field is filled in here.
+ * @param record Record to append.
+ */
+void controller_trace_record(const controller_trace_record_t *record);
+
+/**
+ * @brief Number of records currently held (at most CONTROLLER_TRACE_CAPACITY).
+ * @return Record count.
+ */
+size_t controller_trace_count(void);
+
+/**
+ * @brief Total number of records written since init.
+ * @return Records written, including overwritten ones.
+ */
+uint32_t controller_trace_total(void);
+
+/**
+ * @brief Copies held records, oldest first.
+ * @param offset Index of the first record to copy (0 = oldest held).
+ * @param[out] out Destination array.
+ * @param max Capacity of the destination array.
+ * @return Number of records copied.
+ */
+size_t controller_trace_read(size_t offset, controller_trace_record_t *out, size_t max);
+
+/**
+ * @brief Converts a temperature to the trace's 0.1 C fixed point, saturating.
+ * @param celsius Temperature in C.
+ * @return Temperature in 0.1 C.
+ */
+static inline int16_t controller_trace_temp(float celsius)
+{
+    float scaled = celsius * 10.0f;
+    if (scaled >= 32767.0f)
+    {
+        return INT16_MAX;
+    }
+    if (scaled <= -32768.0f)
+    {
+        return INT16_MIN;
+    }
+    return (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+}
@@ -1,20 +1,40 @@
 #pragma once
 
+#include <stdint.h>
+#include <stdbool.h>
+#include "frame_histogram.h"
+
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
+  /** Display profiler results, accumulated since the last fps_monitor_reset() */
+  typedef struct
+  {
+    frame_histogram_t render_us;   // CPU time drawing each frame
+    frame_histogram_t flush_us;    // Time per frame in the flush callback or waiting for the bus
+    frame_histogram_t interval_us; // Time between the starts of consecutive rendered frames
+    frame_histogram_t area_px;     // Pixels redrawn per frame (invalidated areas after merging)
+    uint32_t frames;               // Frames rendered
+    uint32_t fps;                  // Frames per second over the last complete 1 s window
+    int64_t last_frame_us;         // esp_timer time of the last rendered frame
+  } display_profile_t;
+
   void print_memory_info(void);
   void print_fps_info(void);
 
   // FPS monitoring functions
   void fps_monitor_start(void);
   void fps_monitor_stop(void);
+  bool fps_monitor_is_running(void);
   uint32_t fps_monitor_get_fps(void);
   void fps_monitor_reset(void);
   void fps_monitor_setup_callback(void *disp);
 
+  /** Copies the profile; safe to call from any task. */
+  void fps_monitor_get_profile(display_profile_t *profile);
+
 #ifdef __cplusplus
 }
 #endif
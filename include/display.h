@@ -1,12 +1,52 @@
 #pragma once
 
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "lvgl.h"
+
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
+  /** LVGL draw buffer strategies (see DISPLAY_BUFFER_MODE in Kconfig) */
+  typedef enum
+  {
+    DISPLAY_BUFFER_SINGLE,     // One stripe buffer, rendering waits for every flush
+    DISPLAY_BUFFER_DMA_DOUBLE, // Two stripe buffers in internal DMA RAM, render and flush overlap
+    DISPLAY_BUFFER_PSRAM_FULL, // Two full-frame buffers in PSRAM, full_refresh
+  } display_buffer_mode_t;
+
+  typedef struct
+  {
+    display_buffer_mode_t mode;
+    uint16_t lines; // Stripe height; ignored for DISPLAY_BUFFER_PSRAM_FULL
+  } display_buffer_config_t;
+
   void init_display(void);
 
+  /**
+   * Replaces the LVGL display with one using a different draw buffer strategy.
+   * All screens of the old display are deleted, so only call it before the UI is built.
+   * If the new buffers cannot be allocated the previous strategy is restored.
+   * @return The new display, or NULL if the configuration failed.
+   */
+  lv_display_t *display_set_buffering(const display_buffer_config_t *config);
+
+  /** Buffering the display was configured with in menuconfig. */
+  void display_get_default_buffering(display_buffer_config_t *config);
+
+  /** Total draw buffer memory a configuration allocates, in bytes. */
+  size_t display_buffer_bytes(const display_buffer_config_t *config);
+
+  /** Sets the backlight brightness, 0-100 %. Only 0 and non-zero differ if the PWM is unavailable. */
+  esp_err_t display_set_backlight(uint8_t percent);
+
+  /** Turns the panel output on or off; its memory keeps the image. */
+  esp_err_t display_set_panel_on(bool on);
+
   // FPS monitoring functions
   void fps_monitor_start(void);
   void fps_monitor_stop(void);
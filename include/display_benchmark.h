@@ -0,0 +1,41 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "display.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define DISPLAY_BENCHMARK_MAX_RESULTS 16 // Buffer configurations x scenes
+
+  /** Measurements for one buffer configuration rendering one scene */
+  typedef struct
+  {
+    display_buffer_config_t buffering;
+    const char *scene;      // "full" (whole screen invalidated every frame) or "partial" (one moving box)
+    bool ok;                // false if the buffers could not be allocated
+    size_t buffer_bytes;    // Draw buffer memory of the configuration
+    uint32_t frames;        // Frames rendered during the measurement
+    float fps;              // Achieved frames per second
+    uint32_t render_us;     // Average CPU time per frame spent drawing
+    uint32_t flush_us;      // Average time per frame in the flush callback or waiting for the bus
+    uint32_t render_us_p95; // 95th percentile of the drawing time (histogram bucket bound)
+  } display_benchmark_result_t;
+
+  /**
+   * Renders each benchmark scene with each draw buffer strategy and logs a result table.
+   * The LVGL display is recreated for every configuration, so this must run before the UI is
+   * built; the menuconfig strategy is restored at the end. Blocks for about 25 s.
+   * @param results Optional array receiving the measurements, may be NULL.
+   * @param max_results Capacity of results.
+   * @return Number of measurements taken.
+   */
+  size_t display_benchmark_run(display_benchmark_result_t *results, size_t max_results);
+
+#ifdef __cplusplus
+}
+#endif
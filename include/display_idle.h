@@ -0,0 +1,46 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Backlight level by time since the last user-relevant activity. */
+typedef enum
+{
+    DISPLAY_IDLE_ACTIVE, // Full brightness
+    DISPLAY_IDLE_DIM,    // Backlight dimmed
+    DISPLAY_IDLE_SLEEP,  // Backlight and panel off
+    DISPLAY_IDLE_STATE_COUNT
+} display_idle_state_t;
+
+/** @brief How often LVGL refreshes the display. */
+typedef enum
+{
+    DISPLAY_RENDER_FULL_RATE, // Default refresh period
+    DISPLAY_RENDER_THROTTLED, // Long refresh period: nothing has changed on screen for a while
+    DISPLAY_RENDER_PAUSED,    // No refresh at all; invalidated areas wait for the wake-up
+    DISPLAY_RENDER_MODE_COUNT
+} display_render_mode_t;
+
+typedef struct
+{
+    uint32_t dim_after_ms;      // Inactivity before dimming (0 = never)
+    uint32_t sleep_after_ms;    // Inactivity before turning the panel off (0 = never)
+    uint32_t throttle_after_ms; // Time without screen changes before the refresh period is raised
+} display_idle_config_t;
+
+/**
+ * @brief Backlight state for a given inactivity time.
+ * @param config Thresholds.
+ * @param idle_ms Time since the last wake-up.
+ */
+display_idle_state_t display_idle_state(const display_idle_config_t *config, uint32_t idle_ms);
+
+/**
+ * @brief Refresh mode for the current state.
+ * @param config Thresholds.
+ * @param state Backlight state from display_idle_state().
+ * @param quiet_ms Time since anything on screen was last invalidated.
+ * @param animating true while LVGL animations are running.
+ */
+display_render_mode_t display_idle_render_mode(const display_idle_config_t *config, display_idle_state_t state,
+                                               uint32_t quiet_ms, bool animating);
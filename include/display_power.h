@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stdint.h>
+#include "display_idle.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  /** Where the time went since display_power_start(), from the FreeRTOS run-time stats */
+  typedef struct
+  {
+    display_idle_state_t state;                         // Current backlight state
+    display_render_mode_t render_mode;                  // Current refresh mode
+    uint64_t time_us[DISPLAY_RENDER_MODE_COUNT];        // Wall time spent in each refresh mode
+    uint64_t lvgl_run_us[DISPLAY_RENDER_MODE_COUNT];    // LVGL task CPU time in each refresh mode
+    uint32_t wakes;                                     // Wake-ups from dimmed or off
+  } display_power_stats_t;
+
+  /**
+   * Starts the display power manager: dims the backlight, raises the LVGL refresh period while
+   * nothing changes on screen and turns the panel off with rendering paused after longer
+   * inactivity (see the DISPLAY_* options in menuconfig). Call once after the UI is built.
+   */
+  void display_power_start(void);
+
+  /**
+   * Restarts the inactivity timeout and wakes the display. Safe from any task; the display
+   * follows within one poll period (100 ms). Button presses, heater faults and new web
+   * connections already count as activity.
+   */
+  void display_power_wake(void);
+
+  /** Copies the statistics; safe to call from any task. */
+  void display_power_get_stats(display_power_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define PROFILE_NAME_MAX 16       // Max profile name length including NUL terminator
+#define PROFILE_MAX_STEPS 8       // Max number of steps in a single profile
+#define PROFILE_TEXT_MAX 512      // Max size of a profile in its text (CSV) form
+#define PROFILE_REACHED_BAND 1.0f // Air temp within this band of the setpoint counts as reached
+
+// Limits on parsed (uploaded) steps
+#define PROFILE_SETPOINT_MIN 0.0f          // Below ambient the heater just stays off
+#define PROFILE_SETPOINT_MAX 90.0f         // Air setpoint; the element runs hotter, up to CONTROL_MAX_HEATER_TEMP
+#define PROFILE_RAMP_RATE_MAX 10.0f        // C/min, well above what the element can deliver
+#define PROFILE_DURATION_MAX_MIN (72 * 60) // Three days
+
+/** @brief Condition that ends a profile step. */
+typedef enum
+{
+    PROFILE_EXIT_DURATION,     // Step ends after duration_s once the ramp has finished
+    PROFILE_EXIT_TEMP_REACHED, // Step ends when air temp reaches the setpoint (duration_s is a timeout, 0 = none)
+    PROFILE_EXIT_HOLD,         // Step never ends (e.g. storage hold); profile runs until stopped
+} profile_exit_t;
+
+/** @brief A single step of a drying profile. */
+typedef struct
+{
+    float setpoint;       // Target air temperature for this step (C)
+    float ramp_rate;      // Max setpoint change rate when entering the step (C/min), 0 = jump
+    uint32_t duration_s;  // Step duration in seconds (meaning depends on exit condition)
+    profile_exit_t exit;  // Condition that ends the step
+} profile_step_t;
+
+/** @brief A named, table-driven drying recipe. */
+typedef struct
+{
+    char name[PROFILE_NAME_MAX];
+    uint8_t step_count;
+    profile_step_t steps[PROFILE_MAX_STEPS];
+} drying_profile_t;
+
+/** @brief Execution state of a profile runner. */
+typedef struct
+{
+    drying_profile_t profile; // Copy of the profile being executed
+    bool running;             // True while a profile is executing
+    uint8_t step;             // Index of the current step
+    float setpoint;           // Current (ramped) setpoint handed to the controller
+    float step_origin;        // Setpoint when the current step was entered (ramp start)
+    bool ramp_done;           // True once the setpoint has reached the step's target
+    uint32_t step_start_s;    // Time the current step was entered
+    uint32_t soak_start_s;    // Time the ramp finished (start of the soak/duration phase)
+    uint32_t last_tick_s;     // Time of the previous tick, used to integrate the ramp
+} profile_runner_t;
+
+/**
+ * @brief Returns the number of built-in filament profiles.
+ * @return Count of built-in profiles.
+ */
+size_t profile_builtin_count(void);
+
+/**
+ * @brief Returns a built-in profile by index.
+ * @param index Index from 0 to profile_builtin_count() - 1.
+ * @return Pointer to the profile, or NULL if index is out of range.
+ */
+const drying_profile_t *profile_builtin_get(size_t index);
+
+/**
+ * @brief Looks up a built-in profile by name (case-insensitive).
+ * @param name Profile name, e.g. "PLA".
+ * @return Pointer to the profile, or NULL if not found.
+ */
+const drying_profile_t *profile_builtin_find(const char *name);
+
+/**
+ * @brief Checks that a profile name only uses [A-Za-z0-9_-] and fits PROFILE_NAME_MAX.
+ * @param name Name to validate.
+ * @return true if the name is usable as a profile/file name.
+ */
+bool profile_name_is_valid(const char *name);
+
+/**
+ * @brief Parses a profile from its compact text form.
+ *
+ * One step per line as `setpoint,ramp_rate,duration_min,exit` where exit is one of
+ * `time`, `reached` or `hold`. Blank lines and lines starting with '#' are ignored.
+ * Setpoints must lie in PROFILE_SETPOINT_MIN..PROFILE_SETPOINT_MAX, ramp rates in
+ * 0..PROFILE_RAMP_RATE_MAX and durations in 0..PROFILE_DURATION_MAX_MIN.
+ *
+ * @param name Name to assign to the parsed profile.
+ * @param text NUL-terminated profile text.
+ * @param[out] out Profile to fill.
+ * @return true on success, false if the text is malformed, out of range or has no steps.
+ */
+bool profile_parse(const char *name, const char *text, drying_profile_t *out);
+
+/**
+ * @brief Formats a profile into its compact text form (inverse of profile_parse()).
+ * @param profile Profile to format.
+ * @param[out] buf Destination buffer.
+ * @param len Size of the destination buffer.
+ * @return Number of characters written (excluding NUL), or -1 if the buffer is too small.
+ */
+int profile_format(const drying_profile_t *profile, char *buf, size_t len);
+
+/**
+ * @brief Starts executing a profile from its first step.
+ * @param runner Runner to start.
+ * @param profile Profile to execute (copied into the runner).
+ * @param air_temp Current air temperature, used as the starting point of the first ramp.
+ * @param now_s Current time in seconds.
+ */
+void profile_runner_start(profile_runner_t *runner, const drying_profile_t *profile, float air_temp, uint32_t now_s);
+
+/**
+ * @brief Stops the runner.
+ * @param runner Runner to stop.
+ */
+void profile_runner_stop(profile_runner_t *runner);
+
+/**
+ * @brief Advances the runner: integrates the ramp and evaluates the step exit condition.
+ * @param runner Runner to advance.
+ * @param air_temp Current air temperature.
+ * @param now_s Current time in seconds.
+ * @return true while the profile is still running, false once it finished or is stopped.
+ */
+bool profile_runner_tick(profile_runner_t *runner, float air_temp, uint32_t now_s);
+
+/**
+ * @brief Estimates the remaining time of the profile.
+ * @note Ramps are estimated from their rate; hold steps and open-ended
+ *       `reached` steps contribute nothing.
+ * @param runner Runner to query.
+ * @param now_s Current time in seconds.
+ * @return Remaining seconds, or 0 if the runner is not running.
+ */
+uint32_t profile_runner_remaining_s(const profile_runner_t *runner, uint32_t now_s);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <stddef.h>
+#include "esp_err.h"
+#include "drying_profile.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define PROFILE_STORE_DIR "/littlefs/profiles" // LittleFS directory holding uploaded profiles
+
+  /**
+   * @brief Saves a profile to LittleFS in its text form, replacing any profile with the same name
+   * @param profile Profile to save
+   * @return ESP_OK on success, ESP_ERR_INVALID_ARG for an invalid name, ESP_FAIL on I/O error
+   */
+  esp_err_t profile_store_save(const drying_profile_t *profile);
+
+  /**
+   * @brief Loads a profile from LittleFS
+   * @param name Profile name
+   * @param[out] profile Profile to fill
+   * @return ESP_OK on success, ESP_ERR_NOT_FOUND if missing, ESP_ERR_INVALID_STATE if the file is malformed
+   */
+  esp_err_t profile_store_load(const char *name, drying_profile_t *profile);
+
+  /**
+   * @brief Deletes a stored profile
+   * @param name Profile name
+   * @return ESP_OK on success, ESP_ERR_NOT_FOUND if missing
+   */
+  esp_err_t profile_store_delete(const char *name);
+
+  /**
+   * @brief Lists the names of stored profiles
+   * @param[out] names Array receiving up to max_names names
+   * @param max_names Capacity of the names array
+   * @return Number of names written
+   */
+  size_t profile_store_list(char names[][PROFILE_NAME_MAX], size_t max_names);
+
+  /**
+   * @brief Finds a profile by name, preferring an uploaded profile over a built-in one
+   * @param name Profile name
+   * @param[out] profile Profile to fill
+   * @return ESP_OK on success, ESP_ERR_NOT_FOUND if neither exists
+   */
+  esp_err_t profile_store_find(const char *name, drying_profile_t *profile);
+
+#ifdef __cplusplus
+}
+#endif
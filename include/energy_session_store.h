@@ -0,0 +1,25 @@
+#pragma once
+
+#include <stddef.h>
+#include "esp_err.h"
+#include "heater_energy.h"
+
+#define ENERGY_NVS_NAMESPACE "energy"
+#define ENERGY_NVS_KEY "sessions"
+#define ENERGY_SESSION_HISTORY 8 // Most recent sessions kept in NVS
+#define ENERGY_SESSION_VERSION 1 // Bump when energy_session_t changes layout
+
+/**
+ * @brief Appends a finished session to the history in NVS, dropping the oldest when full.
+ * @param session Session summary to store.
+ * @return ESP_OK on success, or the NVS error.
+ */
+esp_err_t energy_session_save(const energy_session_t *session);
+
+/**
+ * @brief Loads the stored session history, newest first.
+ * @param[out] sessions Array to fill.
+ * @param max Capacity of the array.
+ * @return Number of sessions copied (0 if nothing is stored or the layout is outdated).
+ */
+size_t energy_session_load(energy_session_t *sessions, size_t max);
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+
+// 4-pin fan PWM: 25 kHz per the Intel fan spec; 10 bits needs a 25.6 MHz LEDC clock (APB is 80 MHz)
+#define FAN_PWM_FREQ_HZ 25000
+#define FAN_PWM_RESOLUTION_BITS 10
+#define FAN_DUTY_MAX ((1u << FAN_PWM_RESOLUTION_BITS) - 1)
+#define FAN_TACH_PULSES_PER_REV 2    // Standard PC fans pulse twice per revolution
+#define FAN_TACH_GLITCH_NS 10000     // Rejects PWM-coupled spikes; a 6000 RPM fan pulses every 5 ms
+
+/**
+ * @brief Initializes the fan PWM (LEDC timer 1, channel 1) and the PCNT tachometer.
+ * The fan starts at 0% duty.
+ * @return ESP_OK on success, otherwise the error of the failing driver call.
+ */
+esp_err_t fan_init(void);
+
+/**
+ * @brief Sets the fan duty. Writes that would not change the output are skipped.
+ * @param percent Duty from 0 (off) to 100.
+ */
+void fan_set_duty(uint8_t percent);
+
+/** @brief Returns the duty last written to the fan, in percent. */
+uint8_t fan_get_duty(void);
+
+/**
+ * @brief Returns the tachometer pulses counted since the previous call and restarts the count.
+ * @return Pulse count, 0 if the tachometer is not initialized.
+ */
+uint32_t fan_read_tach_pulses(void);
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Closed-loop fan speed control and stall detection parameters. */
+typedef struct
+{
+    uint16_t max_rpm;       // Speed at 100% duty, scales the feed-forward term
+    uint8_t pulses_per_rev; // Tachometer pulses per revolution
+    uint8_t min_duty;       // Lowest duty (%) the fan keeps turning at while running
+    float kp;               // Proportional gain (% duty per RPM of error)
+    float ki;               // Integral gain (% duty per RPM of error per second)
+    uint16_t stall_rpm;     // Below this speed a driven fan counts as not turning
+    uint32_t stall_time_ms; // Time below stall_rpm before the fan is declared stalled
+    uint32_t spinup_ms;     // Grace period after starting from rest, excluded from stall detection
+} fan_control_config_t;
+
+/** @brief State of the fan speed loop. Owned by the task that calls fan_control_update(). */
+typedef struct
+{
+    uint16_t target_rpm;      // Requested speed, 0 = fan off
+    uint16_t rpm;             // Speed measured by the last update
+    uint8_t duty;             // Duty (%) returned by the last update
+    float integral;           // Integral term (% duty)
+    uint32_t slow_ms;         // Time spent below stall_rpm while driven
+    uint32_t spinup_left_ms;  // Remaining spin-up grace
+    bool stalled;             // Driven but not turning for stall_time_ms
+} fan_control_t;
+
+/**
+ * @brief Clears the loop state and turns the fan off.
+ * @param fc Loop state.
+ */
+void fan_control_reset(fan_control_t *fc);
+
+/**
+ * @brief Sets the requested fan speed.
+ * Starting from rest opens the spin-up grace window.
+ * @param fc Loop state.
+ * @param config Loop parameters; the target is capped at max_rpm.
+ * @param rpm Target speed, 0 to stop the fan.
+ */
+void fan_control_set_target(fan_control_t *fc, const fan_control_config_t *config, uint16_t rpm);
+
+/**
+ * @brief Converts the tachometer count of one interval to RPM, updates stall detection and
+ *        runs the PI speed loop.
+ * A stalled fan is driven at 100% to break it loose; the PI state restarts once it turns again.
+ * @param fc Loop state.
+ * @param config Loop parameters.
+ * @param pulses Tachometer pulses counted over the interval.
+ * @param elapsed_ms Interval length in milliseconds.
+ * @return Duty to apply, 0 to 100%.
+ */
+uint8_t fan_control_update(fan_control_t *fc, const fan_control_config_t *config, uint32_t pulses, uint32_t elapsed_ms);
+
+/**
+ * @brief Returns true when the fan is commanded on, turning and not stalled.
+ * Used as the heater interlock: the heater must not run without airflow.
+ * @param fc Loop state.
+ * @param config Loop parameters.
+ */
+bool fan_control_airflow_ok(const fan_control_t *fc, const fan_control_config_t *config);
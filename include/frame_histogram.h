@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stdint.h>
+
+#define FRAME_HISTOGRAM_BUCKETS 10
+
+/**
+ * @brief Fixed-size log2 histogram for per-frame measurements.
+ *
+ * Bucket 0 counts values below unit, bucket i (1..N-2) counts [unit * 2^(i-1), unit * 2^i) and the
+ * last bucket everything above. Adding a sample is O(1) with no allocation, so it can run from
+ * display events every frame.
+ */
+typedef struct
+{
+    uint32_t unit;                            // Upper bound of bucket 0
+    uint32_t counts[FRAME_HISTOGRAM_BUCKETS]; // Samples per bucket
+    uint32_t samples;                         // Total samples
+    uint64_t sum;                             // Sum of all samples, for the mean
+    uint32_t max;                             // Largest sample
+} frame_histogram_t;
+
+/**
+ * @brief Clears the histogram.
+ * @param h Histogram.
+ * @param unit Upper bound of the first bucket (e.g. 1000 for a histogram of microseconds in ms steps).
+ */
+void frame_histogram_init(frame_histogram_t *h, uint32_t unit);
+
+/** @brief Adds one sample. */
+void frame_histogram_add(frame_histogram_t *h, uint32_t value);
+
+/**
+ * @brief Exclusive upper bound of a bucket.
+ * @return unit * 2^bucket, UINT32_MAX for the last bucket.
+ */
+uint32_t frame_histogram_bucket_limit(const frame_histogram_t *h, int bucket);
+
+/** @brief Mean of all samples, 0 when empty. */
+uint32_t frame_histogram_mean(const frame_histogram_t *h);
+
+/**
+ * @brief Estimates a percentile from the buckets.
+ * @param h Histogram.
+ * @param percent Percentile, 1..100.
+ * @return Upper bound of the bucket holding the percentile, capped at the largest sample; 0 when empty.
+ */
+uint32_t frame_histogram_percentile(const frame_histogram_t *h, uint32_t percent);
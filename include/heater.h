@@ -1,12 +1,113 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "power_limiter.h"
 
-/** @brief Initializes the heater hardware peripherals. */
+// Heater PWM output: 12-bit duty at 100 Hz needs a 409.6 kHz LEDC clock, well within the timer limits
+#define HEATER_PWM_FREQ_HZ 100
+#define HEATER_PWM_RESOLUTION_BITS 12
+#define HEATER_DUTY_MAX ((1u << HEATER_PWM_RESOLUTION_BITS) - 1) // Full power duty (4095)
+#ifdef CONFIG_HEATER_FADE_MS
+#define HEATER_DEFAULT_FADE_MS CONFIG_HEATER_FADE_MS // Hardware fade on power changes, 0 = step immediately
+#else
+#define HEATER_DEFAULT_FADE_MS 0
+#endif
+#ifdef CONFIG_HEATER_SIGMA_DELTA_PERIOD_MS
+#define HEATER_SIGMA_DELTA_PERIOD_MS CONFIG_HEATER_SIGMA_DELTA_PERIOD_MS // On/off decision interval
+#else
+#define HEATER_SIGMA_DELTA_PERIOD_MS 20
+#endif
+#ifdef CONFIG_HEATER_POWER_LIMIT_AVG_PERCENT
+#define HEATER_POWER_LIMIT_AVG_PERCENT CONFIG_HEATER_POWER_LIMIT_AVG_PERCENT   // 100 = no average limit
+#define HEATER_POWER_LIMIT_PEAK_PERCENT CONFIG_HEATER_POWER_LIMIT_PEAK_PERCENT // 100 = no peak limit
+#define HEATER_POWER_LIMIT_WINDOW_S CONFIG_HEATER_POWER_LIMIT_WINDOW_S
+#else
+#define HEATER_POWER_LIMIT_AVG_PERCENT 100
+#define HEATER_POWER_LIMIT_PEAK_PERCENT 100
+#define HEATER_POWER_LIMIT_WINDOW_S 600
+#endif
+#ifdef CONFIG_HEATER_MODULATION_SIGMA_DELTA
+#define HEATER_DEFAULT_MODULATION HEATER_MODULATION_SIGMA_DELTA
+#else
+#define HEATER_DEFAULT_MODULATION HEATER_MODULATION_PWM
+#endif
+
+/** @brief How the heater duty is turned into output switching. */
+typedef enum
+{
+    HEATER_MODULATION_PWM,         // LEDC PWM at HEATER_PWM_FREQ_HZ, two switching edges per period
+    HEATER_MODULATION_SIGMA_DELTA, // Whole HEATER_SIGMA_DELTA_PERIOD_MS slots on or off, chosen by a sigma-delta modulator
+} heater_modulation_t;
+
+/** @brief Initializes the heater hardware peripherals in HEATER_DEFAULT_MODULATION mode. */
 void heater_init(void);
 
+/**
+ * @brief Switches the modulation mode, keeping the current duty.
+ * In sigma-delta mode an esp_timer decides every HEATER_SIGMA_DELTA_PERIOD_MS whether the output is
+ * fully on or off, and hardware fading is not used.
+ * @param mode Modulation mode.
+ */
+void heater_set_modulation(heater_modulation_t mode);
+
+/** @brief Returns the active modulation mode. */
+heater_modulation_t heater_get_modulation(void);
+
+/**
+ * @brief Sets the power budget enforced on every duty request, whatever the controller decided.
+ * Call before heating starts or from the task that drives the heater.
+ * @param config Budget in duty units (0 to HEATER_DUTY_MAX); HEATER_DUTY_MAX disables a limit.
+ */
+void heater_set_power_limit(const power_limit_config_t *config);
+
+/**
+ * @brief Copies the power budget in force.
+ * @param[out] config Budget to fill.
+ */
+void heater_get_power_limit(power_limit_config_t *config);
+
+/** @brief Returns true if the last duty request was reduced by the power budget. */
+bool heater_power_limited(void);
+
+/** @brief Returns the mean duty delivered over the budget window. */
+uint32_t heater_power_average(void);
+
 /**
  * @brief Sets the heater power level.
+ * Scaled to the full PWM resolution; see heater_set_duty().
  * @param power Power level from 0 (off) to 255 (max).
  */
-void set_heat_power(uint8_t power);
\ No newline at end of file
+void set_heat_power(uint8_t power);
+
+/**
+ * @brief Sets the heater duty at full PWM resolution.
+ * Writes that would not change the output are skipped. With a fade time configured, changes are
+ * ramped by the LEDC fade engine without CPU involvement; switching off is always immediate.
+ * @param duty Duty from 0 (off) to HEATER_DUTY_MAX.
+ */
+void heater_set_duty(uint32_t duty);
+
+/**
+ * @brief Re-applies the last requested duty so the power budget keeps being enforced while it is held.
+ * The controller only writes on changes; call this every control period from the task that drives the heater.
+ */
+void heater_tick(void);
+
+/** @brief Returns the duty last commanded (the fade target while fading, the average in sigma-delta mode). */
+uint32_t heater_get_duty(void);
+
+/**
+ * @brief Sets the hardware fade time used for power changes.
+ * @param fade_ms Fade duration in milliseconds, 0 to step immediately.
+ */
+void heater_set_fade_time(uint32_t fade_ms);
+
+/**
+ * @brief Drives the heater output to 0 directly and latches it off.
+ * set_heat_power() outputs 0 until heater_clear_force_off() is called. Safe to call from an esp_timer callback.
+ */
+void heater_force_off(void);
+
+/** @brief Releases the latch set by heater_force_off(). */
+void heater_clear_force_off(void);
@@ -2,7 +2,28 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 #include "freertos/FreeRTOS.h" // Include FreeRTOS for SemaphoreHandle_t
+#include "temp.h"
+
+#define CONTROLLER_MAX_INSTANCES 2       // Heating zones that can run at once (instance 0 is the default)
+#define CONTROLLER_SCHEDULE_MAX_POINTS 4 // Max setpoints in a gain schedule
+
+/** @brief Control parameters that apply around one setpoint of a gain schedule. */
+typedef struct
+{
+    float setpoint;               // Target air temperature this entry was tuned at.
+    float air_temp_hysteresis;    // See controller_config_t.
+    float heater_temp_hysteresis; // See controller_config_t.
+    float full_power_delta;       // See controller_config_t.
+} controller_schedule_point_t;
+
+/** @brief Setpoint-indexed parameter table, linearly interpolated at runtime. */
+typedef struct
+{
+    uint8_t count;                                                     // Valid entries, 0 = schedule disabled
+    controller_schedule_point_t points[CONTROLLER_SCHEDULE_MAX_POINTS]; // Sorted by ascending setpoint
+} controller_gain_schedule_t;
 
 /** @brief Configuration parameters for the heater controller. */
 typedef struct
@@ -11,8 +32,23 @@ typedef struct
     float air_temp_hysteresis;    // Hysteresis for air temp bang-bang control (e.g., 1.0f).
     float heater_temp_hysteresis; // Hysteresis for heater temp bang-bang control (e.g., 2.0f).
     float full_power_delta;       // Temp delta below target to engage full power mode (e.g. 5.0f).
+    float ramp_rate;              // Max rise rate of the control reference in C/min (0 = apply target instantly).
+    float ramp_accel;             // S-curve acceleration limit of the reference in C/min^2 (0 = constant-rate ramp).
+    float control_period_s;       // Interval between controller_run() calls in seconds, used to integrate the ramp.
+    controller_gain_schedule_t schedule; // Overrides the three hysteresis/delta values above when count > 0.
+    float runaway_window_s;       // Thermal protection window in seconds (0 = protection disabled).
+    float runaway_min_rise;       // Min heater rise (C) over the first window of a full-power run (see controller_runaway.h).
+    float runaway_idle_max_rise;  // Max heater rise (C) tolerated over a window spent entirely at zero power.
 } controller_config_t;
 
+/** @brief Latched thermal protection fault of a controller instance. */
+typedef enum
+{
+    CONTROLLER_FAULT_NONE,
+    CONTROLLER_FAULT_HEATING_FAILED, // Full power for a whole window without the expected rise (sensor off the heater, dead heater)
+    CONTROLLER_FAULT_RUNAWAY,        // Heater temperature rose with the output off (stuck output stage)
+} controller_fault_t;
+
 // Access to internal state for testing purposes only
 typedef enum
 {
@@ -22,7 +58,63 @@ typedef enum
     CONTROLLER_STATE_MAINTAINING_AIR_TEMP,
 } controller_state_t;
 
+/**
+ * @brief Heater output callback of a controller instance.
+ * @param power Power level from 0 (off) to 255 (max).
+ * @param ctx User context from the instance configuration.
+ */
+typedef void (*controller_output_fn_t)(uint8_t power, void *ctx);
+
+/**
+ * @brief Heater interlock of a controller instance, e.g. airflow present.
+ * Called under the instance mutex before every non-zero output, so it must not block.
+ * @param ctx User context from the instance configuration.
+ * @return true if the heater may run.
+ */
+typedef bool (*controller_interlock_fn_t)(void *ctx);
+
+/** @brief Configuration of an independent controller instance (heating zone). */
+typedef struct
+{
+    const char *name;                   // Zone name used in logs
+    controller_config_t params;         // Control parameters
+    float initial_target_temp;          // Initial target air temperature
+    temp_sensor_handle_t air_sensor;    // Air sensor read by controller_step()
+    temp_sensor_handle_t heater_sensor; // Heater element sensor read by controller_step()
+    controller_output_fn_t set_power;   // Heater output, NULL for the default heater (set_heat_power)
+    void *output_ctx;                   // Passed to set_power
+    controller_interlock_fn_t interlock; // Optional: holds the heater off while it returns false
+    void *interlock_ctx;                // Passed to interlock
+} controller_instance_config_t;
+
+/** @brief Event counters of a controller instance. */
 typedef struct
+{
+    uint32_t cycles;         // controller_run() cycles executed
+    uint32_t heating_cycles; // Cycles that ended with the heater on
+    uint32_t safety_trips;   // Times the heater safety override engaged
+    uint32_t sensor_faults;  // controller_step() calls skipped due to missing sensor data
+    uint32_t interlock_trips; // Times the interlock blocked a heat demand
+} controller_telemetry_t;
+
+/** @brief Consistent copy of an instance's state, readable without taking its mutex. */
+typedef struct
+{
+    controller_state_t state;
+    bool active;
+    bool heater_safety_override_active;
+    float target_temp;    // Target requested by the user/profile
+    float reference_temp; // Setpoint actually tracked (after ramping)
+    float heater_temp;    // Last heater temperature fed to the controller
+    float air_temp;       // Last air temperature fed to the controller
+    uint8_t power;        // Last commanded heater power
+    bool autotuning;      // True while an auto-tune run owns the heater
+    controller_fault_t fault; // Latched thermal protection fault, heater held off while set
+    bool interlocked;     // Heat was demanded but the interlock held the heater off
+    controller_telemetry_t telemetry;
+} controller_snapshot_t;
+
+typedef struct controller_instance
 {
     controller_config_t config;
     float target_temp;
@@ -32,16 +124,147 @@ typedef struct
     bool initialized;                   // Flag to indicate if controller is initialized
     bool heater_safety_override_active; // Flag to indicate if safety override is active
     uint8_t current_power;              // Current power level commanded to the heater
+    float ramp_reference;               // Ramped setpoint the state machine tracks (C)
+    float ramp_velocity;                // Current slew rate of the ramped reference (C/s)
+    bool ramp_valid;                    // False until the reference is seeded from the air temp
+    const char *name;                   // Zone name used in logs
+    temp_sensor_handle_t air_sensor;    // Sensors read by controller_step()
+    temp_sensor_handle_t heater_sensor;
+    controller_output_fn_t set_power;   // Heater output
+    void *output_ctx;
+    controller_interlock_fn_t interlock; // Heater interlock, NULL = none
+    void *interlock_ctx;
+    bool interlocked;                   // Last heat demand was blocked by the interlock
+    controller_schedule_point_t scheduled; // Parameters in effect, interpolated for scheduled_for
+    float scheduled_for;                // Target the scheduled parameters were computed for
+    bool autotuning;                    // True while an auto-tune run owns the heater
+    controller_fault_t fault;           // Latched thermal protection fault
+    controller_telemetry_t telemetry;   // Event counters (written under the mutex)
+    atomic_uint snapshot_seq;           // Seqlock sequence, odd while the snapshot is being written
+    controller_snapshot_t snapshot;     // Published after every change for lock-free readers
 } controller_internal_state_t;
 
+/** @brief Handle to a controller instance. */
+typedef struct controller_instance *controller_handle_t;
+
 /**
  * @brief Provides a pointer to the internal state of the controller for testing or debugging.
- * @return Pointer to `controller_internal_state_t`.
+ * @return Pointer to `controller_internal_state_t` of the default instance.
  */
 controller_internal_state_t *controller_get_state(void);
 
 /**
- * @brief Initializes the controller and its internal mutex.
+ * @brief Creates a controller instance bound to its own sensors and heater output.
+ * @note Instances come from a static pool of CONTROLLER_MAX_INSTANCES; the first free
+ *       slot is used, so the first instance created is the default instance.
+ * @param config Instance configuration (copied).
+ * @return Handle to the instance, or NULL if the pool is exhausted or creation failed.
+ */
+controller_handle_t controller_create(const controller_instance_config_t *config);
+
+/**
+ * @brief Destroys a controller instance, deleting its mutex and freeing its slot.
+ * @param ctrl Instance to destroy.
+ */
+void controller_destroy(controller_handle_t ctrl);
+
+/**
+ * @brief Returns the default instance used by the controller_* free functions.
+ * @return Handle to the default instance (may not be initialized).
+ */
+controller_handle_t controller_get_default(void);
+
+/**
+ * @brief Sets the target air temperature of an instance.
+ * @param ctrl Instance.
+ * @param temp The desired target air temperature.
+ */
+void controller_instance_set_target_temp(controller_handle_t ctrl, float temp);
+
+/**
+ * @brief Activates or deactivates an instance; see controller_set_active().
+ * @param ctrl Instance.
+ * @param active True to activate control, false to force IDLE.
+ */
+void controller_instance_set_active(controller_handle_t ctrl, bool active);
+
+/**
+ * @brief Executes one control cycle of an instance with the given temperatures.
+ * @note Temperatures outside TEMP_MIN/MAX_VALID_CELSIUS (including the -999 invalid marker)
+ *       force the heater off and count as a sensor fault.
+ * @param ctrl Instance.
+ * @param heater_temp The current temperature of the heater element.
+ * @param air_temp The current air temperature.
+ */
+void controller_instance_run(controller_handle_t ctrl, float heater_temp, float air_temp);
+
+/**
+ * @brief Reads the instance's own sensors and executes one control cycle.
+ *        If either sensor has no valid reading the heater is forced off.
+ * @param ctrl Instance.
+ * @return true if the cycle ran, false if sensor data was missing.
+ */
+bool controller_step(controller_handle_t ctrl);
+
+/**
+ * @brief Steps every initialized instance that has sensors bound (see controller_step()).
+ * @note Intended to be called periodically by a single control task.
+ */
+void controller_step_all(void);
+
+/**
+ * @brief Copies the latest published state of an instance without taking its mutex.
+ * @param ctrl Instance.
+ * @param[out] snapshot Snapshot to fill.
+ * @return true on success, false if ctrl is NULL or not initialized.
+ */
+bool controller_get_snapshot(controller_handle_t ctrl, controller_snapshot_t *snapshot);
+
+/**
+ * @brief Interpolates a gain schedule at a setpoint.
+ * @note Setpoints outside the table use the nearest entry. With an empty schedule the
+ *       values come from `config` itself.
+ * @param config Controller configuration holding the schedule.
+ * @param setpoint Setpoint to evaluate.
+ * @param[out] out Parameters to use at that setpoint.
+ */
+void controller_schedule_lookup(const controller_config_t *config, float setpoint, controller_schedule_point_t *out);
+
+/**
+ * @brief Starts relay auto-tuning of an instance at one or more setpoints.
+ * The instance drives its heater itself (the safety limit stays in force) and, when all
+ * setpoints are done, installs the measured gain schedule and goes inactive.
+ * @param ctrl Instance.
+ * @param setpoints Setpoints to tune at, ascending.
+ * @param count Number of setpoints (1 to CONTROLLER_SCHEDULE_MAX_POINTS).
+ * @return true if tuning started.
+ */
+bool controller_instance_start_autotune(controller_handle_t ctrl, const float *setpoints, uint8_t count);
+
+/**
+ * @brief Aborts a running auto-tune, leaving the instance inactive with its old schedule.
+ * @param ctrl Instance.
+ */
+void controller_instance_cancel_autotune(controller_handle_t ctrl);
+
+/**
+ * @brief Clears a latched thermal protection fault and restarts its window.
+ * The heater stays off until the next control cycle decides otherwise.
+ * @param ctrl Instance.
+ */
+void controller_instance_clear_fault(controller_handle_t ctrl);
+
+/**
+ * @brief Copies the current configuration (including any tuned schedule) of an instance.
+ * @param ctrl Instance.
+ * @param[out] config Configuration to fill.
+ * @return true on success.
+ */
+bool controller_instance_get_config(controller_handle_t ctrl, controller_config_t *config);
+
+/**
+ * @brief Initializes the default controller instance and its internal mutex.
+ * @note The default instance drives the heater through set_heat_power() and has no sensors bound.
  * @param config Pointer to a struct with the controller's operating parameters.
  * @param initial_target_temp The initial target air temperature.
  */
@@ -52,6 +275,8 @@ void controller_deinit(void);
 
 /**
  * @brief Sets a new target air temperature in a thread-safe manner.
+ * @note When `ramp_rate` is configured, rises are followed gradually by the ramp
+ *       reference (S-curve shaped if `ramp_accel` is set); drops apply immediately.
  * @param temp The desired target air temperature.
  */
 void controller_set_target_temp(float temp);
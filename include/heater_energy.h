@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "drying_profile.h" // For PROFILE_NAME_MAX
+
+#define HEATER_ENERGY_HISTOGRAM_BINS 10 // Duty histogram in 10% steps, 100% falls in the last bin
+#ifdef CONFIG_HEATER_WATTS
+#define HEATER_ENERGY_DEFAULT_WATTS ((float)CONFIG_HEATER_WATTS)
+#else
+#define HEATER_ENERGY_DEFAULT_WATTS 150.0f // Heater power at 100% duty
+#endif
+
+/**
+ * @brief Heater energy integrator.
+ * Sums commanded duty x time in integer duty-microseconds, so hours of 1 s updates accumulate no
+ * rounding error; conversion to Wh happens only when the value is read. At 12-bit duty the
+ * accumulator lasts for more than a century.
+ */
+typedef struct
+{
+    uint64_t duty_us;                                  // Sum of duty x microseconds
+    uint64_t elapsed_us;                               // Time integrated
+    uint64_t histogram_us[HEATER_ENERGY_HISTOGRAM_BINS]; // Time spent in each duty bin
+    uint32_t duty_max;                                 // Full-scale duty
+    uint32_t duty;                                     // Duty in effect since last_us
+    int64_t last_us;                                   // Time of the last update
+} heater_energy_t;
+
+/** @brief Summary of one drying session, as shown and persisted. */
+typedef struct
+{
+    char profile[PROFILE_NAME_MAX];  // Profile that ran
+    uint32_t start_time;             // Unix time the session started, 0 if the clock was not set
+    uint32_t duration_s;             // Time integrated
+    float energy_wh;                 // Heater energy
+    float avg_power_w;               // energy_wh over duration_s
+    float duty_percent;              // Average duty
+    uint16_t histogram_permille[HEATER_ENERGY_HISTOGRAM_BINS]; // Share of the session in each duty bin
+} energy_session_t;
+
+/**
+ * @brief Clears the integrator and starts integrating from now.
+ * @param e Integrator.
+ * @param duty_max Full-scale duty of the output (100% power).
+ * @param duty Duty in effect from now on.
+ * @param now_us Current time in microseconds.
+ */
+void heater_energy_reset(heater_energy_t *e, uint32_t duty_max, uint32_t duty, int64_t now_us);
+
+/**
+ * @brief Integrates the duty in effect since the last call up to now, then switches to the new duty.
+ * Calls with a timestamp that does not advance only change the duty.
+ * @param e Integrator.
+ * @param duty Duty in effect from now on (clamped to duty_max).
+ * @param now_us Current time in microseconds.
+ */
+void heater_energy_update(heater_energy_t *e, uint32_t duty, int64_t now_us);
+
+/**
+ * @brief Returns the integrated energy.
+ * @param e Integrator.
+ * @param watts Heater power at full duty (configured rating or measured V x I).
+ * @return Energy in watt-hours.
+ */
+float heater_energy_wh(const heater_energy_t *e, float watts);
+
+/**
+ * @brief Fills the numeric fields of a session summary (profile and start_time are left alone).
+ * @param e Integrator.
+ * @param watts Heater power at full duty.
+ * @param[out] session Summary to fill.
+ */
+void heater_energy_summarize(const heater_energy_t *e, float watts, energy_session_t *session);
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define HEATER_WATCHDOG_MIN_VALID_TEMP -20.0f // Feeds outside this range are treated as sensor garbage
+#define HEATER_WATCHDOG_MAX_VALID_TEMP 200.0f
+
+/** @brief Heater watchdog configuration. */
+typedef struct
+{
+    uint32_t timeout_ms;  // Maximum time between valid feeds before the heater is cut
+    void (*cutoff)(void); // Drives the heater output to 0 without going through the controller
+    void (*on_trip)(void); // Optional: called once when the watchdog trips (fault reporting)
+} heater_watchdog_config_t;
+
+/**
+ * @brief Arms the heater watchdog. The deadline starts counting from this call.
+ * heater_watchdog_check() must then be called periodically from a context that does not depend on
+ * the control loop (an esp_timer on the device).
+ * @param config Watchdog configuration; cutoff is required.
+ * @return true if armed, false for an invalid configuration.
+ */
+bool heater_watchdog_init(const heater_watchdog_config_t *config);
+
+/** @brief Disarms the watchdog. */
+void heater_watchdog_deinit(void);
+
+/**
+ * @brief Feeds the watchdog with the heater sample used by this control cycle.
+ * Only plausible readings of a new sample refresh the deadline, so a loop running on a dead
+ * sensor, or on a sample that stopped updating, still trips it.
+ * @param heater_temp Heater temperature in Celsius (-999.0f marks an invalid reading).
+ * @param sample_sequence Sequence number of the sample (temp_sample_t.sequence).
+ * @return true if the feed was accepted.
+ */
+bool heater_watchdog_feed(float heater_temp, uint32_t sample_sequence);
+
+/**
+ * @brief Checks the deadline and cuts the heater when it has passed.
+ * While tripped, every check drives the output to 0 again.
+ * @return true if the watchdog is tripped.
+ */
+bool heater_watchdog_check(void);
+
+/** @brief Returns true while the watchdog fault is latched. */
+bool heater_watchdog_tripped(void);
+
+/**
+ * @brief Clears a latched fault and restarts the deadline.
+ * A loop that is still stalled trips the watchdog again after timeout_ms.
+ */
+void heater_watchdog_clear(void);
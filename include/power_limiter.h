@@ -0,0 +1,62 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define POWER_LIMIT_SLOTS 60 // Resolution of the sliding window
+
+/**
+ * @brief Power budget, in the duty units of the output it is applied to.
+ * A limit at or above the output's full scale disables it.
+ */
+typedef struct
+{
+    uint32_t max_average; // Highest mean duty over any window_ms
+    uint32_t peak;        // Highest instantaneous duty
+    uint32_t window_ms;   // Averaging window (0 = only the peak limit applies)
+} power_limit_config_t;
+
+/**
+ * @brief Sliding-window average power limiter.
+ *
+ * Delivered duty x time is kept in POWER_LIMIT_SLOTS slots covering window_ms. The headroom left
+ * in the window (budget minus delivered) lets the output run above max_average, up to peak, until
+ * it is spent; it comes back as old slots expire, so the mean over any window stays at or under
+ * max_average. Missing history at start counts as zero, so a cold start gets the full burst.
+ */
+typedef struct
+{
+    power_limit_config_t config;
+    uint64_t slot_sum[POWER_LIMIT_SLOTS]; // Duty x ms delivered per slot
+    uint64_t window_sum;                  // Sum of slot_sum
+    uint32_t slot_ms;                     // window_ms / POWER_LIMIT_SLOTS
+    uint16_t head;                        // Slot being filled
+    uint32_t head_ms;                     // Time already accumulated into the head slot
+    uint32_t duty;                        // Duty delivered since last_ms
+    uint32_t requested;                   // Duty asked for by the last call, before limiting
+    int64_t last_ms;                      // Time of the last call, -1 before the first
+    bool limiting;                        // Last request was reduced
+} power_limiter_t;
+
+/**
+ * @brief Sets the budget and clears the history.
+ * @param pl Limiter.
+ * @param config Budget (copied).
+ */
+void power_limiter_init(power_limiter_t *pl, const power_limit_config_t *config);
+
+/**
+ * @brief Accounts the duty delivered since the previous call and limits the next one.
+ * Must be called whenever the output changes and at least once per slot while it is on.
+ * @param pl Limiter.
+ * @param requested Duty the controller asks for.
+ * @param now_ms Current time in milliseconds.
+ * @return Duty to apply, at most requested.
+ */
+uint32_t power_limiter_apply(power_limiter_t *pl, uint32_t requested, int64_t now_ms);
+
+/**
+ * @brief Returns the mean duty delivered over the window so far (window_ms = 0: the current duty).
+ * @param pl Limiter.
+ */
+uint32_t power_limiter_average(const power_limiter_t *pl);
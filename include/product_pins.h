@@ -22,6 +22,8 @@
 #define BOARD_I2C_SDA (18)
 #define BOARD_TOUCH_IRQ (16)
 #define BOARD_TOUCH_RST (21)
+#define BOARD_BUTTON_BOOT (0) // Active low, external pull-up
+#define BOARD_BUTTON_KEY (14) // Active low
 #define AMOLED_WIDTH (170)
 #define AMOLED_HEIGHT (320)
 
@@ -32,3 +34,6 @@
 #define DISPLAY_FULLRESH false
 
 #define BOARD_HEATER_GPIO (3)
+
+#define BOARD_FAN_PWM_GPIO (10)  // 4-pin fan PWM input (25 kHz)
+#define BOARD_FAN_TACH_GPIO (11) // Open-collector tach output, internal pull-up enabled
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief First-order sigma-delta modulator turning a power level into on/off decisions.
+ *
+ * Every step adds the level to an accumulator and switches on when it overflows full scale, so
+ * the on-fraction over any window tracks level / full_scale to within one step, with no limit on
+ * the averaging resolution other than full_scale itself.
+ */
+typedef struct
+{
+    uint32_t full_scale;  // Level meaning "always on"
+    uint32_t level;       // Requested level, 0 to full_scale
+    uint32_t accumulator; // Error carried between steps, always below full_scale
+} sigma_delta_t;
+
+/**
+ * @brief Initializes the modulator at level 0.
+ * @param sd Modulator.
+ * @param full_scale Level that keeps the output on every step (must be > 0).
+ */
+void sigma_delta_init(sigma_delta_t *sd, uint32_t full_scale);
+
+/**
+ * @brief Sets the level; the accumulated error is kept so the average stays exact across changes.
+ * @param sd Modulator.
+ * @param level New level (clamped to full_scale).
+ */
+void sigma_delta_set_level(sigma_delta_t *sd, uint32_t level);
+
+/**
+ * @brief Advances one step.
+ * @param sd Modulator.
+ * @return true if the output is on for this step.
+ */
+bool sigma_delta_step(sigma_delta_t *sd);
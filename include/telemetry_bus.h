@@ -0,0 +1,107 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ui/subject_mailbox.h"
+
+#define TELEMETRY_MAX_SUBSCRIBERS 16
+
+/** @brief Telemetry topics. Every value travels as a float; state and fault carry small integer codes. */
+typedef enum
+{
+    TELEMETRY_TOPIC_AIR_TEMP,    // Air temperature (C)
+    TELEMETRY_TOPIC_HEATER_TEMP, // Heater element temperature (C)
+    TELEMETRY_TOPIC_POWER,       // Applied heater power (0-100 %)
+    TELEMETRY_TOPIC_STATE,       // System state (0=idle, 1=heating, 2=cooling, 3=error)
+    TELEMETRY_TOPIC_FAULT,       // Heater fault code (CONTROL_FAULT_*)
+    TELEMETRY_TOPIC_AIR_VOLTAGE,       // Air thermistor ADC voltage (V, -999 when invalid)
+    TELEMETRY_TOPIC_AIR_RESISTANCE,    // Air thermistor resistance (ohm, -999 when invalid)
+    TELEMETRY_TOPIC_HEATER_VOLTAGE,    // Heater thermistor ADC voltage (V, -999 when invalid)
+    TELEMETRY_TOPIC_HEATER_RESISTANCE, // Heater thermistor resistance (ohm, -999 when invalid)
+    TELEMETRY_TOPIC_COUNT
+} telemetry_topic_t;
+
+/** @brief Task a subscriber's callback runs in; each context calls telemetry_dispatch() from its own loop. */
+typedef enum
+{
+    TELEMETRY_CONTEXT_LVGL,    // LVGL task, once per frame
+    TELEMETRY_CONTEXT_WEB,     // HTTP server task, via httpd_queue_work()
+    TELEMETRY_CONTEXT_CONTROL, // Control task, once per control period
+    TELEMETRY_CONTEXT_COUNT
+} telemetry_context_t;
+
+/**
+ * @brief Subscriber callback.
+ * @param topic Topic the value was published on.
+ * @param value Latest published value.
+ * @param ctx Context pointer given to telemetry_subscribe().
+ */
+typedef void (*telemetry_callback_t)(telemetry_topic_t topic, float value, void *ctx);
+
+/** @brief Per-topic counters, summed over all subscribers of the topic. */
+typedef struct
+{
+    uint32_t publishes;       // telemetry_publish() calls
+    uint32_t deliveries;      // Callbacks run
+    uint32_t coalesced;       // Values replaced by a newer one before their subscriber ran
+    uint32_t last_latency_us; // Publish-to-callback time of the latest delivery
+    uint32_t max_latency_us;  // Worst publish-to-callback time seen
+} telemetry_topic_stats_t;
+
+/**
+ * @brief Subscribes a callback to a topic.
+ *
+ * Each subscriber has its own latest-value slot: publishing never blocks and never calls back
+ * directly, and a subscriber that falls behind only ever sees the newest value. Subscriptions are
+ * made from startup code in one task; publishing may already be running.
+ * @param topic Topic to receive.
+ * @param context Task whose telemetry_dispatch() runs the callback.
+ * @param max_rate_hz Maximum callback rate (0 = every dispatch with a new value). Values arriving
+ *                    faster are held back and the newest one is delivered when the interval has passed.
+ * @param callback Callback to run.
+ * @param ctx Passed to the callback.
+ * @return true if subscribed, false if the table is full or an argument is invalid.
+ */
+bool telemetry_subscribe(telemetry_topic_t topic, telemetry_context_t context, float max_rate_hz,
+                         telemetry_callback_t callback, void *ctx);
+
+/**
+ * @brief Publishes a value to every subscriber of the topic. Wait-free; callable from any task.
+ * @param topic Topic.
+ * @param value Value.
+ */
+void telemetry_publish(telemetry_topic_t topic, float value);
+
+/**
+ * @brief Returns the last value published on a topic.
+ * @param topic Topic.
+ * @param value Receives the value.
+ * @return false if nothing has been published on the topic yet.
+ */
+bool telemetry_get_latest(telemetry_topic_t topic, float *value);
+
+/**
+ * @brief Returns true if a subscriber of the context has a value waiting.
+ * Lets a context that is woken from elsewhere (the web server) skip scheduling an empty dispatch.
+ */
+bool telemetry_context_pending(telemetry_context_t context);
+
+/**
+ * @brief Runs the callbacks of a context's subscribers that have a new value and are due.
+ * Must be called from the task the context stands for.
+ * @param context Context to dispatch.
+ */
+void telemetry_dispatch(telemetry_context_t context);
+
+/**
+ * @brief Copies the counters of a topic.
+ * @param topic Topic.
+ * @param stats Receives the counters.
+ */
+void telemetry_get_stats(telemetry_topic_t topic, telemetry_topic_stats_t *stats);
+
+/** @brief Returns the topic name used in logs and the web API ("air_temp", ...). */
+const char *telemetry_topic_name(telemetry_topic_t topic);
+
+/** @brief Removes all subscriptions and clears values and counters. Not safe while publishing. */
+void telemetry_reset(void);
@@ -2,6 +2,7 @@
 
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include "circular_buffer.h"
 
 #ifdef __cplusplus
@@ -44,6 +45,14 @@ extern "C"
 #define TEMP_READ_INTERVAL_MS 1000 // Read temperature every second
 #define TEMP_AVERAGE_SAMPLES 250   // Number of ADC samples to average for noise reduction
 
+// Reading classification thresholds
+#define TEMP_ADC_OPEN_CIRCUIT_RAW 4080  // Median ADC count at or above this: divider pulled to the rail, thermistor open
+#define TEMP_ADC_SHORT_CIRCUIT_RAW 16   // Median ADC count at or below this: thermistor shorted to ground
+#define TEMP_MIN_VALID_CELSIUS -50.0f   // Plausible temperature range of the dryer
+#define TEMP_MAX_VALID_CELSIUS 150.0f
+#define TEMP_MAX_JUMP_CELSIUS 15.0f     // Max change between consecutive readings (1 s apart)
+#define TEMP_MAX_SAMPLE_AGE_MS (3 * TEMP_READ_INTERVAL_MS) // Older samples mean temp_task stopped; treated as no reading
+
   // Temperature sensor handle (opaque type for object-oriented API)
   typedef struct temp_sensor_handle *temp_sensor_handle_t;
 
@@ -62,15 +71,38 @@ extern "C"
     float C; // Third coefficient
   } steinhart_hart_coeffs_t;
 
+  // Classification of a reading; anything but TEMP_STATUS_OK must be treated as no reading
+  typedef enum
+  {
+    TEMP_STATUS_OK,
+    TEMP_STATUS_OPEN_CIRCUIT,  // Thermistor disconnected (ADC at the top rail)
+    TEMP_STATUS_SHORT_CIRCUIT, // Thermistor shorted (ADC at zero)
+    TEMP_STATUS_ADC_ERROR,     // No valid ADC samples could be taken
+    TEMP_STATUS_IMPLAUSIBLE,   // Outside the valid range or jumped too far since the last reading
+    TEMP_STATUS_COUNT,
+  } temp_status_t;
+
   // Temperature sample structure
   typedef struct
   {
-    float temperature;
+    float temperature; // -999.0f unless status is TEMP_STATUS_OK
     float voltage;    // Calibrated and manually adjusted ADC voltage
     float resistance; // Thermistor resistance in ohms
-    uint32_t timestamp;
+    uint32_t timestamp;   // Wall-clock time (time(NULL)), only meaningful once SNTP has synced
+    temp_status_t status; // Classification of this reading
+    uint32_t sequence;    // Per-sensor reading counter, advances with every reading
+    int64_t time_us;      // esp_timer time of the reading (monotonic since boot)
   } temp_sample_t;
 
+  // Per-sensor count of rejected readings since boot
+  typedef struct
+  {
+    uint32_t open_circuit;
+    uint32_t short_circuit;
+    uint32_t adc_error;
+    uint32_t implausible;
+  } temp_fault_counts_t;
+
   /**
    * @brief Calculate Steinhart-Hart coefficients from three temperature-resistance data points
    * @param p1 First calibration point
@@ -83,6 +115,24 @@ extern "C"
       temperature_resistance_point_t p2,
       temperature_resistance_point_t p3);
 
+  /**
+   * @brief Classify a thermistor reading
+   * @param median_raw Median ADC count of the reading
+   * @param valid_samples Number of ADC samples that read successfully
+   * @param temperature Temperature converted from the reading
+   * @param previous_temperature Temperature of the previous reading, NAN if there is none
+   * @return TEMP_STATUS_OK, or the first fault that applies
+   */
+  temp_status_t temp_classify_reading(float median_raw, uint16_t valid_samples, float temperature,
+                                      float previous_temperature);
+
+  /**
+   * @brief Get a short name for a reading status ("ok", "open", "short", "adc", "implausible")
+   * @param status Reading status
+   * @return Static string
+   */
+  const char *temp_status_name(temp_status_t status);
+
   /**
    * @brief Initialize ADC and temperature sampling system
    * Creates a circular buffer in PSRAM and starts background temperature reading task
@@ -104,7 +154,7 @@ extern "C"
   /**
    * @brief Get the most recent temperature reading from a sensor
    * @param sensor Handle to the temperature sensor
-   * @return Latest temperature in Celsius, or -999.0f if no samples available or invalid sensor
+   * @return Latest temperature in Celsius, or -999.0f if no samples available, invalid sensor or faulted reading
    */
   float temp_sensor_get_reading(temp_sensor_handle_t sensor);
 
@@ -125,6 +175,25 @@ extern "C"
    */
   bool temp_sensor_get_latest_sample(temp_sensor_handle_t sensor, temp_sample_t *sample);
 
+  /**
+   * @brief Get the latest sample of a sensor if it can be used for control
+   * This is the one place that decides whether a reading is trustworthy; consumers must
+   * treat false as "no reading" and never fall back to an older value.
+   * @param sensor Handle to the temperature sensor (NULL allowed)
+   * @param[out] sample Latest sample, untouched on failure
+   * @return true if the sample was classified TEMP_STATUS_OK and is at most
+   *         TEMP_MAX_SAMPLE_AGE_MS old, false otherwise
+   */
+  bool temp_sensor_get_usable_sample(temp_sensor_handle_t sensor, temp_sample_t *sample);
+
+  /**
+   * @brief Get the latest temperature of a sensor if it can be used for control
+   * @param sensor Handle to the temperature sensor (NULL allowed)
+   * @param[out] temperature Latest temperature in Celsius, untouched on failure
+   * @return true if temp_sensor_get_usable_sample() succeeds
+   */
+  bool temp_sensor_read_ok(temp_sensor_handle_t sensor, float *temperature);
+
   /**
    * @brief Get number of stored temperature samples from a sensor
    * @param sensor Handle to the temperature sensor
@@ -139,6 +208,14 @@ extern "C"
    */
   float temp_sensor_get_voltage(temp_sensor_handle_t sensor);
 
+  /**
+   * @brief Get the number of rejected readings of a sensor, by fault
+   * @param sensor Handle to the temperature sensor
+   * @param[out] counts Counters to fill
+   * @return true on success, false for an invalid sensor
+   */
+  bool temp_sensor_get_fault_counts(temp_sensor_handle_t sensor, temp_fault_counts_t *counts);
+
   /**
    * @brief Get the most recent thermistor resistance reading from a sensor
    * @param sensor Handle to the temperature sensor
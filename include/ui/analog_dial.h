@@ -44,6 +44,10 @@ extern "C"
  * @param min_value     Minimum value for the dial scale
  * @param max_value     Maximum value for the dial scale
  * @return              Pointer to the created analog dial structure
+ *
+ * All dials share one physics timer, which only runs while some needle is
+ * moving, and one set of band styles per color, so additional dials cost
+ * little more than their widgets.
  */
   struct analog_dial_t *create_analog_dial(
       lv_obj_t *parent,
@@ -53,6 +57,19 @@ extern "C"
       float min_value,
       float max_value);
 
+  /**
+   * Moves the green target band.
+   *
+   * The static part of the dial (arc, ticks, labels and bands) is rendered once into a cached
+   * image and only the needle is redrawn as it moves; this re-renders that image, so call it only
+   * when the target actually changes.
+   *
+   * @param dial          Analog dial
+   * @param target_value  The target value for the green band center
+   * @param target_range  The total width of the green band
+   */
+  void analog_dial_set_target(struct analog_dial_t *dial, float target_value, float target_range);
+
   /**
    * Frees the memory allocated for an analog dial.
    *
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Spring-damper physics parameters (must stay underdamped: C^2 < 4 K M) */
+#define NEEDLE_SPRING_K 15.0f   /* Higher = stiffer spring, more overshoot */
+#define NEEDLE_DAMPING_C 0.8f   /* Higher = more damping, less oscillation */
+#define NEEDLE_MASS_M 0.1f      /* Mass of the needle (affects inertia) */
+
+/* Longest step taken in one go; after a stall the needle carries on from where it was instead of jumping */
+#define NEEDLE_MAX_DT_S 0.1f
+
+/* Below both of these the needle counts as settled and snaps to its target (scale units, units/s) */
+#define NEEDLE_SETTLE_EPSILON 0.05f
+
+  /**
+   * Spring-damper model of a dial needle, kept free of LVGL so it can be tested on the host.
+   */
+  typedef struct
+  {
+    float position; /* Current needle position */
+    float target;   /* Position the spring pulls towards */
+    float velocity; /* Current velocity */
+    bool settled;   /* At rest on the target; stepping does nothing until the target changes */
+  } needle_model_t;
+
+  /**
+   * Places the needle at rest on a position.
+   *
+   * @param model    Needle model
+   * @param position Initial position and target
+   */
+  void needle_model_init(needle_model_t *model, float position);
+
+  /**
+   * Moves the target; wakes the model if the needle is not already there.
+   *
+   * @param model  Needle model
+   * @param target New target position
+   */
+  void needle_model_set_target(needle_model_t *model, float target);
+
+  /**
+   * Advances the model by the time that actually elapsed.
+   *
+   * The spring-damper equation is solved in closed form for the step, so the motion is the same
+   * whatever the frame rate and cannot go unstable on a late frame. Steps longer than
+   * NEEDLE_MAX_DT_S are clamped. Once displacement and velocity are both below NEEDLE_SETTLE_EPSILON the needle is
+   * snapped onto the target and the model reports settled, so the caller can stop its timer.
+   *
+   * @param model Needle model
+   * @param dt_s  Elapsed time in seconds
+   * @return      true while the needle is still moving, false once it has settled
+   */
+  bool needle_model_step(needle_model_t *model, float dt_s);
+
+#ifdef __cplusplus
+}
+#endif
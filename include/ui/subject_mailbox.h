@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/**
+ * @brief Latest-value mailbox slot for one UI subject.
+ *
+ * Producers overwrite the value and raise the pending flag without ever waiting; the consumer (the
+ * LVGL task) takes it at most once per frame, so a burst of posts collapses into one subject update.
+ * The value is published before the flag, and the flag is cleared before the value is read, so the
+ * consumer never misses the newest value; at worst it applies the same value twice.
+ */
+typedef struct
+{
+    atomic_uint value;   // Raw bits of the latest float or int32_t
+    atomic_bool pending; // Set by producers, cleared by the consumer
+} subject_slot_t;
+
+/**
+ * @brief Posts a float value, replacing any value not yet taken.
+ * @param slot Mailbox slot.
+ * @param value New value.
+ * @return true if a pending value was overwritten before the consumer took it.
+ */
+bool subject_slot_post_float(subject_slot_t *slot, float value);
+
+/**
+ * @brief Posts an integer value, replacing any value not yet taken.
+ * @param slot Mailbox slot.
+ * @param value New value.
+ * @return true if a pending value was overwritten before the consumer took it.
+ */
+bool subject_slot_post_int(subject_slot_t *slot, int32_t value);
+
+/**
+ * @brief Takes the pending float value, if any.
+ * @param slot Mailbox slot.
+ * @param value Receives the latest value.
+ * @return true if a value was pending.
+ */
+bool subject_slot_take_float(subject_slot_t *slot, float *value);
+
+/**
+ * @brief Takes the pending integer value, if any.
+ * @param slot Mailbox slot.
+ * @param value Receives the latest value.
+ * @return true if a value was pending.
+ */
+bool subject_slot_take_int(subject_slot_t *slot, int32_t *value);
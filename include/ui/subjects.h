@@ -12,7 +12,9 @@ extern "C"
  *
  * These subjects provide a clean separation between data sources and UI widgets.
  * In the UI simulator, they can be updated by mock data tasks.
- * On the device, they will be updated by actual sensor readings.
+ * On the device, the temperature, thermistor voltage/resistance, heater power, system state and fault
+ * subjects subscribe to the telemetry bus (telemetry_bus.h) in the LVGL context; the others are written
+ * through the setters below.
  */
 
 /* Heater temperature dial subject (0-120 range) */
@@ -30,6 +32,32 @@ extern lv_subject_t g_subject_fan_speed;
 /* System state subject (0=idle, 1=heating, 2=cooling, 3=error) */
 extern lv_subject_t g_subject_system_state;
 
+/* Current drying profile step subject (int, -1 when no profile is running) */
+extern lv_subject_t g_subject_profile_step;
+
+/* Remaining drying profile time subject (int, seconds) */
+extern lv_subject_t g_subject_profile_remaining;
+
+/* Latched heater fault subject (int, 0=none, 1=watchdog cutoff) */
+extern lv_subject_t g_subject_heater_fault;
+
+/* Heater energy of the current drying session subject (float, Wh) */
+extern lv_subject_t g_subject_energy_wh;
+
+/* Average heater power of the current drying session subject (float, W) */
+extern lv_subject_t g_subject_heater_avg_power;
+
+/* Heater power budget limiting subject (int, 1 while the heater output is being reduced) */
+extern lv_subject_t g_subject_power_limited;
+
+/* Thermistor ADC voltage subjects (float, V, -999 until a reading arrives or when it is invalid) */
+extern lv_subject_t g_subject_air_voltage;
+extern lv_subject_t g_subject_heater_voltage;
+
+/* Thermistor resistance subjects (float, ohm, -999 until a reading arrives or when it is invalid) */
+extern lv_subject_t g_subject_air_resistance;
+extern lv_subject_t g_subject_heater_resistance;
+
 /**
  * Initialize all UI subjects
  * Must be called before creating any UI widgets that bind to subjects
@@ -44,40 +72,47 @@ void subjects_deinit(void);
 
 /**
  * Thread-safe subject setters
- * These functions use LVGL port locking to ensure thread safety
- * when updating subjects from tasks other than the LVGL task.
+ * These functions post the value to a lock-free latest-value mailbox and return immediately;
+ * the LVGL task applies pending values to the subjects once per frame, so several updates
+ * between two frames produce a single observer notification carrying the newest value.
  * Always use these when updating subjects from sensor tasks or other FreeRTOS tasks.
  */
 
 /**
- * @brief Set heater temperature subject value (thread-safe)
- * @param temperature Heater temperature value in degrees Celsius
+ * @brief Set fan speed subject value (thread-safe)
+ * @param speed Fan speed as percentage (0-100)
  */
-void subjects_set_heater_temp(float temperature);
+void subjects_set_fan_speed(float speed);
 
 /**
- * @brief Set air temperature subject value (thread-safe)
- * @param temperature Air temperature value in degrees Celsius
+ * @brief Set current drying profile step subject value (thread-safe)
+ * @param step Zero-based step index, or -1 when no profile is running
  */
-void subjects_set_air_temp(float temperature);
+void subjects_set_profile_step(int step);
 
 /**
- * @brief Set heater power subject value (thread-safe)
- * @param power Power level as percentage (0-100)
+ * @brief Set remaining drying profile time subject value (thread-safe)
+ * @param seconds Estimated remaining time in seconds
  */
-void subjects_set_heater_power(float power);
+void subjects_set_profile_remaining(int seconds);
 
 /**
- * @brief Set fan speed subject value (thread-safe)
- * @param speed Fan speed as percentage (0-100)
+ * @brief Set session heater energy subject value (thread-safe)
+ * @param wh Energy in watt-hours since the drying session started
  */
-void subjects_set_fan_speed(float speed);
+void subjects_set_energy_wh(float wh);
+
+/**
+ * @brief Set session average heater power subject value (thread-safe)
+ * @param watts Average power in watts since the drying session started
+ */
+void subjects_set_heater_avg_power(float watts);
 
 /**
- * @brief Set system state subject value (thread-safe)
- * @param state System state (0=idle, 1=heating, 2=cooling, 3=error)
+ * @brief Set power budget limiting subject value (thread-safe)
+ * @param limited 1 while the power budget reduces the heater output, 0 otherwise
  */
-void subjects_set_system_state(float state);
+void subjects_set_power_limited(int limited);
 
 #ifdef __cplusplus
 }
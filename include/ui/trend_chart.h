@@ -0,0 +1,38 @@
+#pragma once
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Trend chart constants */
+#define TREND_CHART_WIDTH 160 /* One column per sample */
+#define TREND_CHART_HEIGHT 60
+#define TREND_CHART_MIN_VALUE 0.0f
+#define TREND_CHART_MAX_VALUE 120.0f
+#define TREND_CHART_GRID_STEP 20.0f
+
+  /**
+   * Creates a scrolling chart of air and heater temperature over the last window_s seconds.
+   *
+   * The chart is a canvas with one pixel column per window_s / TREND_CHART_WIDTH seconds. Each
+   * column shows the mean of the subject updates received during its interval; when a column is
+   * due the existing pixels move one column left and only the new column is drawn. The chart
+   * starts out empty and fills from the right as columns are pushed.
+   *
+   * The subjects must be float subjects that outlive the chart. Everything the chart allocates
+   * is released when the canvas is deleted.
+   *
+   * @param parent   Parent object for the chart
+   * @param air      Air temperature subject
+   * @param heater   Heater temperature subject
+   * @param window_s Time span shown, in seconds
+   * @return         The chart canvas, or NULL if its buffer could not be allocated
+   */
+  lv_obj_t *trend_chart_create(lv_obj_t *parent, lv_subject_t *air, lv_subject_t *heater, uint32_t window_s);
+
+#ifdef __cplusplus
+}
+#endif
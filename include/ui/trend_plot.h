@@ -0,0 +1,88 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define TREND_PLOT_MAX_SERIES 2
+
+/* Readings at or below this are the sensor code for "no reading" (-999) */
+#define TREND_PLOT_INVALID_THRESHOLD -998.0f
+
+  /**
+   * Scrolling line plot drawn straight into a 16-bit pixel buffer, one column per sample.
+   * Adding a sample moves the existing pixels one column left and draws only the new column,
+   * so the cost does not depend on how much history is on screen.
+   */
+  typedef struct
+  {
+    uint16_t *pixels; /* width x height pixels, stride pixels per row */
+    uint16_t width;
+    uint16_t height;
+    uint32_t stride;
+    float min_value; /* Value on the bottom row */
+    float max_value; /* Value on the top row */
+    float grid_step; /* Spacing of horizontal grid lines, 0 for none */
+    uint16_t background;
+    uint16_t grid;
+    uint8_t series_count;
+    uint16_t colors[TREND_PLOT_MAX_SERIES];
+    int16_t last_row[TREND_PLOT_MAX_SERIES]; /* Row of the newest point, -1 after a gap */
+  } trend_plot_t;
+
+  /**
+   * Sets up a plot over a pixel buffer with no series, no grid and a black background.
+   * Call trend_plot_clear() after adjusting the colors.
+   *
+   * @param plot      Plot state
+   * @param pixels    Pixel buffer, RGB565
+   * @param width     Columns, one per sample
+   * @param height    Rows
+   * @param stride    Pixels per buffer row (>= width)
+   * @param min_value Value on the bottom row
+   * @param max_value Value on the top row
+   */
+  void trend_plot_init(trend_plot_t *plot, uint16_t *pixels, uint16_t width, uint16_t height, uint32_t stride,
+                       float min_value, float max_value);
+
+  /**
+   * Adds a series; values are passed to trend_plot_push() in the order series were added.
+   *
+   * @param plot  Plot state
+   * @param color Line color
+   * @return      false if TREND_PLOT_MAX_SERIES are already in use
+   */
+  bool trend_plot_add_series(trend_plot_t *plot, uint16_t color);
+
+  /**
+   * Fills the buffer with background and grid and forgets the newest points.
+   *
+   * @param plot Plot state
+   */
+  void trend_plot_clear(trend_plot_t *plot);
+
+  /**
+   * Maps a value to its row, clamped to the plot.
+   *
+   * @param plot  Plot state
+   * @param value Value to map
+   * @return      Row (0 at the top), -1 for NaN and missing readings (<= -998)
+   */
+  int16_t trend_plot_row(const trend_plot_t *plot, float value);
+
+  /**
+   * Scrolls the plot one column left and draws one sample per series in the rightmost column,
+   * joined to the previous sample by a vertical run. NaN leaves a gap.
+   *
+   * @param plot   Plot state
+   * @param values One value per series
+   */
+  void trend_plot_push(trend_plot_t *plot, const float *values);
+
+#ifdef __cplusplus
+}
+#endif
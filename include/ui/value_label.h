@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdint.h>
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  /**
+   * Creates a label bound to a float subject.
+   *
+   * The label shows prefix + (value * scale) with the given number of decimals + suffix, or
+   * prefix + "--" + suffix while the subject holds no valid reading (-999). It is updated from the
+   * subject's observer only, and the text is rebuilt only when the displayed digits change, so
+   * sensor noise below the last decimal costs nothing.
+   *
+   * @param parent   Parent object
+   * @param subject  Float subject to display; must outlive the label
+   * @param prefix   Text before the value (may be NULL); must stay valid, e.g. a string literal
+   * @param suffix   Text after the value (may be NULL); must stay valid, e.g. a string literal
+   * @param decimals Decimals shown
+   * @param scale    Factor applied before display (1 for none)
+   * @return         The label
+   */
+  lv_obj_t *value_label_create(lv_obj_t *parent, lv_subject_t *subject, const char *prefix, const char *suffix,
+                               uint8_t decimals, float scale);
+
+#ifdef __cplusplus
+}
+#endif
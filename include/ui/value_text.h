@@ -0,0 +1,46 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Quantized value of a missing reading; formats as "--" */
+#define VALUE_TEXT_INVALID INT32_MIN
+
+/* Readings at or below this are the sensor code for "no reading" (-999) */
+#define VALUE_TEXT_INVALID_THRESHOLD -998.0f
+
+  /**
+   * Converts a value to the integer that is actually displayed: value * scale in units of the last
+   * shown decimal, rounded (23.46 with 1 decimal gives 235). Two values with the same result render
+   * the same text, so a label only needs to be rewritten when this changes.
+   *
+   * @param value    Reading
+   * @param scale    Factor applied before display (e.g. 0.001 to show ohms as kilo-ohms)
+   * @param decimals Decimals shown, 0-6
+   * @return         Displayed integer, VALUE_TEXT_INVALID for missing readings and NaN
+   */
+  int32_t value_text_quantize(float value, float scale, uint8_t decimals);
+
+  /**
+   * Formats a quantized value as prefix + digits + suffix, or prefix + "--" + suffix when invalid.
+   * Uses integer formatting only.
+   *
+   * @param buf       Output buffer
+   * @param len       Size of buf
+   * @param quantized Value from value_text_quantize()
+   * @param decimals  Decimals the value was quantized with
+   * @param prefix    Text before the value (may be NULL)
+   * @param suffix    Text after the value (may be NULL)
+   * @return          Length as snprintf
+   */
+  int value_text_format(char *buf, size_t len, int32_t quantized, uint8_t decimals, const char *prefix,
+                        const char *suffix);
+
+#ifdef __cplusplus
+}
+#endif
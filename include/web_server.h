@@ -4,13 +4,11 @@
 #include <stddef.h>
 #include "esp_err.h"
 #include "esp_http_server.h"
+#include "heater_energy.h"
 
 // Global server handle
 extern httpd_handle_t server;
 
-// Function to broadcast latest sensor reading to all WebSocket clients
-void ws_broadcast_latest_sensor_data(void);
-
 // Internal function to broadcast temperature data
 void ws_broadcast_data(const char *sensor, float temperature);
 
@@ -23,3 +21,17 @@ bool custom_uri_match(const char *reference_uri, const char *uri_to_match, size_
 esp_err_t version_handler(httpd_req_t *req);
 esp_err_t static_file_handler(httpd_req_t *req);
 esp_err_t sensor_data_handler(httpd_req_t *req);
+esp_err_t profile_list_handler(httpd_req_t *req);
+esp_err_t profile_get_handler(httpd_req_t *req);
+esp_err_t profile_upload_handler(httpd_req_t *req);
+esp_err_t profile_start_handler(httpd_req_t *req);
+esp_err_t profile_stop_handler(httpd_req_t *req);
+esp_err_t autotune_start_handler(httpd_req_t *req);
+esp_err_t trace_handler(httpd_req_t *req);
+esp_err_t sensors_handler(httpd_req_t *req);
+esp_err_t energy_handler(httpd_req_t *req);
+esp_err_t telemetry_handler(httpd_req_t *req);
+esp_err_t display_profile_handler(httpd_req_t *req);
+
+// Formats an energy session summary as a JSON object; returns the length as snprintf
+int web_format_energy_session(char *buf, size_t len, const energy_session_t *session);
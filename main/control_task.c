@@ -0,0 +1,629 @@
+#include "control_task.h"
+#include "heater_controller.h"
+#include "heater_watchdog.h"
+#include "heater.h"
+#include "controller_config_store.h"
+#include "heater_energy.h"
+#include "energy_session_store.h"
+#include "temp.h"
+#include "sysmon_wrapper.h"
+#include "ui/subjects.h"
+#include "telemetry_bus.h"
+#ifdef CONFIG_ENABLE_FAN
+#include "fan.h"
+#include "fan_control.h"
+#endif
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include <stdatomic.h>
+#include <string.h>
+#include <time.h>
+
+static const char *TAG = "CONTROL_TASK";
+
+#define MIN_VALID_EPOCH 1735689600 // 2025-01-01; anything earlier means SNTP has not synced
+
+_Static_assert(PROFILE_SETPOINT_MAX < CONTROL_MAX_HEATER_TEMP, "profile setpoints must leave the element headroom");
+
+static const controller_config_t s_controller_config = {
+    .max_heater_temp = CONTROL_MAX_HEATER_TEMP,
+    .air_temp_hysteresis = CONTROL_AIR_TEMP_HYSTERESIS,
+    .heater_temp_hysteresis = CONTROL_HEATER_TEMP_HYSTERESIS,
+    .full_power_delta = CONTROL_FULL_POWER_DELTA,
+    .ramp_rate = CONTROL_RAMP_RATE,
+    .ramp_accel = CONTROL_RAMP_ACCEL,
+    .control_period_s = CONTROL_PERIOD_MS / 1000.0f,
+    .runaway_window_s = CONTROL_RUNAWAY_WINDOW_S,
+    .runaway_min_rise = CONTROL_RUNAWAY_MIN_RISE,
+    .runaway_idle_max_rise = CONTROL_RUNAWAY_IDLE_MAX_RISE,
+};
+
+static TaskHandle_t s_control_task_handle = NULL;
+static controller_handle_t s_zone = NULL; // Heating zone driven by the drying profile
+static const float s_autotune_setpoints[] = CONTROL_AUTOTUNE_SETPOINTS;
+static SemaphoreHandle_t s_profile_mutex = NULL; // Guards s_runner against HTTP handlers
+static profile_runner_t s_runner;
+static esp_timer_handle_t s_watchdog_timer = NULL;
+static heater_energy_t s_energy;   // Energy of the running session, guarded by s_profile_mutex
+static energy_session_t s_session; // Profile name and start time of the running session
+static bool s_session_active = false;
+static atomic_int s_fault_code; // Last published CONTROL_FAULT_* (the watchdog reports from the esp_timer task)
+
+#ifdef CONFIG_ENABLE_FAN
+static const fan_control_config_t s_fan_config = {
+    .max_rpm = CONTROL_FAN_MAX_RPM,
+    .pulses_per_rev = FAN_TACH_PULSES_PER_REV,
+    .min_duty = CONTROL_FAN_MIN_DUTY,
+    .kp = CONTROL_FAN_KP,
+    .ki = CONTROL_FAN_KI,
+    .stall_rpm = CONTROL_FAN_STALL_RPM,
+    .stall_time_ms = CONTROL_FAN_STALL_TIME_MS,
+    .spinup_ms = CONTROL_FAN_SPINUP_MS,
+};
+static fan_control_t s_fan; // Only touched by the control task (the interlock runs inside controller_step_all)
+#endif
+
+static uint32_t now_seconds(void)
+{
+    return (uint32_t)(esp_timer_get_time() / 1000000);
+}
+
+/**
+ * @brief Advances the drying profile and hands the ramped setpoint to the controller
+ * @param air_temp Current air temperature
+ */
+static void profile_step(float air_temp)
+{
+    static int s_published_step = -1;
+    static int s_published_remaining = -1;
+
+    int step = -1;
+    int remaining = 0;
+
+    xSemaphoreTake(s_profile_mutex, portMAX_DELAY);
+    if (s_runner.running)
+    {
+        uint32_t now_s = now_seconds();
+        if (profile_runner_tick(&s_runner, air_temp, now_s))
+        {
+            controller_instance_set_target_temp(s_zone, s_runner.setpoint);
+            step = s_runner.step;
+            remaining = (int)profile_runner_remaining_s(&s_runner, now_s);
+        }
+        else
+        {
+            ESP_LOGI(TAG, "Profile %s finished", s_runner.profile.name);
+            controller_instance_set_active(s_zone, false);
+        }
+    }
+    xSemaphoreGive(s_profile_mutex);
+
+    // Only post to the subjects when the displayed values change
+    if (step != s_published_step)
+    {
+        s_published_step = step;
+        subjects_set_profile_step(step);
+    }
+    if (remaining != s_published_remaining)
+    {
+        s_published_remaining = remaining;
+        subjects_set_profile_remaining(remaining);
+    }
+}
+
+// Starts energy accounting for a profile run; must be called with s_profile_mutex held
+static void session_begin_locked(const char *profile)
+{
+    heater_energy_reset(&s_energy, HEATER_DUTY_MAX, heater_get_duty(), esp_timer_get_time());
+    memset(&s_session, 0, sizeof(s_session));
+    strlcpy(s_session.profile, profile, sizeof(s_session.profile));
+    time_t now = time(NULL);
+    s_session.start_time = now >= MIN_VALID_EPOCH ? (uint32_t)now : 0;
+    s_session_active = true;
+}
+
+/**
+ * @brief Integrates the running session up to now and refreshes its summary
+ * Must be called with s_profile_mutex held.
+ * @return false if no session is running
+ */
+static bool session_update_locked(void)
+{
+    if (!s_session_active)
+    {
+        return false;
+    }
+    heater_energy_update(&s_energy, heater_get_duty(), esp_timer_get_time());
+    heater_energy_summarize(&s_energy, HEATER_ENERGY_DEFAULT_WATTS, &s_session);
+    return true;
+}
+
+/**
+ * @brief Accounts the heater duty applied this period and closes the session when its profile ended
+ * The finished session is persisted outside the mutex; NVS writes can take tens of milliseconds.
+ */
+static void energy_step(void)
+{
+    static int s_published_deci_wh = -1; // 0.1 Wh steps
+    static int s_published_avg_w = -1;
+
+    energy_session_t finished;
+    bool ended = false;
+
+    xSemaphoreTake(s_profile_mutex, portMAX_DELAY);
+    bool running = session_update_locked();
+    if (running && !s_runner.running)
+    {
+        finished = s_session;
+        s_session_active = false;
+        ended = true;
+    }
+    energy_session_t session = s_session;
+    xSemaphoreGive(s_profile_mutex);
+
+    if (!running)
+    {
+        return; // Subjects keep showing the last session
+    }
+    if (ended)
+    {
+        ESP_LOGI(TAG, "Session %s used %.1f Wh (avg %.0f W)", finished.profile, finished.energy_wh,
+                 finished.avg_power_w);
+        energy_session_save(&finished);
+    }
+
+    int deci_wh = (int)(session.energy_wh * 10.0f + 0.5f);
+    int avg_w = (int)(session.avg_power_w + 0.5f);
+    if (deci_wh != s_published_deci_wh)
+    {
+        s_published_deci_wh = deci_wh;
+        subjects_set_energy_wh(deci_wh / 10.0f);
+    }
+    if (avg_w != s_published_avg_w)
+    {
+        s_published_avg_w = avg_w;
+        subjects_set_heater_avg_power((float)avg_w);
+    }
+}
+
+// Reports when the power budget starts or stops reducing the heater output
+static void power_limit_check(void)
+{
+    static int s_published_limited = 0;
+
+    int limited = heater_power_limited() ? 1 : 0;
+    if (limited != s_published_limited)
+    {
+        s_published_limited = limited;
+        ESP_LOGI(TAG, "Heater power budget %s", limited ? "limiting" : "released");
+        subjects_set_power_limited(limited);
+    }
+}
+
+// Persists the tuned schedule once an auto-tune run ends
+static void autotune_check_finished(void)
+{
+    static bool s_was_autotuning = false;
+
+    controller_snapshot_t snapshot;
+    if (!controller_get_snapshot(s_zone, &snapshot))
+    {
+        return;
+    }
+
+    if (s_was_autotuning && !snapshot.autotuning)
+    {
+        controller_config_t config;
+        if (controller_instance_get_config(s_zone, &config))
+        {
+            controller_schedule_save(&config.schedule);
+        }
+    }
+    s_was_autotuning = snapshot.autotuning;
+}
+
+// Reports a heater fault code (CONTROL_FAULT_*) to every telemetry subscriber
+static void publish_fault(int fault)
+{
+    atomic_store(&s_fault_code, fault);
+    telemetry_publish(TELEMETRY_TOPIC_FAULT, (float)fault);
+}
+
+// Runs in the esp_timer task, independent of the control task
+static void watchdog_timer_callback(void *arg)
+{
+    heater_watchdog_check();
+}
+
+static void watchdog_tripped(void)
+{
+    publish_fault(CONTROL_FAULT_WATCHDOG);
+}
+
+/**
+ * @brief Arms the heater watchdog and the esp_timer that checks it
+ * @return ESP_OK on success
+ */
+static esp_err_t watchdog_start(void)
+{
+    const heater_watchdog_config_t watchdog_config = {
+        .timeout_ms = CONTROL_WATCHDOG_TIMEOUT_MS,
+        .cutoff = heater_force_off,
+        .on_trip = watchdog_tripped,
+    };
+    if (!heater_watchdog_init(&watchdog_config))
+    {
+        return ESP_FAIL;
+    }
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = watchdog_timer_callback,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "heater_wdt",
+    };
+    esp_err_t ret = esp_timer_create(&timer_args, &s_watchdog_timer);
+    if (ret == ESP_OK)
+    {
+        ret = esp_timer_start_periodic(s_watchdog_timer, CONTROL_WATCHDOG_CHECK_MS * 1000);
+    }
+    return ret;
+}
+
+// Publishes a thermal protection fault latched by the controller
+static void fault_check(void)
+{
+    static controller_fault_t s_published_fault = CONTROLLER_FAULT_NONE;
+
+    controller_snapshot_t snapshot;
+    if (!controller_get_snapshot(s_zone, &snapshot) || snapshot.fault == s_published_fault)
+    {
+        return;
+    }
+    s_published_fault = snapshot.fault;
+    if (snapshot.fault == CONTROLLER_FAULT_NONE)
+    {
+        return; // Cleared by clear_heater_faults(), which already reset the subject
+    }
+
+    // The controller already holds the heater off; stop the profile so it does not look like it is running
+    xSemaphoreTake(s_profile_mutex, portMAX_DELAY);
+    profile_runner_stop(&s_runner);
+    xSemaphoreGive(s_profile_mutex);
+    publish_fault(snapshot.fault == CONTROLLER_FAULT_HEATING_FAILED ? CONTROL_FAULT_HEATING_FAILED
+                                                                    : CONTROL_FAULT_RUNAWAY);
+}
+
+// Starting a run acknowledges a latched fault; a fault that persists trips again
+static void clear_heater_faults(void)
+{
+    controller_snapshot_t snapshot;
+    bool controller_fault = controller_get_snapshot(s_zone, &snapshot) && snapshot.fault != CONTROLLER_FAULT_NONE;
+    bool watchdog_fault = heater_watchdog_tripped();
+
+    if (controller_fault)
+    {
+        controller_instance_clear_fault(s_zone);
+    }
+    if (watchdog_fault)
+    {
+        heater_watchdog_clear();
+        heater_clear_force_off();
+    }
+    if (controller_fault || watchdog_fault)
+    {
+        publish_fault(CONTROL_FAULT_NONE);
+    }
+}
+
+#ifdef CONFIG_ENABLE_FAN
+// Heater interlock: no heat without airflow
+static bool fan_interlock(void *ctx)
+{
+    (void)ctx;
+    return fan_control_airflow_ok(&s_fan, &s_fan_config);
+}
+
+/**
+ * @brief Runs the fan speed loop for one control period
+ * The fan runs while the zone is heating or tuning and keeps running until the element has cooled.
+ * @param heater_temp Current heater temperature
+ * @param heater_temp_valid False if the heater sensor has no usable reading
+ */
+static void fan_step(float heater_temp, bool heater_temp_valid)
+{
+    static int64_t s_last_us = 0;
+    static int s_published_speed = -1;
+    static bool s_published_stall = false;
+
+    controller_snapshot_t snapshot;
+    bool demand = controller_get_snapshot(s_zone, &snapshot) && (snapshot.active || snapshot.autotuning);
+    bool hot = !heater_temp_valid || heater_temp > CONTROL_FAN_COOLDOWN_TEMP; // Unknown counts as hot
+    fan_control_set_target(&s_fan, &s_fan_config, (demand || hot) ? CONTROL_FAN_RPM : 0);
+
+    int64_t now_us = esp_timer_get_time();
+    uint32_t elapsed_ms = s_last_us == 0 ? CONTROL_PERIOD_MS : (uint32_t)((now_us - s_last_us) / 1000);
+    s_last_us = now_us;
+    fan_set_duty(fan_control_update(&s_fan, &s_fan_config, fan_read_tach_pulses(), elapsed_ms));
+
+    int speed = (int)((uint32_t)s_fan.rpm * 100 / CONTROL_FAN_MAX_RPM);
+    if (speed > 100)
+    {
+        speed = 100;
+    }
+    if (speed != s_published_speed)
+    {
+        s_published_speed = speed;
+        subjects_set_fan_speed((float)speed);
+    }
+
+    if (s_fan.stalled != s_published_stall)
+    {
+        s_published_stall = s_fan.stalled;
+        // A recovered fan only clears the indication if nothing more serious is latched
+        if (s_fan.stalled)
+        {
+            publish_fault(CONTROL_FAULT_FAN_STALLED);
+        }
+        else if (snapshot.fault == CONTROLLER_FAULT_NONE && !heater_watchdog_tripped())
+        {
+            publish_fault(CONTROL_FAULT_NONE);
+        }
+    }
+}
+#endif
+
+/**
+ * @brief Publishes heater power and system state when they change
+ * @param heater_temp Current heater temperature
+ * @param heater_temp_valid False if the heater sensor has no usable reading
+ */
+static void telemetry_step(float heater_temp, bool heater_temp_valid)
+{
+    static int s_published_power = -1;
+    static int s_published_state = -1;
+
+    controller_snapshot_t snapshot;
+    if (!controller_get_snapshot(s_zone, &snapshot))
+    {
+        return;
+    }
+
+    int power = (snapshot.power * 100 + 127) / 255;
+    if (power != s_published_power)
+    {
+        s_published_power = power;
+        telemetry_publish(TELEMETRY_TOPIC_POWER, (float)power);
+    }
+
+    // 0=idle, 1=heating, 2=cooling (element still hot), 3=error
+    int state = 0;
+    if (atomic_load(&s_fault_code) != CONTROL_FAULT_NONE)
+    {
+        state = 3;
+    }
+    else if (snapshot.power > 0)
+    {
+        state = 1;
+    }
+    else if (heater_temp_valid && heater_temp > CONTROL_FAN_COOLDOWN_TEMP)
+    {
+        state = 2;
+    }
+    if (state != s_published_state)
+    {
+        s_published_state = state;
+        telemetry_publish(TELEMETRY_TOPIC_STATE, (float)state);
+    }
+}
+
+static void control_task(void *pvParameters)
+{
+    TickType_t last_wake = xTaskGetTickCount();
+
+    while (1)
+    {
+        // Telemetry subscribers that run in the control task
+        telemetry_dispatch(TELEMETRY_CONTEXT_CONTROL);
+
+        float air_temp = 0.0f;
+        if (temp_sensor_read_ok(temp_sensor_get_air_sensor(), &air_temp))
+        {
+            profile_step(air_temp);
+        }
+
+        temp_sample_t heater_sample;
+        bool heater_temp_valid = temp_sensor_get_usable_sample(temp_sensor_get_heater_sensor(), &heater_sample);
+        float heater_temp = heater_temp_valid ? heater_sample.temperature : 0.0f;
+
+#ifdef CONFIG_ENABLE_FAN
+        // Before the controller so its interlock sees this period's fan speed
+        fan_step(heater_temp, heater_temp_valid);
+#endif
+
+        // Each zone reads its own sensors and forces its heater off when they are unavailable
+        controller_step_all();
+
+        // Meters the duty the controller left in place, cutting it back once the budget is spent
+        heater_tick();
+
+        // Proves to the watchdog that the loop is alive and ran on a new heater reading
+        if (heater_temp_valid)
+        {
+            heater_watchdog_feed(heater_temp, heater_sample.sequence);
+        }
+
+        energy_step();
+        power_limit_check();
+        autotune_check_finished();
+        fault_check();
+        telemetry_step(heater_temp, heater_temp_valid);
+
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(CONTROL_PERIOD_MS));
+    }
+}
+
+esp_err_t control_task_start(void)
+{
+    s_profile_mutex = xSemaphoreCreateMutex();
+    if (s_profile_mutex == NULL)
+    {
+        ESP_LOGE(TAG, "Failed to create profile mutex");
+        return ESP_FAIL;
+    }
+
+    // Only the auto-tuned schedule is persisted; limits always come from this firmware
+    controller_config_t params = s_controller_config;
+    if (controller_schedule_load(&params.schedule) != ESP_OK)
+    {
+        ESP_LOGI(TAG, "No stored gain schedule, using defaults");
+    }
+
+    controller_instance_config_t zone_config = {
+        .name = "main",
+        .params = params,
+        .initial_target_temp = 0.0f,
+        .air_sensor = temp_sensor_get_air_sensor(),
+        .heater_sensor = temp_sensor_get_heater_sensor(),
+        .set_power = NULL, // Board heater on LEDC channel 0
+    };
+#ifdef CONFIG_ENABLE_FAN
+    fan_control_reset(&s_fan);
+    zone_config.interlock = fan_interlock;
+#endif
+    s_zone = controller_create(&zone_config);
+    if (s_zone == NULL)
+    {
+        ESP_LOGE(TAG, "Failed to create heater controller");
+        return ESP_FAIL;
+    }
+
+    // Start inactive: the heater only runs once a drying profile is started
+    controller_instance_set_active(s_zone, false);
+
+    if (watchdog_start() != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to start heater watchdog");
+        return ESP_FAIL;
+    }
+
+    BaseType_t result = sysmon_xTaskCreate(
+        control_task,
+        "control_task",
+        CONTROL_TASK_STACK_SIZE,
+        NULL,
+        CONTROL_TASK_PRIORITY,
+        &s_control_task_handle);
+
+    if (result != pdPASS)
+    {
+        ESP_LOGE(TAG, "Failed to create control task");
+        return ESP_FAIL;
+    }
+
+    ESP_LOGI(TAG, "Control task started (period %d ms)", CONTROL_PERIOD_MS);
+    return ESP_OK;
+}
+
+esp_err_t control_start_profile(const drying_profile_t *profile)
+{
+    if (profile == NULL || profile->step_count == 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Ramp from the current air temperature; fall back to jumping straight to the first step
+    float air_temp = profile->steps[0].setpoint;
+    temp_sensor_read_ok(temp_sensor_get_air_sensor(), &air_temp);
+
+    controller_instance_cancel_autotune(s_zone);
+
+    clear_heater_faults();
+
+    // energy_step() cannot tell a replaced run from a continuing one, so close the old session here
+    energy_session_t replaced;
+    xSemaphoreTake(s_profile_mutex, portMAX_DELAY);
+    bool save_replaced = session_update_locked();
+    if (save_replaced)
+    {
+        replaced = s_session;
+    }
+    profile_runner_start(&s_runner, profile, air_temp, now_seconds());
+    session_begin_locked(profile->name);
+    controller_instance_set_target_temp(s_zone, s_runner.setpoint);
+    controller_instance_set_active(s_zone, true);
+    xSemaphoreGive(s_profile_mutex);
+
+    if (save_replaced)
+    {
+        energy_session_save(&replaced);
+    }
+    subjects_set_energy_wh(0.0f);
+    subjects_set_heater_avg_power(0.0f);
+
+    ESP_LOGI(TAG, "Started profile %s (%u steps)", profile->name, profile->step_count);
+    return ESP_OK;
+}
+
+void control_stop_profile(void)
+{
+    xSemaphoreTake(s_profile_mutex, portMAX_DELAY);
+    profile_runner_stop(&s_runner);
+    controller_instance_cancel_autotune(s_zone);
+    controller_instance_set_active(s_zone, false);
+    xSemaphoreGive(s_profile_mutex);
+
+    ESP_LOGI(TAG, "Profile stopped");
+}
+
+void control_get_profile_status(profile_status_t *status)
+{
+    if (status == NULL)
+    {
+        return;
+    }
+
+    xSemaphoreTake(s_profile_mutex, portMAX_DELAY);
+    status->running = s_runner.running;
+    memcpy(status->name, s_runner.profile.name, PROFILE_NAME_MAX);
+    status->step = s_runner.step;
+    status->step_count = s_runner.profile.step_count;
+    status->setpoint = s_runner.setpoint;
+    status->remaining_s = profile_runner_remaining_s(&s_runner, now_seconds());
+    xSemaphoreGive(s_profile_mutex);
+}
+
+bool control_get_energy_session(energy_session_t *session)
+{
+    if (session == NULL)
+    {
+        return false;
+    }
+
+    xSemaphoreTake(s_profile_mutex, portMAX_DELAY);
+    bool running = session_update_locked();
+    if (running)
+    {
+        *session = s_session;
+    }
+    xSemaphoreGive(s_profile_mutex);
+    return running;
+}
+
+esp_err_t control_start_autotune(void)
+{
+    // Tuning owns the heater; a running profile would fight it for the setpoint
+    xSemaphoreTake(s_profile_mutex, portMAX_DELAY);
+    profile_runner_stop(&s_runner);
+    xSemaphoreGive(s_profile_mutex);
+
+    clear_heater_faults();
+    if (!controller_instance_start_autotune(s_zone, s_autotune_setpoints,
+                                            sizeof(s_autotune_setpoints) / sizeof(s_autotune_setpoints[0])))
+    {
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,176 @@
+#include "controller_autotune.h"
+#include "esp_log.h"
+#include <string.h>
+
+static const char *TAG = "AUTOTUNE";
+
+static float clampf(float value, float min, float max)
+{
+    return value < min ? min : (value > max ? max : value);
+}
+
+// Resets the per-setpoint measurements and starts heating toward setpoints[index]
+static void begin_setpoint(autotune_t *at, uint8_t index)
+{
+    at->index = index;
+    at->phase = AUTOTUNE_HEATING;
+    at->elapsed_s = 0.0f;
+    at->heater_on = true;
+    at->coasting = false;
+    at->coast = 0.0f;
+    at->cycles = 0;
+    at->overshoot_sum = 0.0f;
+    at->undershoot_sum = 0.0f;
+    at->overshoot_n = 0;
+    at->undershoot_n = 0;
+    at->on_time_s = 0.0f;
+    at->relay_time_s = 0.0f;
+}
+
+bool autotune_start(autotune_t *at, const float *setpoints, uint8_t count)
+{
+    if (at == NULL || setpoints == NULL || count == 0 || count > CONTROLLER_SCHEDULE_MAX_POINTS)
+    {
+        return false;
+    }
+    for (uint8_t i = 1; i < count; i++)
+    {
+        if (setpoints[i] <= setpoints[i - 1])
+        {
+            return false; // Schedule lookup needs ascending setpoints
+        }
+    }
+
+    memset(at, 0, sizeof(*at));
+    memcpy(at->setpoints, setpoints, count * sizeof(float));
+    at->count = count;
+    begin_setpoint(at, 0);
+    ESP_LOGI(TAG, "Auto-tune started, %u setpoint(s), first %.1fC", count, setpoints[0]);
+    return true;
+}
+
+void autotune_compute_point(float setpoint, float coast, float lag, float duty, controller_schedule_point_t *point)
+{
+    point->setpoint = setpoint;
+    // The air already swings `lag` past the switching band, so narrow the band by that much
+    point->air_temp_hysteresis = clampf(AUTOTUNE_TARGET_SWING - lag, 0.2f, 3.0f);
+    // Only engage full power when a full-power burst's coast cannot carry the air past the target
+    point->full_power_delta = clampf(coast + point->air_temp_hysteresis, 2.0f, 15.0f);
+    // High-duty setpoints run the element near its limit; a wider band avoids chattering there
+    point->heater_temp_hysteresis = clampf(2.0f + 6.0f * duty, 2.0f, 8.0f);
+}
+
+// Records the result for the current setpoint and moves on to the next one
+static void finish_setpoint(autotune_t *at)
+{
+    float overshoot = at->overshoot_n ? at->overshoot_sum / at->overshoot_n : 0.0f;
+    float undershoot = at->undershoot_n ? at->undershoot_sum / at->undershoot_n : 0.0f;
+    float lag = overshoot > undershoot ? overshoot : undershoot;
+    float duty = at->relay_time_s > 0.0f ? at->on_time_s / at->relay_time_s : 0.0f;
+
+    controller_schedule_point_t *point = &at->result.points[at->index];
+    autotune_compute_point(at->setpoints[at->index], at->coast, lag, duty, point);
+    at->result.count = at->index + 1;
+
+    ESP_LOGI(TAG, "Setpoint %.1fC: coast %.2fC lag %.2fC duty %.0f%% -> air hyst %.2f heater hyst %.2f delta %.2f",
+             point->setpoint, at->coast, lag, duty * 100.0f,
+             point->air_temp_hysteresis, point->heater_temp_hysteresis, point->full_power_delta);
+
+    if (at->index + 1 < at->count)
+    {
+        begin_setpoint(at, at->index + 1);
+    }
+    else
+    {
+        at->phase = AUTOTUNE_DONE;
+        at->heater_on = false;
+        ESP_LOGI(TAG, "Auto-tune complete");
+    }
+}
+
+uint8_t autotune_step(autotune_t *at, float air_temp, float dt_s)
+{
+    if (at == NULL || (at->phase != AUTOTUNE_HEATING && at->phase != AUTOTUNE_RELAY))
+    {
+        return 0;
+    }
+
+    at->elapsed_s += dt_s;
+    if (at->elapsed_s > AUTOTUNE_TIMEOUT_S)
+    {
+        ESP_LOGE(TAG, "Auto-tune timed out at %.1fC", at->setpoints[at->index]);
+        at->phase = AUTOTUNE_FAILED;
+        at->heater_on = false;
+        return 0;
+    }
+
+    float setpoint = at->setpoints[at->index];
+    float low = setpoint - AUTOTUNE_RELAY_HYSTERESIS;
+    float high = setpoint + AUTOTUNE_RELAY_HYSTERESIS;
+
+    if (at->phase == AUTOTUNE_HEATING)
+    {
+        if (!at->coasting)
+        {
+            if (air_temp < low)
+            {
+                return 255;
+            }
+            at->coasting = true;
+            at->heater_on = false;
+            at->coast_start = air_temp;
+            at->coast_peak = air_temp;
+            return 0;
+        }
+
+        // Coast ends once the air turns around (or drops back below the band)
+        if (air_temp > at->coast_peak)
+        {
+            at->coast_peak = air_temp;
+            return 0;
+        }
+        if (air_temp > at->coast_peak - 0.1f && air_temp >= low)
+        {
+            return 0;
+        }
+
+        at->coast = at->coast_peak - at->coast_start;
+        at->phase = AUTOTUNE_RELAY;
+        at->heater_on = air_temp < low;
+        at->air_min = air_temp;
+        at->air_max = air_temp;
+    }
+
+    // Relay phase
+    at->relay_time_s += dt_s;
+    if (at->heater_on)
+    {
+        at->on_time_s += dt_s;
+        at->air_min = air_temp < at->air_min ? air_temp : at->air_min;
+        if (air_temp > high)
+        {
+            at->heater_on = false;
+            at->undershoot_sum += (low - at->air_min) > 0.0f ? (low - at->air_min) : 0.0f;
+            at->undershoot_n++;
+            at->air_max = air_temp;
+        }
+    }
+    else
+    {
+        at->air_max = air_temp > at->air_max ? air_temp : at->air_max;
+        if (air_temp < low)
+        {
+            at->heater_on = true;
+            at->overshoot_sum += (at->air_max - high) > 0.0f ? (at->air_max - high) : 0.0f;
+            at->overshoot_n++;
+            at->air_min = air_temp;
+            if (++at->cycles >= AUTOTUNE_RELAY_CYCLES)
+            {
+                finish_setpoint(at);
+                return at->phase == AUTOTUNE_DONE ? 0 : 255;
+            }
+        }
+    }
+
+    return at->heater_on ? 255 : 0;
+}
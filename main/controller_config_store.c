@@ -0,0 +1,111 @@
+#include "controller_config_store.h"
+#include "nvs.h"
+#include "esp_log.h"
+#include <math.h>
+
+static const char *TAG = "CONTROLLER_NVS";
+
+// Stored blob: the version guards against reading a schedule written by an older layout
+typedef struct
+{
+    uint32_t version;
+    controller_gain_schedule_t schedule;
+} stored_controller_schedule_t;
+
+// Rejects a corrupted blob: counts past the table and non-positive or unsorted entries
+static bool schedule_valid(const controller_gain_schedule_t *schedule)
+{
+    if (schedule->count > CONTROLLER_SCHEDULE_MAX_POINTS)
+    {
+        return false;
+    }
+    for (int i = 0; i < schedule->count; i++)
+    {
+        const controller_schedule_point_t *p = &schedule->points[i];
+        if (!isfinite(p->setpoint) || !(p->air_temp_hysteresis > 0.0f) ||
+            !(p->heater_temp_hysteresis > 0.0f) || !(p->full_power_delta >= 0.0f))
+        {
+            return false;
+        }
+        if (i > 0 && !(p->setpoint > schedule->points[i - 1].setpoint))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+esp_err_t controller_schedule_load(controller_gain_schedule_t *schedule)
+{
+    if (schedule == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    nvs_handle_t handle;
+    esp_err_t ret = nvs_open(CONTROLLER_NVS_NAMESPACE, NVS_READONLY, &handle);
+    if (ret != ESP_OK)
+    {
+        return ret; // ESP_ERR_NVS_NOT_FOUND until the first save
+    }
+
+    stored_controller_schedule_t stored;
+    size_t size = sizeof(stored);
+    ret = nvs_get_blob(handle, CONTROLLER_NVS_KEY, &stored, &size);
+    nvs_close(handle);
+
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+    if (size != sizeof(stored) || stored.version != CONTROLLER_SCHEDULE_VERSION)
+    {
+        ESP_LOGW(TAG, "Ignoring stored gain schedule (version %lu, %u bytes)",
+                 (unsigned long)stored.version, (unsigned)size);
+        return ESP_ERR_INVALID_VERSION;
+    }
+    if (!schedule_valid(&stored.schedule))
+    {
+        ESP_LOGW(TAG, "Ignoring invalid stored gain schedule");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    *schedule = stored.schedule;
+    ESP_LOGI(TAG, "Loaded gain schedule with %u point(s)", schedule->count);
+    return ESP_OK;
+}
+
+esp_err_t controller_schedule_save(const controller_gain_schedule_t *schedule)
+{
+    if (schedule == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    nvs_handle_t handle;
+    esp_err_t ret = nvs_open(CONTROLLER_NVS_NAMESPACE, NVS_READWRITE, &handle);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to open NVS: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    stored_controller_schedule_t stored = {
+        .version = CONTROLLER_SCHEDULE_VERSION,
+        .schedule = *schedule,
+    };
+    ret = nvs_set_blob(handle, CONTROLLER_NVS_KEY, &stored, sizeof(stored));
+    if (ret == ESP_OK)
+    {
+        ret = nvs_commit(handle);
+    }
+    nvs_close(handle);
+
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to save gain schedule: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    ESP_LOGI(TAG, "Saved gain schedule with %u point(s)", schedule->count);
+    return ESP_OK;
+}
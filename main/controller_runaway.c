@@ -0,0 +1,89 @@
+#include "controller_runaway.h"
+#include <string.h>
+
+void runaway_reset(runaway_monitor_t *m, const controller_config_t *config)
+{
+    memset(m, 0, sizeof(*m));
+    if (config->runaway_window_s <= 0.0f || config->control_period_s <= 0.0f)
+    {
+        return; // Disabled
+    }
+
+    float samples = config->runaway_window_s / config->control_period_s + 0.5f;
+    if (samples < 2.0f)
+    {
+        samples = 2.0f; // A rise needs two points
+    }
+    m->window = samples > RUNAWAY_MAX_SAMPLES ? RUNAWAY_MAX_SAMPLES : (uint16_t)samples;
+}
+
+controller_fault_t runaway_update(runaway_monitor_t *m, const controller_config_t *config, float heater_temp, uint8_t power)
+{
+    if (m->window == 0)
+    {
+        return CONTROLLER_FAULT_NONE;
+    }
+
+    // Evict the oldest sample once the window is full
+    if (m->count == m->window)
+    {
+        uint8_t evicted = m->powers[m->head];
+        m->zero_power_count -= (evicted == 0);
+    }
+    else
+    {
+        m->count++;
+    }
+
+    m->temps[m->head] = heater_temp;
+    m->powers[m->head] = power;
+    m->zero_power_count += (power == 0);
+    m->head = (uint16_t)((m->head + 1) % m->window);
+
+    // Arm the heating watch when full power starts, or when the reading drops away under full power
+    if (power != 255)
+    {
+        m->in_full_power_run = false;
+        m->watch = 0;
+    }
+    else if (!m->in_full_power_run)
+    {
+        m->in_full_power_run = true;
+        m->run_peak = heater_temp;
+        m->watch = 1;
+    }
+    else if (m->watch > 0)
+    {
+        m->watch++;
+    }
+    else if (heater_temp < m->run_peak - config->runaway_min_rise)
+    {
+        m->run_peak = heater_temp;
+        m->watch = 1;
+    }
+    if (m->in_full_power_run && heater_temp > m->run_peak)
+    {
+        m->run_peak = heater_temp;
+    }
+
+    // head now points at the oldest sample; a complete watch spans the whole window
+    float rise = heater_temp - m->temps[m->head];
+    if (m->watch == m->window)
+    {
+        m->watch = 0;
+        if (rise < config->runaway_min_rise)
+        {
+            return CONTROLLER_FAULT_HEATING_FAILED;
+        }
+    }
+
+    if (m->count < m->window)
+    {
+        return CONTROLLER_FAULT_NONE;
+    }
+    if (m->zero_power_count == m->window && rise > config->runaway_idle_max_rise)
+    {
+        return CONTROLLER_FAULT_RUNAWAY;
+    }
+    return CONTROLLER_FAULT_NONE;
+}
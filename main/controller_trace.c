@@ -0,0 +1,102 @@
+#include "controller_trace.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include <stdatomic.h>
+#include <string.h>
+
+static const char *TAG = "CONTROLLER_TRACE";
+
+#define TRACE_INDEX_MASK (CONTROLLER_TRACE_CAPACITY - 1)
+_Static_assert((CONTROLLER_TRACE_CAPACITY & TRACE_INDEX_MASK) == 0, "trace capacity must be a power of two");
+
+static controller_trace_record_t *s_ring = NULL;
+static atomic_uint s_head; // Records written since init; slot = head & mask
+
+bool controller_trace_init(void)
+{
+    if (s_ring != NULL)
+    {
+        return true;
+    }
+
+    s_ring = heap_caps_malloc(CONTROLLER_TRACE_CAPACITY * sizeof(controller_trace_record_t), MALLOC_CAP_SPIRAM);
+    if (s_ring == NULL)
+    {
+        ESP_LOGE(TAG, "Failed to allocate trace ring (%u records)", CONTROLLER_TRACE_CAPACITY);
+        return false;
+    }
+
+    atomic_store(&s_head, 0);
+    ESP_LOGI(TAG, "Trace ring allocated: %u records, %u bytes", CONTROLLER_TRACE_CAPACITY,
+             (unsigned)(CONTROLLER_TRACE_CAPACITY * sizeof(controller_trace_record_t)));
+    return true;
+}
+
+void controller_trace_deinit(void)
+{
+    controller_trace_record_t *ring = s_ring;
+    s_ring = NULL;
+    if (ring != NULL)
+    {
+        heap_caps_free(ring);
+    }
+}
+
+bool controller_trace_enabled(void)
+{
+    return s_ring != NULL;
+}
+
+int64_t controller_trace_now_us(void)
+{
+    return esp_timer_get_time();
+}
+
+void controller_trace_record(const controller_trace_record_t *record)
+{
+    if (s_ring == NULL)
+    {
+        return;
+    }
+
+    // Claiming the slot with one atomic add keeps concurrent writers apart without a lock
+    unsigned int index = atomic_fetch_add_explicit(&s_head, 1, memory_order_relaxed);
+    controller_trace_record_t *slot = &s_ring[index & TRACE_INDEX_MASK];
+    *slot = *record;
+    slot->sequence = (uint16_t)index;
+}
+
+uint32_t controller_trace_total(void)
+{
+    return atomic_load_explicit(&s_head, memory_order_relaxed);
+}
+
+size_t controller_trace_count(void)
+{
+    uint32_t total = controller_trace_total();
+    return total < CONTROLLER_TRACE_CAPACITY ? total : CONTROLLER_TRACE_CAPACITY;
+}
+
+size_t controller_trace_read(size_t offset, controller_trace_record_t *out, size_t max)
+{
+    if (s_ring == NULL || out == NULL)
+    {
+        return 0;
+    }
+
+    uint32_t total = controller_trace_total();
+    size_t count = total < CONTROLLER_TRACE_CAPACITY ? total : CONTROLLER_TRACE_CAPACITY;
+    if (offset >= count)
+    {
+        return 0;
+    }
+
+    size_t n = count - offset < max ? count - offset : max;
+    uint32_t first = total - (uint32_t)count + (uint32_t)offset; // Oldest held record + offset
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = s_ring[(first + i) & TRACE_INDEX_MASK];
+    }
+    return n;
+}
@@ -1,6 +1,8 @@
 #include "esp_system.h"
 #include "esp_heap_caps.h"
+#include "esp_timer.h"
 #include "display.h"
+#include "diagnostic.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "lvgl.h"
@@ -9,10 +11,24 @@
 #include <stdlib.h>
 #include <inttypes.h>
 
-// FPS monitoring variables
-static uint32_t fps_frame_count = 0;
-static uint32_t fps_time_sum = 0;
-static bool fps_monitoring = false;
+#define FPS_WINDOW_US 1000000     // FPS is counted over windows of this length
+#define PROFILE_TIME_UNIT_US 1000 // Time histograms start at 1 ms buckets
+#define PROFILE_AREA_UNIT_PX 256  // Area histogram starts at 256 px buckets (a 16x16 tile)
+
+// Current frame, touched only by the LVGL task
+static int64_t frame_render_start = 0;
+static int64_t frame_flush_start = 0;
+static int64_t frame_wait_start = 0;
+static uint32_t frame_flush_us = 0;
+static uint32_t frame_area_px = 0;
+
+// Accumulated profile, shared with readers under profile_lock
+static display_profile_t profile;
+static int64_t last_render_start = 0;
+static int64_t window_start = 0;
+static uint32_t window_frames = 0;
+static portMUX_TYPE profile_lock = portMUX_INITIALIZER_UNLOCKED;
+static volatile bool fps_monitoring = false;
 
 /* Print memory usage information */
 void print_memory_info(void)
@@ -36,74 +52,164 @@ void print_memory_info(void)
               (unsigned int)used_heap_sram, (unsigned int)free_heap_sram, (unsigned int)total_heap_sram, percentage_sram);
 }
 
-/* Print FPS information using our custom FPS monitoring */
+/* Print FPS and frame timing from the display profiler */
 void print_fps_info(void)
 {
-       uint32_t fps = fps_monitor_get_fps();
-       printf("Current FPS: %lu\n", fps);
+       display_profile_t p;
+       fps_monitor_get_profile(&p);
+       printf("Current FPS: %lu (render p95 %lu us, flush p95 %lu us, %lu px/frame avg)\n",
+              (unsigned long)fps_monitor_get_fps(), (unsigned long)frame_histogram_percentile(&p.render_us, 95),
+              (unsigned long)frame_histogram_percentile(&p.flush_us, 95), (unsigned long)frame_histogram_mean(&p.area_px));
 }
 
 /* FPS monitoring functions */
 
-// FPS monitor event callback - LVGL 9.x uses events instead of callbacks
-static void fps_monitor_event_cb(lv_event_t *e)
+// Folds the finished frame into the profile
+static void record_frame(int64_t now)
 {
-       if (fps_monitoring)
+       uint32_t frame_us = (uint32_t)(now - frame_render_start);
+       uint32_t flush_us = frame_flush_us < frame_us ? frame_flush_us : frame_us;
+
+       portENTER_CRITICAL(&profile_lock);
+       frame_histogram_add(&profile.render_us, frame_us - flush_us);
+       frame_histogram_add(&profile.flush_us, flush_us);
+       frame_histogram_add(&profile.area_px, frame_area_px);
+       if (last_render_start != 0)
        {
-              // Get the display object
-              lv_display_t *disp = lv_event_get_target(e);
+              frame_histogram_add(&profile.interval_us, (uint32_t)(frame_render_start - last_render_start));
+       }
+       last_render_start = frame_render_start;
+       profile.frames++;
+       profile.last_frame_us = now;
 
-              // In LVGL 9.x, we need to get timing information differently
-              // This is a simplified version - you may need to adjust based on available APIs
-              fps_frame_count++;
+       if (window_start == 0)
+       {
+              window_start = frame_render_start;
+       }
+       window_frames++;
+       if (now - window_start >= FPS_WINDOW_US)
+       {
+              profile.fps = (uint32_t)((uint64_t)window_frames * 1000000 / (now - window_start));
+              window_start = now;
+              window_frames = 0;
+       }
+       portEXIT_CRITICAL(&profile_lock);
+}
 
-              // Note: LVGL 9.x may have different timing APIs
-              // This is a placeholder - you may need to use lv_tick_get() or similar
-              uint32_t current_time = lv_tick_get();
-              static uint32_t last_time = 0;
+// Display event callback, registered only for the codes below so other display events cost nothing.
+// Flush time is the flush callback plus any wait for the bus to free a buffer; the rest of the
+// render-start to render-ready span is drawing.
+static void fps_monitor_event_cb(lv_event_t *e)
+{
+       if (!fps_monitoring)
+       {
+              return;
+       }
 
-              if (last_time != 0)
+       int64_t now = esp_timer_get_time();
+       switch (lv_event_get_code(e))
+       {
+       case LV_EVENT_RENDER_START:
+              frame_render_start = now;
+              frame_flush_us = 0;
+              frame_area_px = 0;
+              break;
+       case LV_EVENT_FLUSH_START:
+       {
+              const lv_area_t *area = lv_event_get_param(e);
+              frame_flush_start = now;
+              if (area != NULL)
+              {
+                     frame_area_px += lv_area_get_size(area);
+              }
+              break;
+       }
+       case LV_EVENT_FLUSH_FINISH:
+              frame_flush_us += (uint32_t)(now - frame_flush_start);
+              break;
+       case LV_EVENT_FLUSH_WAIT_START:
+              frame_wait_start = now;
+              break;
+       case LV_EVENT_FLUSH_WAIT_FINISH:
+              frame_flush_us += (uint32_t)(now - frame_wait_start);
+              break;
+       case LV_EVENT_RENDER_READY:
+              if (frame_render_start != 0)
               {
-                     fps_time_sum += (current_time - last_time);
+                     record_frame(now);
               }
-              last_time = current_time;
+              break;
+       default:
+              break;
        }
 }
 
-// Reset FPS counters
+// Reset FPS counters and histograms
 void fps_monitor_reset(void)
 {
-       fps_frame_count = 0;
-       fps_time_sum = 0;
+       portENTER_CRITICAL(&profile_lock);
+       memset(&profile, 0, sizeof(profile));
+       frame_histogram_init(&profile.render_us, PROFILE_TIME_UNIT_US);
+       frame_histogram_init(&profile.flush_us, PROFILE_TIME_UNIT_US);
+       frame_histogram_init(&profile.interval_us, PROFILE_TIME_UNIT_US);
+       frame_histogram_init(&profile.area_px, PROFILE_AREA_UNIT_PX);
+       last_render_start = 0;
+       window_start = 0;
+       window_frames = 0;
+       portEXIT_CRITICAL(&profile_lock);
 }
 
-// Setup FPS monitoring event callback for display
+// Setup FPS monitoring event callbacks for a display; call for every display that is (re)created
 void fps_monitor_setup_callback(void *disp_ptr)
 {
+       static const lv_event_code_t codes[] = {
+           LV_EVENT_RENDER_START, LV_EVENT_RENDER_READY, LV_EVENT_FLUSH_START,
+           LV_EVENT_FLUSH_FINISH, LV_EVENT_FLUSH_WAIT_START, LV_EVENT_FLUSH_WAIT_FINISH,
+       };
+
        lv_display_t *disp = (lv_display_t *)disp_ptr;
        if (disp)
        {
-              // In LVGL 9.x, use events instead of direct callback assignment
-              lv_display_add_event_cb(disp, fps_monitor_event_cb, LV_EVENT_RENDER_READY, NULL);
+              for (size_t i = 0; i < sizeof(codes) / sizeof(codes[0]); i++)
+              {
+                     lv_display_add_event_cb(disp, fps_monitor_event_cb, codes[i], NULL);
+              }
        }
 }
 
-// Get current FPS value
+// Get the FPS of the last complete window; 0 once nothing has been rendered for two windows
 uint32_t fps_monitor_get_fps(void)
 {
-       if (fps_frame_count == 0 || fps_time_sum == 0)
-       {
-              return 0;
-       }
+       int64_t now = esp_timer_get_time();
+       uint32_t fps;
 
-       // Calculate FPS: frames / (time_sum / 1000) = frames * 1000 / time_sum
-       uint32_t fps = (fps_frame_count * 1000) / fps_time_sum;
+       portENTER_CRITICAL(&profile_lock);
+       fps = now - profile.last_frame_us > 2 * FPS_WINDOW_US ? 0 : profile.fps;
+       portEXIT_CRITICAL(&profile_lock);
        return fps;
 }
 
+void fps_monitor_get_profile(display_profile_t *out)
+{
+       portENTER_CRITICAL(&profile_lock);
+       *out = profile;
+       portEXIT_CRITICAL(&profile_lock);
+}
+
+bool fps_monitor_is_running(void)
+{
+       return fps_monitoring;
+}
+
 // Start FPS monitoring
 void fps_monitor_start(void)
 {
-       fps_monitoring = true;
        fps_monitor_reset();
+       fps_monitoring = true;
+}
+
+// Stop FPS monitoring; the collected profile stays readable
+void fps_monitor_stop(void)
+{
+       fps_monitoring = false;
 }
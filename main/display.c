@@ -5,6 +5,7 @@
 #include "esp_lcd_panel_vendor.h"
 #include "esp_dma_utils.h"
 #include "driver/gpio.h"
+#include "driver/ledc.h"
 #include "esp_err.h"
 #include "esp_log.h"
 #include "esp_system.h"
@@ -14,26 +15,12 @@
 #include "lv_demos.h"
 #include "diagnostic.h"
 #include "display.h"
-#include "temp.h"
-#include "wifi.h"
 #include "version.h"
 
 // FPS display variables
 static lv_obj_t *fps_label = NULL;
 static lv_timer_t *fps_update_timer = NULL;
 
-// Temperature display variables
-static lv_obj_t *air_temp_label = NULL;
-static lv_obj_t *air_vr_label = NULL; // Air voltage|resistance
-static lv_obj_t *heater_temp_label = NULL;
-static lv_obj_t *heater_vr_label = NULL; // Heater voltage|resistance
-static lv_obj_t *ip_label = NULL;
-static lv_timer_t *temp_update_timer = NULL;
-
-// Temperature meter variables
-static lv_obj_t *air_meter = NULL;
-static lv_obj_t *heater_meter = NULL;
-
 // FPS display update callback
 static void fps_update_cb(lv_timer_t *timer)
 {
@@ -46,168 +33,20 @@ static void fps_update_cb(lv_timer_t *timer)
   }
 }
 
-// Temperature display update callback
-static void temp_update_cb(lv_timer_t *timer)
-{
-  // Update air sensor temperature
-  if (air_temp_label != NULL)
-  {
-    temp_sensor_handle_t air_sensor = temp_sensor_get_air_sensor();
-    if (air_sensor != NULL)
-    {
-      float temp = temp_sensor_get_reading(air_sensor);
-
-      if (temp == -999.0f)
-      {
-        // No samples available yet
-        lv_label_set_text(air_temp_label, "Air: --°C");
-        printf("Air temperature: No samples available yet\n");
-      }
-      else
-      {
-        char buf[32];
-
-        // Format: Temperature with 1 decimal place
-        int temp_int = (int)(temp * 10);
-        int temp_whole = temp_int / 10;
-        int temp_decimal = temp_int % 10;
-
-        lv_snprintf(buf, sizeof(buf), "Air: %d.%d°C", temp_whole, temp_decimal);
-
-        lv_label_set_text(air_temp_label, buf);
-        // printf("Air temperature updated: %.1f°C (display: %s)\n", temp, buf);
-
-        // TODO: Update air temperature scale indicator when LVGL 9.x scale API is fully understood
-      }
-    }
-  }
-
-  // Update air sensor voltage|resistance
-  if (air_vr_label != NULL)
-  {
-    temp_sensor_handle_t air_sensor = temp_sensor_get_air_sensor();
-    if (air_sensor != NULL)
-    {
-      float voltage = temp_sensor_get_voltage(air_sensor);
-      float resistance = temp_sensor_get_resistance(air_sensor);
-
-      if (voltage == -999.0f || resistance == -999.0f)
-      {
-        // No samples available yet
-        lv_label_set_text(air_vr_label, "Air: --V|--k");
-        printf("Air voltage/resistance: No samples available yet\n");
-      }
-      else
-      {
-        char buf[32];
-
-        // Format: Voltage (2 decimals) | Resistance (1 decimal in k)
-        int voltage_int = (int)(voltage * 100);
-        int voltage_whole = voltage_int / 100;
-        int voltage_decimal = voltage_int % 100;
-
-        float resistance_kohm = resistance / 1000.0f;
-        int resistance_whole = (int)resistance_kohm;
-        int resistance_decimal = (int)((resistance_kohm - resistance_whole) * 10);
-
-        lv_snprintf(buf, sizeof(buf), "Air: %d.%02dV|%d.%dk", voltage_whole, voltage_decimal, resistance_whole, resistance_decimal);
-
-        lv_label_set_text(air_vr_label, buf);
-        // printf("Air voltage/resistance updated: %.2fV|%.1fk (display: %s)\n", voltage, resistance_kohm, buf);
-      }
-    }
-  }
-
-  // Update heater sensor temperature
-  if (heater_temp_label != NULL)
-  {
-    temp_sensor_handle_t heater_sensor = temp_sensor_get_heater_sensor();
-    if (heater_sensor != NULL)
-    {
-      float temp = temp_sensor_get_reading(heater_sensor);
-
-      if (temp == -999.0f)
-      {
-        // No samples available yet
-        lv_label_set_text(heater_temp_label, "Heat: --°C");
-        printf("Heater temperature: No samples available yet\n");
-      }
-      else
-      {
-        char buf[32];
-
-        // Format: Temperature with 1 decimal place
-        int temp_int = (int)(temp * 10);
-        int temp_whole = temp_int / 10;
-        int temp_decimal = temp_int % 10;
-
-        lv_snprintf(buf, sizeof(buf), "Heat: %d.%d°C", temp_whole, temp_decimal);
-
-        lv_label_set_text(heater_temp_label, buf);
-        // printf("Heater temperature updated: %.1f°C (display: %s)\n", temp, buf);
-
-        // TODO: Update heater temperature scale indicator when LVGL 9.x scale API is fully understood
-      }
-    }
-  }
-
-  // Update heater sensor voltage|resistance
-  if (heater_vr_label != NULL)
-  {
-    temp_sensor_handle_t heater_sensor = temp_sensor_get_heater_sensor();
-    if (heater_sensor != NULL)
-    {
-      float voltage = temp_sensor_get_voltage(heater_sensor);
-      float resistance = temp_sensor_get_resistance(heater_sensor);
-
-      if (voltage == -999.0f || resistance == -999.0f)
-      {
-        // No samples available yet
-        lv_label_set_text(heater_vr_label, "Heat: --V|--k");
-        printf("Heater voltage/resistance: No samples available yet\n");
-      }
-      else
-      {
-        char buf[32];
-
-        // Format: Voltage (2 decimals) | Resistance (1 decimal in k)
-        int voltage_int = (int)(voltage * 100);
-        int voltage_whole = voltage_int / 100;
-        int voltage_decimal = voltage_int % 100;
-
-        float resistance_kohm = resistance / 1000.0f;
-        int resistance_whole = (int)resistance_kohm;
-        int resistance_decimal = (int)((resistance_kohm - resistance_whole) * 10);
-
-        lv_snprintf(buf, sizeof(buf), "Heat: %d.%02dV|%d.%dk", voltage_whole, voltage_decimal, resistance_whole, resistance_decimal);
-
-        lv_label_set_text(heater_vr_label, buf);
-        // printf("Heater voltage/resistance updated: %.2fV|%.1fk (display: %s)\n", voltage, resistance_kohm, buf);
-      }
-    }
-  }
+#define EXAMPLE_LCD_PIXEL_CLOCK_HZ (10 * 1000 * 1000)
 
-  // Update IP address label
-  if (ip_label != NULL)
-  {
-    char ip_buffer[16];
-    esp_err_t ret = wifi_get_ip_address(ip_buffer, sizeof(ip_buffer));
-    if (ret == ESP_OK && ip_buffer[0] != '\0')
-    {
-      char buf[32];
-      lv_snprintf(buf, sizeof(buf), "IP: %s", ip_buffer);
-      lv_label_set_text(ip_label, buf);
-      // printf("IP address updated: %s\n", ip_buffer);
-    }
-    else
-    {
-      lv_label_set_text(ip_label, "IP: Not connected");
-      printf("IP address: Not connected\n");
-    }
-  }
-}
+#ifdef CONFIG_DISPLAY_BUFFER_LINES
+#define DISPLAY_BUFFER_LINES CONFIG_DISPLAY_BUFFER_LINES
+#else
+#define DISPLAY_BUFFER_LINES 32 // Stripe height; the option is hidden for full-frame buffers
+#endif
 
-#define EXAMPLE_LCD_PIXEL_CLOCK_HZ (10 * 1000 * 1000)
+// Backlight PWM; the heater and fan use LEDC timers/channels 0 and 1
+#define BACKLIGHT_LEDC_TIMER LEDC_TIMER_2
+#define BACKLIGHT_LEDC_CHANNEL LEDC_CHANNEL_2
+#define BACKLIGHT_PWM_FREQ_HZ 5000
+#define BACKLIGHT_DUTY_RESOLUTION LEDC_TIMER_10_BIT
+#define BACKLIGHT_DUTY_MAX ((1 << 10) - 1)
 
 static const char *TAG = "TFT";
 
@@ -220,6 +59,9 @@ typedef struct
 
 static esp_lcd_panel_io_handle_t io_handle = NULL;
 static esp_lcd_panel_handle_t panel_handle = NULL;
+static lv_display_t *lvgl_disp = NULL;
+static display_buffer_config_t lvgl_buffering;
+static bool backlight_pwm = false;
 
 lcd_cmd_t lcd_st7789v[] = {
     {0x11, {0}, 0 | 0x80},
@@ -240,6 +82,44 @@ lcd_cmd_t lcd_st7789v[] = {
     {0xE1, {0XF0, 0X08, 0X0C, 0X0B, 0X09, 0X24, 0X2B, 0X22, 0X43, 0X38, 0X15, 0X16, 0X2F, 0X37}, 14},
 };
 
+/* Backlight on at full brightness, dimmable through LEDC; plain on/off if the PWM cannot be set up */
+static void init_backlight(void)
+{
+  ledc_timer_config_t timer_config = {
+      .speed_mode = LEDC_LOW_SPEED_MODE,
+      .timer_num = BACKLIGHT_LEDC_TIMER,
+      .duty_resolution = BACKLIGHT_DUTY_RESOLUTION,
+      .freq_hz = BACKLIGHT_PWM_FREQ_HZ,
+      .clk_cfg = LEDC_AUTO_CLK,
+  };
+  ledc_channel_config_t channel_config = {
+      .gpio_num = BOARD_TFT_BL,
+      .speed_mode = LEDC_LOW_SPEED_MODE,
+      .channel = BACKLIGHT_LEDC_CHANNEL,
+      .timer_sel = BACKLIGHT_LEDC_TIMER,
+      .duty = BACKLIGHT_DUTY_MAX,
+      .hpoint = 0,
+  };
+
+  esp_err_t ret = ledc_timer_config(&timer_config);
+  if (ret == ESP_OK)
+  {
+    ret = ledc_channel_config(&channel_config);
+  }
+  if (ret == ESP_OK)
+  {
+    backlight_pwm = true;
+    return;
+  }
+
+  ESP_LOGW(TAG, "Backlight PWM unavailable (%s), backlight cannot be dimmed", esp_err_to_name(ret));
+  gpio_config_t bk_gpio_config = {
+      .mode = GPIO_MODE_OUTPUT,
+      .pin_bit_mask = 1ULL << BOARD_TFT_BL};
+  ESP_ERROR_CHECK(gpio_config(&bk_gpio_config));
+  gpio_set_level(BOARD_TFT_BL, 1);
+}
+
 void init_lcd_display(void)
 {
   printf("Initializing LCD display...\n");
@@ -268,7 +148,7 @@ void init_lcd_display(void)
           BOARD_TFT_DATA7,
       },
       .bus_width = 8,
-      .max_transfer_bytes = AMOLED_HEIGHT * 32 * sizeof(uint16_t), // Full screen capacity
+      .max_transfer_bytes = AMOLED_WIDTH * AMOLED_HEIGHT * sizeof(uint16_t), // Full frame, for DISPLAY_BUFFER_PSRAM_FULL
       .psram_trans_align = 64,
       .sram_trans_align = 4};
   ESP_ERROR_CHECK(esp_lcd_new_i80_bus(&bus_config, &i80_bus));
@@ -318,46 +198,70 @@ void init_lcd_display(void)
 
   ESP_ERROR_CHECK(esp_lcd_panel_disp_on_off(panel_handle, true));
 
-  // Turn on LCD backlight
-  gpio_config_t bk_gpio_config = {
-      .mode = GPIO_MODE_OUTPUT,
-      .pin_bit_mask = 1ULL << BOARD_TFT_BL};
-  ESP_ERROR_CHECK(gpio_config(&bk_gpio_config));
-  gpio_set_level(BOARD_TFT_BL, 1);
+  init_backlight();
 
   printf("LCD display initialized successfully!\n");
 }
 
-/* Initialize LVGL with esp_lvgl_port */
-static void init_lvgl_display(void)
+esp_err_t display_set_backlight(uint8_t percent)
 {
-  printf("Initializing LVGL with esp_lvgl_port...\n");
-
-  /* Initialize LVGL library (required for LVGL 9.x) */
-  // lv_init();
+  if (percent > 100)
+  {
+    percent = 100;
+  }
+  if (!backlight_pwm)
+  {
+    return gpio_set_level(BOARD_TFT_BL, percent > 0);
+  }
+  return ledc_set_duty_and_update(LEDC_LOW_SPEED_MODE, BACKLIGHT_LEDC_CHANNEL, BACKLIGHT_DUTY_MAX * percent / 100, 0);
+}
 
-  /* Set up LVGL tick interface (required for LVGL 9.x) */
-  // lv_tick_set_cb((lv_tick_get_cb_t)esp_timer_get_time);
+esp_err_t display_set_panel_on(bool on)
+{
+  if (panel_handle == NULL)
+  {
+    return ESP_ERR_INVALID_STATE;
+  }
+  return esp_lcd_panel_disp_on_off(panel_handle, on);
+}
 
-  /* LVGL port initialization */
-  static lvgl_port_cfg_t lvgl_cfg = ESP_LVGL_PORT_INIT_CONFIG();
-  lvgl_cfg.task_priority = 4;    // Set task priority
-  lvgl_cfg.task_stack = 6144;    // Set task stack size
-  lvgl_cfg.task_affinity = 1;    // Allow any core affinity
-  lvgl_cfg.timer_period_ms = 16; // 16ms timer period (~60Hz) for reduced CPU usage
+void display_get_default_buffering(display_buffer_config_t *config)
+{
+#if defined(CONFIG_DISPLAY_BUFFER_PSRAM_FULL)
+  config->mode = DISPLAY_BUFFER_PSRAM_FULL;
+  config->lines = AMOLED_HEIGHT;
+#elif defined(CONFIG_DISPLAY_BUFFER_SINGLE)
+  config->mode = DISPLAY_BUFFER_SINGLE;
+  config->lines = DISPLAY_BUFFER_LINES;
+#else
+  config->mode = DISPLAY_BUFFER_DMA_DOUBLE;
+  config->lines = DISPLAY_BUFFER_LINES;
+#endif
+}
 
-  ESP_ERROR_CHECK(lvgl_port_init(&lvgl_cfg));
+size_t display_buffer_bytes(const display_buffer_config_t *config)
+{
+  uint32_t lines = config->mode == DISPLAY_BUFFER_PSRAM_FULL ? AMOLED_HEIGHT : config->lines;
+  uint32_t buffers = config->mode == DISPLAY_BUFFER_SINGLE ? 1 : 2;
+  return (size_t)AMOLED_WIDTH * lines * sizeof(uint16_t) * buffers;
+}
 
-  // Workaround for LVGL 9.x + ESP32-S3 crash: Add delay after lvgl_port_task creation
-  // https://github.com/espressif/esp-bsp/issues/475
-  vTaskDelay(pdMS_TO_TICKS(10));
+/* Adds the panel to LVGL with the given draw buffers */
+static lv_display_t *add_lvgl_display(const display_buffer_config_t *config)
+{
+  bool full_frame = config->mode == DISPLAY_BUFFER_PSRAM_FULL;
+  uint32_t lines = full_frame ? AMOLED_HEIGHT : config->lines;
+  if (lines < 1 || lines > AMOLED_HEIGHT)
+  {
+    ESP_LOGE(TAG, "Invalid draw buffer height %lu", (unsigned long)lines);
+    return NULL;
+  }
 
-  /* Add display to LVGL */
   const lvgl_port_display_cfg_t disp_cfg = {
       .io_handle = io_handle,
       .panel_handle = panel_handle,
-      .buffer_size = AMOLED_WIDTH * 32, // Full screen buffer for LVGL 9.x compatibility
-      .double_buffer = false,
+      .buffer_size = AMOLED_WIDTH * lines,
+      .double_buffer = config->mode != DISPLAY_BUFFER_SINGLE,
       .hres = AMOLED_WIDTH,
       .vres = AMOLED_HEIGHT,
       .monochrome = false,
@@ -368,25 +272,91 @@ static void init_lvgl_display(void)
           .mirror_y = false,
       },
       .flags = {
-          .buff_dma = false,
-          .buff_spiram = false,
+          .buff_dma = config->mode == DISPLAY_BUFFER_DMA_DOUBLE,
+          .buff_spiram = full_frame,
           .sw_rotate = false,
-          .full_refresh = false,
+          .full_refresh = full_frame,
           .swap_bytes = true,
       }};
 
   lv_display_t *disp = lvgl_port_add_disp(&disp_cfg);
   if (disp == NULL)
   {
-    ESP_LOGE(TAG, "Failed to add display to LVGL");
-    return;
+    ESP_LOGE(TAG, "Failed to add display to LVGL (%u bytes of draw buffers)", (unsigned int)display_buffer_bytes(config));
+    return NULL;
   }
 
   // Set as default display (required in LVGL 9.x)
   lv_display_set_default(disp);
 
-  // Set up FPS monitoring callback on the display driver
-  // fps_monitor_setup_callback(disp);
+  // Frame profiling hooks; they cost nothing until fps_monitor_start()
+  fps_monitor_setup_callback(disp);
+
+  lvgl_buffering = *config;
+  lvgl_disp = disp;
+  return disp;
+}
+
+lv_display_t *display_set_buffering(const display_buffer_config_t *config)
+{
+  if (!lvgl_port_lock(0))
+  {
+    return NULL;
+  }
+
+  display_buffer_config_t previous = lvgl_buffering;
+  if (lvgl_disp != NULL)
+  {
+    lvgl_port_remove_disp(lvgl_disp);
+    lvgl_disp = NULL;
+  }
+
+  lv_display_t *disp = add_lvgl_display(config);
+  if (disp == NULL)
+  {
+    // Typically out of DMA-capable RAM; keep a working display
+    add_lvgl_display(&previous);
+  }
+
+  lvgl_port_unlock();
+  return disp;
+}
+
+/* Initialize LVGL with esp_lvgl_port */
+static void init_lvgl_display(void)
+{
+  printf("Initializing LVGL with esp_lvgl_port...\n");
+
+  /* Initialize LVGL library (required for LVGL 9.x) */
+  // lv_init();
+
+  /* Set up LVGL tick interface (required for LVGL 9.x) */
+  // lv_tick_set_cb((lv_tick_get_cb_t)esp_timer_get_time);
+
+  /* LVGL port initialization */
+  static lvgl_port_cfg_t lvgl_cfg = ESP_LVGL_PORT_INIT_CONFIG();
+  lvgl_cfg.task_priority = 4;    // Set task priority
+  lvgl_cfg.task_stack = 6144;    // Set task stack size
+  lvgl_cfg.task_affinity = 1;    // Allow any core affinity
+  lvgl_cfg.timer_period_ms = 16; // 16ms timer period (~60Hz) for reduced CPU usage
+
+  ESP_ERROR_CHECK(lvgl_port_init(&lvgl_cfg));
+
+  // Workaround for LVGL 9.x + ESP32-S3 crash: Add delay after lvgl_port_task creation
+  // https://github.com/espressif/esp-bsp/issues/475
+  vTaskDelay(pdMS_TO_TICKS(10));
+
+  /* Add display to LVGL with the buffering selected in menuconfig */
+  display_buffer_config_t buffering;
+  display_get_default_buffering(&buffering);
+  lv_display_t *disp = add_lvgl_display(&buffering);
+  if (disp == NULL)
+  {
+    return;
+  }
+  ESP_LOGI(TAG, "LVGL draw buffers: mode %d, %u lines, %u bytes", (int)buffering.mode,
+           (unsigned int)(buffering.mode == DISPLAY_BUFFER_PSRAM_FULL ? AMOLED_HEIGHT : buffering.lines),
+           (unsigned int)display_buffer_bytes(&buffering));
 
   printf("LVGL initialized successfully!\n");
 }
@@ -0,0 +1,185 @@
+#include "display_benchmark.h"
+#include "diagnostic.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "esp_lvgl_port.h"
+#include "lvgl.h"
+#include "product_pins.h"
+#include <string.h>
+
+static const char *TAG = "DISPLAY_BENCH";
+
+#define BENCH_WARMUP_MS 300  // Let the first full-screen frame and buffer allocation settle
+#define BENCH_SCENE_MS 2000  // Measurement time per configuration and scene
+#define BENCH_BOX_SIZE 40
+
+typedef enum
+{
+  SCENE_FULL,
+  SCENE_PARTIAL,
+  SCENE_COUNT,
+} bench_scene_t;
+
+static const char *const scene_names[SCENE_COUNT] = {"full", "partial"};
+
+/* The original single 32-line buffer first, as the baseline */
+static const display_buffer_config_t bench_configs[] = {
+    {DISPLAY_BUFFER_SINGLE, 32},
+    {DISPLAY_BUFFER_DMA_DOUBLE, 16},
+    {DISPLAY_BUFFER_DMA_DOUBLE, 32},
+    {DISPLAY_BUFFER_DMA_DOUBLE, 64},
+    {DISPLAY_BUFFER_PSRAM_FULL, AMOLED_HEIGHT},
+};
+
+/* Forces a full-screen redraw every refresh period */
+static void invalidate_timer_cb(lv_timer_t *timer)
+{
+  lv_obj_invalidate(lv_timer_get_user_data(timer));
+}
+
+static void anim_x_cb(void *var, int32_t v)
+{
+  lv_obj_set_x(var, v);
+}
+
+static void anim_y_cb(void *var, int32_t v)
+{
+  lv_obj_set_y(var, v);
+}
+
+static void start_box_anim(lv_obj_t *box, lv_anim_exec_xcb_t exec_cb, int32_t end, uint32_t duration_ms)
+{
+  lv_anim_t a;
+  lv_anim_init(&a);
+  lv_anim_set_var(&a, box);
+  lv_anim_set_exec_cb(&a, exec_cb);
+  lv_anim_set_values(&a, 0, end);
+  lv_anim_set_duration(&a, duration_ms);
+  lv_anim_set_reverse_duration(&a, duration_ms);
+  lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
+  lv_anim_start(&a);
+}
+
+/* Builds the scene on the display's active screen; returns the invalidation timer, if any */
+static lv_timer_t *build_scene(lv_display_t *disp, bench_scene_t scene, const display_buffer_config_t *config)
+{
+  lv_obj_t *screen = lv_display_get_screen_active(disp);
+  lv_obj_remove_flag(screen, LV_OBJ_FLAG_SCROLLABLE);
+
+  // Gradient background so full-screen frames cost real blending work
+  lv_obj_set_style_bg_color(screen, lv_palette_main(LV_PALETTE_BLUE), LV_PART_MAIN);
+  lv_obj_set_style_bg_grad_color(screen, lv_palette_darken(LV_PALETTE_ORANGE, 2), LV_PART_MAIN);
+  lv_obj_set_style_bg_grad_dir(screen, LV_GRAD_DIR_VER, LV_PART_MAIN);
+  lv_obj_set_style_bg_opa(screen, LV_OPA_COVER, LV_PART_MAIN);
+
+  lv_obj_t *label = lv_label_create(screen);
+  lv_obj_set_style_text_color(label, lv_color_white(), LV_PART_MAIN);
+  lv_label_set_text_fmt(label, "%s\nmode %d, %u lines", scene_names[scene], (int)config->mode,
+                        (unsigned int)(config->mode == DISPLAY_BUFFER_PSRAM_FULL ? AMOLED_HEIGHT : config->lines));
+  lv_obj_align(label, LV_ALIGN_CENTER, 0, 0);
+
+  lv_obj_t *box = lv_obj_create(screen);
+  lv_obj_set_size(box, BENCH_BOX_SIZE, BENCH_BOX_SIZE);
+  lv_obj_set_style_bg_color(box, lv_palette_main(LV_PALETTE_RED), LV_PART_MAIN);
+  lv_obj_set_style_border_width(box, 0, LV_PART_MAIN);
+  start_box_anim(box, anim_x_cb, AMOLED_WIDTH - BENCH_BOX_SIZE, 700);
+  start_box_anim(box, anim_y_cb, AMOLED_HEIGHT - BENCH_BOX_SIZE, 1100);
+
+  if (scene != SCENE_FULL)
+  {
+    return NULL;
+  }
+  return lv_timer_create(invalidate_timer_cb, LV_DEF_REFR_PERIOD, screen);
+}
+
+static void measure(const display_buffer_config_t *config, bench_scene_t scene, display_benchmark_result_t *result)
+{
+  memset(result, 0, sizeof(*result));
+  result->buffering = *config;
+  result->scene = scene_names[scene];
+  result->buffer_bytes = display_buffer_bytes(config);
+
+  lv_display_t *disp = display_set_buffering(config);
+  if (disp == NULL)
+  {
+    return;
+  }
+
+  lvgl_port_lock(0);
+  lv_timer_t *invalidate_timer = build_scene(disp, scene, config);
+  lvgl_port_unlock();
+
+  vTaskDelay(pdMS_TO_TICKS(BENCH_WARMUP_MS));
+
+  // The display profiler is hooked into every display; restarting it clears the warmup frames
+  fps_monitor_start();
+  int64_t start = esp_timer_get_time();
+
+  vTaskDelay(pdMS_TO_TICKS(BENCH_SCENE_MS));
+
+  display_profile_t profile;
+  fps_monitor_get_profile(&profile);
+  int64_t elapsed_us = esp_timer_get_time() - start;
+
+  lvgl_port_lock(0);
+  if (invalidate_timer != NULL)
+  {
+    lv_timer_delete(invalidate_timer);
+  }
+  lv_obj_clean(lv_display_get_screen_active(disp)); // Deleting the box deletes its animations
+  lvgl_port_unlock();
+
+  result->ok = true;
+  result->frames = profile.frames;
+  result->fps = elapsed_us > 0 ? profile.frames * 1000000.0f / elapsed_us : 0.0f;
+  result->render_us = frame_histogram_mean(&profile.render_us);
+  result->flush_us = frame_histogram_mean(&profile.flush_us);
+  result->render_us_p95 = frame_histogram_percentile(&profile.render_us, 95);
+}
+
+size_t display_benchmark_run(display_benchmark_result_t *results, size_t max_results)
+{
+  static display_benchmark_result_t local[DISPLAY_BENCHMARK_MAX_RESULTS]; // Keeps the table off the caller's stack
+  if (results == NULL)
+  {
+    results = local;
+    max_results = DISPLAY_BENCHMARK_MAX_RESULTS;
+  }
+
+  ESP_LOGI(TAG, "Running display buffer benchmark...");
+  size_t count = 0;
+  for (size_t i = 0; i < sizeof(bench_configs) / sizeof(bench_configs[0]); i++)
+  {
+    for (int scene = 0; scene < SCENE_COUNT && count < max_results; scene++)
+    {
+      measure(&bench_configs[i], (bench_scene_t)scene, &results[count++]);
+    }
+  }
+
+  ESP_LOGI(TAG, "%-5s %5s %7s %-8s %6s %9s %9s %9s", "mode", "lines", "bytes", "scene", "fps", "render_us",
+           "flush_us", "render_p95");
+  for (size_t i = 0; i < count; i++)
+  {
+    const display_benchmark_result_t *r = &results[i];
+    unsigned int lines = r->buffering.mode == DISPLAY_BUFFER_PSRAM_FULL ? AMOLED_HEIGHT : r->buffering.lines;
+    if (!r->ok)
+    {
+      ESP_LOGW(TAG, "%-5d %5u %7u %-8s allocation failed", (int)r->buffering.mode, lines,
+               (unsigned int)r->buffer_bytes, r->scene);
+      continue;
+    }
+    ESP_LOGI(TAG, "%-5d %5u %7u %-8s %6.1f %9lu %9lu %9lu", (int)r->buffering.mode, lines,
+             (unsigned int)r->buffer_bytes, r->scene, r->fps, (unsigned long)r->render_us,
+             (unsigned long)r->flush_us, (unsigned long)r->render_us_p95);
+  }
+
+  fps_monitor_stop();
+
+  // Back to the menuconfig strategy for the real UI
+  display_buffer_config_t buffering;
+  display_get_default_buffering(&buffering);
+  display_set_buffering(&buffering);
+  return count;
+}
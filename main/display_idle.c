@@ -0,0 +1,28 @@
+#include "display_idle.h"
+
+display_idle_state_t display_idle_state(const display_idle_config_t *config, uint32_t idle_ms)
+{
+    if (config->sleep_after_ms > 0 && idle_ms >= config->sleep_after_ms)
+    {
+        return DISPLAY_IDLE_SLEEP;
+    }
+    if (config->dim_after_ms > 0 && idle_ms >= config->dim_after_ms)
+    {
+        return DISPLAY_IDLE_DIM;
+    }
+    return DISPLAY_IDLE_ACTIVE;
+}
+
+display_render_mode_t display_idle_render_mode(const display_idle_config_t *config, display_idle_state_t state,
+                                               uint32_t quiet_ms, bool animating)
+{
+    if (state == DISPLAY_IDLE_SLEEP)
+    {
+        return DISPLAY_RENDER_PAUSED; // Nobody can see it
+    }
+    if (animating || quiet_ms < config->throttle_after_ms)
+    {
+        return DISPLAY_RENDER_FULL_RATE;
+    }
+    return DISPLAY_RENDER_THROTTLED;
+}
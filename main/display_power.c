@@ -0,0 +1,267 @@
+#include <sdkconfig.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/gpio.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "esp_lvgl_port.h"
+#include "lvgl.h"
+#include "product_pins.h"
+#include "display.h"
+#include "display_power.h"
+#include "telemetry_bus.h"
+
+static const char *TAG = "DISPLAY_POWER";
+
+#ifdef CONFIG_DISPLAY_DIM_AFTER_S
+#define DISPLAY_DIM_AFTER_S CONFIG_DISPLAY_DIM_AFTER_S
+#else
+#define DISPLAY_DIM_AFTER_S 60
+#endif
+
+#ifdef CONFIG_DISPLAY_DIM_PERCENT
+#define DISPLAY_DIM_PERCENT CONFIG_DISPLAY_DIM_PERCENT
+#else
+#define DISPLAY_DIM_PERCENT 20
+#endif
+
+#ifdef CONFIG_DISPLAY_SLEEP_AFTER_S
+#define DISPLAY_SLEEP_AFTER_S CONFIG_DISPLAY_SLEEP_AFTER_S
+#else
+#define DISPLAY_SLEEP_AFTER_S 600
+#endif
+
+#ifdef CONFIG_DISPLAY_IDLE_REFRESH_MS
+#define DISPLAY_IDLE_REFRESH_MS CONFIG_DISPLAY_IDLE_REFRESH_MS
+#else
+#define DISPLAY_IDLE_REFRESH_MS 200
+#endif
+
+#define POWER_POLL_PERIOD_MS 100 // Button polling and state evaluation
+#define THROTTLE_AFTER_MS 2500   // Time without redraws before the refresh period is raised; above the 1 s sample period
+
+static const uint8_t backlight_percent[DISPLAY_IDLE_STATE_COUNT] = {
+    [DISPLAY_IDLE_ACTIVE] = 100,
+    [DISPLAY_IDLE_DIM] = DISPLAY_DIM_PERCENT,
+    [DISPLAY_IDLE_SLEEP] = 0,
+};
+
+static const char *const state_names[DISPLAY_IDLE_STATE_COUNT] = {"active", "dimmed", "off"};
+static const char *const mode_names[DISPLAY_RENDER_MODE_COUNT] = {"full rate", "throttled", "paused"};
+
+static display_idle_config_t idle_config;
+static atomic_uint last_activity_ms; // Wraps after ~49 days; only differences are used
+static lv_timer_t *poll_timer = NULL;
+static lv_display_t *power_disp = NULL;
+static uint32_t last_invalidate_tick;
+
+// Owned by the LVGL task; copied into stats under the lock
+static display_idle_state_t current_state = DISPLAY_IDLE_ACTIVE;
+static display_render_mode_t current_mode = DISPLAY_RENDER_FULL_RATE;
+static TaskHandle_t lvgl_task = NULL;
+static configRUN_TIME_COUNTER_TYPE last_run_time;
+static int64_t last_sample_us;
+
+static display_power_stats_t stats;
+static portMUX_TYPE stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static uint32_t now_ms(void)
+{
+  return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+void display_power_wake(void)
+{
+  atomic_store(&last_activity_ms, now_ms());
+}
+
+void display_power_get_stats(display_power_stats_t *out)
+{
+  taskENTER_CRITICAL(&stats_lock);
+  *out = stats;
+  taskEXIT_CRITICAL(&stats_lock);
+}
+
+/* Charges the time and LVGL CPU time since the last sample to the current refresh mode */
+static void sample_run_time(void)
+{
+  int64_t now_us = esp_timer_get_time();
+  if (lvgl_task == NULL)
+  {
+    // First call: every caller runs in the LVGL task, so this is the task to measure
+    lvgl_task = xTaskGetCurrentTaskHandle();
+    last_run_time = ulTaskGetRunTimeCounter(lvgl_task);
+    last_sample_us = now_us;
+    return;
+  }
+  configRUN_TIME_COUNTER_TYPE run_time = ulTaskGetRunTimeCounter(lvgl_task);
+
+  taskENTER_CRITICAL(&stats_lock);
+  stats.time_us[current_mode] += (uint64_t)(now_us - last_sample_us);
+  stats.lvgl_run_us[current_mode] += (configRUN_TIME_COUNTER_TYPE)(run_time - last_run_time);
+  taskEXIT_CRITICAL(&stats_lock);
+
+  last_sample_us = now_us;
+  last_run_time = run_time;
+}
+
+/* LVGL task CPU share per refresh mode so far, in 0.1 % of one core */
+static void log_cpu_share(void)
+{
+  display_power_stats_t copy;
+  display_power_get_stats(&copy);
+  for (int i = 0; i < DISPLAY_RENDER_MODE_COUNT; i++)
+  {
+    if (copy.time_us[i] > 0)
+    {
+      unsigned long long permille = copy.lvgl_run_us[i] * 1000 / copy.time_us[i];
+      ESP_LOGI(TAG, "  %-9s %6llu s, LVGL task %3llu.%llu %%", mode_names[i],
+               (unsigned long long)(copy.time_us[i] / 1000000), permille / 10, permille % 10);
+    }
+  }
+}
+
+static void set_render_mode(display_render_mode_t mode)
+{
+  if (mode == current_mode)
+  {
+    return;
+  }
+  sample_run_time();
+
+  lv_timer_t *refr_timer = lv_display_get_refr_timer(power_disp);
+  switch (mode)
+  {
+  case DISPLAY_RENDER_FULL_RATE:
+    lv_timer_set_period(refr_timer, LV_DEF_REFR_PERIOD);
+    lv_timer_resume(refr_timer);
+    lv_timer_ready(refr_timer); // Pending changes should not wait out the long period
+    break;
+  case DISPLAY_RENDER_THROTTLED:
+    lv_timer_set_period(refr_timer, DISPLAY_IDLE_REFRESH_MS);
+    lv_timer_resume(refr_timer);
+    break;
+  default:
+    lv_timer_pause(refr_timer); // Invalidated areas accumulate and are drawn on wake-up
+    break;
+  }
+
+  taskENTER_CRITICAL(&stats_lock);
+  current_mode = mode;
+  stats.render_mode = mode;
+  taskEXIT_CRITICAL(&stats_lock);
+}
+
+static void set_state(display_idle_state_t state)
+{
+  if (state == current_state)
+  {
+    return;
+  }
+
+  if (state == DISPLAY_IDLE_SLEEP)
+  {
+    display_set_backlight(0);
+    display_set_panel_on(false);
+  }
+  else
+  {
+    if (current_state == DISPLAY_IDLE_SLEEP)
+    {
+      display_set_panel_on(true);
+    }
+    display_set_backlight(backlight_percent[state]);
+  }
+
+  ESP_LOGI(TAG, "Display %s", state_names[state]);
+  taskENTER_CRITICAL(&stats_lock);
+  if (state < current_state)
+  {
+    stats.wakes++;
+  }
+  stats.state = state;
+  taskEXIT_CRITICAL(&stats_lock);
+  current_state = state;
+
+  if (state == DISPLAY_IDLE_SLEEP)
+  {
+    log_cpu_share();
+  }
+}
+
+/**
+ * Display event callback - runs whenever an area is invalidated
+ * A change on screen ends throttling at once, so the first frame after a quiet spell is not late
+ */
+static void invalidate_event_cb(lv_event_t *e)
+{
+  last_invalidate_tick = lv_tick_get();
+  if (current_mode == DISPLAY_RENDER_THROTTLED)
+  {
+    set_render_mode(DISPLAY_RENDER_FULL_RATE);
+  }
+}
+
+/**
+ * Poll timer - runs every POWER_POLL_PERIOD_MS in the LVGL task, also while asleep
+ * Treats pressed buttons and active heater faults as activity and applies the resulting state
+ */
+static void power_poll_cb(lv_timer_t *timer)
+{
+  if (gpio_get_level(BOARD_BUTTON_BOOT) == 0 || gpio_get_level(BOARD_BUTTON_KEY) == 0)
+  {
+    display_power_wake();
+  }
+
+  float fault = 0.0f;
+  if (telemetry_get_latest(TELEMETRY_TOPIC_FAULT, &fault) && fault != 0.0f)
+  {
+    display_power_wake(); // Stay on while a fault is reported
+  }
+
+  uint32_t idle_ms = now_ms() - atomic_load(&last_activity_ms);
+  display_idle_state_t state = display_idle_state(&idle_config, idle_ms);
+  set_state(state);
+  set_render_mode(display_idle_render_mode(&idle_config, state, lv_tick_elaps(last_invalidate_tick),
+                                           lv_anim_count_running() > 0));
+  sample_run_time();
+}
+
+void display_power_start(void)
+{
+  idle_config.dim_after_ms = DISPLAY_DIM_AFTER_S * 1000;
+  idle_config.sleep_after_ms = DISPLAY_SLEEP_AFTER_S * 1000;
+  idle_config.throttle_after_ms = THROTTLE_AFTER_MS;
+
+  gpio_config_t button_config = {
+      .mode = GPIO_MODE_INPUT,
+      .pull_up_en = GPIO_PULLUP_ENABLE,
+      .pin_bit_mask = (1ULL << BOARD_BUTTON_BOOT) | (1ULL << BOARD_BUTTON_KEY)};
+  if (gpio_config(&button_config) != ESP_OK)
+  {
+    ESP_LOGW(TAG, "Buttons unavailable, only faults and web requests wake the display");
+  }
+
+  display_power_wake();
+
+  if (!lvgl_port_lock(0))
+  {
+    return;
+  }
+  power_disp = lv_display_get_default();
+  if (power_disp == NULL || poll_timer != NULL)
+  {
+    lvgl_port_unlock();
+    return;
+  }
+
+  last_invalidate_tick = lv_tick_get();
+  lv_display_add_event_cb(power_disp, invalidate_event_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+  poll_timer = lv_timer_create(power_poll_cb, POWER_POLL_PERIOD_MS, NULL);
+  lvgl_port_unlock();
+
+  ESP_LOGI(TAG, "Display power manager started: dim after %d s, off after %d s, idle refresh %d ms",
+           DISPLAY_DIM_AFTER_S, DISPLAY_SLEEP_AFTER_S, DISPLAY_IDLE_REFRESH_MS);
+}
@@ -0,0 +1,386 @@
+#include "drying_profile.h"
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <math.h>
+
+#define MIN_S(m) ((uint32_t)(m) * 60U)
+
+// Built-in recipes: ramp to the soak temperature, soak, then cool down or hold for storage.
+static const drying_profile_t s_builtin_profiles[] = {
+    {.name = "PLA",
+     .step_count = 2,
+     .steps = {
+         {.setpoint = 45.0f, .ramp_rate = 2.0f, .duration_s = MIN_S(240), .exit = PROFILE_EXIT_DURATION},
+         {.setpoint = 30.0f, .ramp_rate = 0.0f, .duration_s = MIN_S(30), .exit = PROFILE_EXIT_TEMP_REACHED},
+     }},
+    {.name = "PETG",
+     .step_count = 2,
+     .steps = {
+         {.setpoint = 65.0f, .ramp_rate = 2.0f, .duration_s = MIN_S(240), .exit = PROFILE_EXIT_DURATION},
+         {.setpoint = 45.0f, .ramp_rate = 1.0f, .duration_s = 0, .exit = PROFILE_EXIT_HOLD},
+     }},
+    {.name = "ABS",
+     .step_count = 2,
+     .steps = {
+         {.setpoint = 80.0f, .ramp_rate = 2.0f, .duration_s = MIN_S(240), .exit = PROFILE_EXIT_DURATION},
+         {.setpoint = 50.0f, .ramp_rate = 1.0f, .duration_s = 0, .exit = PROFILE_EXIT_HOLD},
+     }},
+    {.name = "ASA",
+     .step_count = 2,
+     .steps = {
+         {.setpoint = 80.0f, .ramp_rate = 2.0f, .duration_s = MIN_S(240), .exit = PROFILE_EXIT_DURATION},
+         {.setpoint = 50.0f, .ramp_rate = 1.0f, .duration_s = 0, .exit = PROFILE_EXIT_HOLD},
+     }},
+    {.name = "TPU",
+     .step_count = 2,
+     .steps = {
+         {.setpoint = 50.0f, .ramp_rate = 2.0f, .duration_s = MIN_S(240), .exit = PROFILE_EXIT_DURATION},
+         {.setpoint = 30.0f, .ramp_rate = 0.0f, .duration_s = MIN_S(30), .exit = PROFILE_EXIT_TEMP_REACHED},
+     }},
+    {.name = "NYLON",
+     .step_count = 2,
+     .steps = {
+         {.setpoint = 75.0f, .ramp_rate = 1.5f, .duration_s = MIN_S(480), .exit = PROFILE_EXIT_DURATION},
+         {.setpoint = 50.0f, .ramp_rate = 1.0f, .duration_s = 0, .exit = PROFILE_EXIT_HOLD},
+     }},
+};
+
+#define BUILTIN_PROFILE_COUNT (sizeof(s_builtin_profiles) / sizeof(s_builtin_profiles[0]))
+
+static const char *const s_exit_names[] = {
+    [PROFILE_EXIT_DURATION] = "time",
+    [PROFILE_EXIT_TEMP_REACHED] = "reached",
+    [PROFILE_EXIT_HOLD] = "hold",
+};
+
+size_t profile_builtin_count(void)
+{
+    return BUILTIN_PROFILE_COUNT;
+}
+
+const drying_profile_t *profile_builtin_get(size_t index)
+{
+    if (index >= BUILTIN_PROFILE_COUNT)
+    {
+        return NULL;
+    }
+    return &s_builtin_profiles[index];
+}
+
+const drying_profile_t *profile_builtin_find(const char *name)
+{
+    if (name == NULL)
+    {
+        return NULL;
+    }
+    for (size_t i = 0; i < BUILTIN_PROFILE_COUNT; i++)
+    {
+        if (strcasecmp(s_builtin_profiles[i].name, name) == 0)
+        {
+            return &s_builtin_profiles[i];
+        }
+    }
+    return NULL;
+}
+
+bool profile_name_is_valid(const char *name)
+{
+    if (name == NULL || name[0] == '\0')
+    {
+        return false;
+    }
+
+    size_t len = 0;
+    for (const char *c = name; *c != '\0'; c++, len++)
+    {
+        if (len >= PROFILE_NAME_MAX - 1)
+        {
+            return false;
+        }
+        if (!isalnum((unsigned char)*c) && *c != '_' && *c != '-')
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool parse_exit(const char *token, profile_exit_t *exit)
+{
+    for (size_t i = 0; i < sizeof(s_exit_names) / sizeof(s_exit_names[0]); i++)
+    {
+        if (strcasecmp(token, s_exit_names[i]) == 0)
+        {
+            *exit = (profile_exit_t)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool profile_parse(const char *name, const char *text, drying_profile_t *out)
+{
+    if (!profile_name_is_valid(name) || text == NULL || out == NULL)
+    {
+        return false;
+    }
+
+    drying_profile_t profile = {0};
+    strncpy(profile.name, name, PROFILE_NAME_MAX - 1);
+
+    const char *line = text;
+    while (*line != '\0')
+    {
+        const char *end = strchr(line, '\n');
+        size_t line_len = end ? (size_t)(end - line) : strlen(line);
+
+        char buf[64];
+        if (line_len >= sizeof(buf))
+        {
+            return false; // No valid step line is this long
+        }
+        memcpy(buf, line, line_len);
+        buf[line_len] = '\0';
+
+        // Skip leading whitespace, then ignore blank and comment lines
+        char *p = buf;
+        while (isspace((unsigned char)*p))
+        {
+            p++;
+        }
+
+        if (*p != '\0' && *p != '#')
+        {
+            float setpoint = 0.0f;
+            float ramp_rate = 0.0f;
+            float duration_min = 0.0f;
+            char exit_token[12] = {0};
+
+            if (profile.step_count >= PROFILE_MAX_STEPS ||
+                sscanf(p, "%f , %f , %f , %11[a-zA-Z]", &setpoint, &ramp_rate, &duration_min, exit_token) != 4)
+            {
+                return false;
+            }
+
+            profile_step_t *step = &profile.steps[profile.step_count];
+            // Written so that NaN fails every range
+            if (!parse_exit(exit_token, &step->exit) ||
+                !(setpoint >= PROFILE_SETPOINT_MIN && setpoint <= PROFILE_SETPOINT_MAX) ||
+                !(ramp_rate >= 0.0f && ramp_rate <= PROFILE_RAMP_RATE_MAX) ||
+                !(duration_min >= 0.0f && duration_min <= PROFILE_DURATION_MAX_MIN))
+            {
+                return false;
+            }
+
+            step->setpoint = setpoint;
+            step->ramp_rate = ramp_rate;
+            step->duration_s = (uint32_t)(duration_min * 60.0f + 0.5f);
+            profile.step_count++;
+        }
+
+        line = end ? end + 1 : line + line_len;
+    }
+
+    if (profile.step_count == 0)
+    {
+        return false;
+    }
+
+    *out = profile;
+    return true;
+}
+
+int profile_format(const drying_profile_t *profile, char *buf, size_t len)
+{
+    if (profile == NULL || buf == NULL || len == 0)
+    {
+        return -1;
+    }
+
+    size_t written = 0;
+    int n = snprintf(buf, len, "# %s: setpoint_c,ramp_c_per_min,duration_min,exit\n", profile->name);
+    if (n < 0 || (size_t)n >= len)
+    {
+        return -1;
+    }
+    written = (size_t)n;
+
+    for (uint8_t i = 0; i < profile->step_count; i++)
+    {
+        const profile_step_t *step = &profile->steps[i];
+        n = snprintf(buf + written, len - written, "%.1f,%.1f,%.1f,%s\n",
+                     step->setpoint, step->ramp_rate, step->duration_s / 60.0f, s_exit_names[step->exit]);
+        if (n < 0 || (size_t)n >= len - written)
+        {
+            return -1;
+        }
+        written += (size_t)n;
+    }
+
+    return (int)written;
+}
+
+static void enter_step(profile_runner_t *runner, uint8_t step, uint32_t now_s)
+{
+    runner->step = step;
+    runner->step_origin = runner->setpoint;
+    runner->step_start_s = now_s;
+    runner->soak_start_s = now_s;
+    runner->ramp_done = false;
+}
+
+void profile_runner_start(profile_runner_t *runner, const drying_profile_t *profile, float air_temp, uint32_t now_s)
+{
+    if (runner == NULL || profile == NULL || profile->step_count == 0)
+    {
+        return;
+    }
+
+    runner->profile = *profile;
+    runner->running = true;
+    runner->setpoint = air_temp; // First ramp starts from the current air temperature
+    runner->last_tick_s = now_s;
+    enter_step(runner, 0, now_s);
+}
+
+void profile_runner_stop(profile_runner_t *runner)
+{
+    if (runner != NULL)
+    {
+        runner->running = false;
+    }
+}
+
+// Returns true once the air temperature has reached the step's setpoint from the ramp direction
+static bool step_reached(const profile_runner_t *runner, const profile_step_t *step, float air_temp)
+{
+    if (step->setpoint >= runner->step_origin)
+    {
+        return air_temp >= step->setpoint - PROFILE_REACHED_BAND;
+    }
+    return air_temp <= step->setpoint + PROFILE_REACHED_BAND;
+}
+
+bool profile_runner_tick(profile_runner_t *runner, float air_temp, uint32_t now_s)
+{
+    if (runner == NULL || !runner->running)
+    {
+        return false;
+    }
+
+    uint32_t dt_s = now_s - runner->last_tick_s;
+    runner->last_tick_s = now_s;
+
+    const profile_step_t *step = &runner->profile.steps[runner->step];
+
+    // Ramp phase: slew the setpoint toward the step target at the configured rate
+    if (!runner->ramp_done)
+    {
+        if (step->ramp_rate <= 0.0f)
+        {
+            runner->setpoint = step->setpoint;
+        }
+        else
+        {
+            float max_delta = step->ramp_rate * (float)dt_s / 60.0f;
+            float delta = step->setpoint - runner->setpoint;
+            if (fabsf(delta) <= max_delta)
+            {
+                runner->setpoint = step->setpoint;
+            }
+            else
+            {
+                runner->setpoint += (delta > 0.0f) ? max_delta : -max_delta;
+            }
+        }
+
+        if (runner->setpoint == step->setpoint)
+        {
+            runner->ramp_done = true;
+            runner->soak_start_s = now_s;
+        }
+    }
+
+    bool step_complete = false;
+    switch (step->exit)
+    {
+    case PROFILE_EXIT_DURATION:
+        step_complete = runner->ramp_done && (now_s - runner->soak_start_s) >= step->duration_s;
+        break;
+
+    case PROFILE_EXIT_TEMP_REACHED:
+        step_complete = (runner->ramp_done && step_reached(runner, step, air_temp)) ||
+                        (step->duration_s > 0 && (now_s - runner->step_start_s) >= step->duration_s);
+        break;
+
+    case PROFILE_EXIT_HOLD:
+    default:
+        break;
+    }
+
+    if (step_complete)
+    {
+        if (runner->step + 1 >= runner->profile.step_count)
+        {
+            runner->running = false;
+            return false;
+        }
+        enter_step(runner, runner->step + 1, now_s);
+    }
+
+    return true;
+}
+
+// Seconds needed to ramp between two setpoints at the given rate
+static uint32_t ramp_time_s(float from, float to, float rate)
+{
+    if (rate <= 0.0f)
+    {
+        return 0;
+    }
+    return (uint32_t)(fabsf(to - from) * 60.0f / rate + 0.5f);
+}
+
+uint32_t profile_runner_remaining_s(const profile_runner_t *runner, uint32_t now_s)
+{
+    if (runner == NULL || !runner->running)
+    {
+        return 0;
+    }
+
+    const drying_profile_t *profile = &runner->profile;
+    const profile_step_t *step = &profile->steps[runner->step];
+    uint32_t remaining = 0;
+
+    // Current step
+    if (!runner->ramp_done)
+    {
+        remaining += ramp_time_s(runner->setpoint, step->setpoint, step->ramp_rate);
+        if (step->exit == PROFILE_EXIT_DURATION)
+        {
+            remaining += step->duration_s;
+        }
+    }
+    else if (step->exit == PROFILE_EXIT_DURATION)
+    {
+        uint32_t elapsed = now_s - runner->soak_start_s;
+        remaining += (elapsed < step->duration_s) ? step->duration_s - elapsed : 0;
+    }
+
+    // Following steps
+    float previous = step->setpoint;
+    for (uint8_t i = runner->step + 1; i < profile->step_count; i++)
+    {
+        const profile_step_t *next = &profile->steps[i];
+        remaining += ramp_time_s(previous, next->setpoint, next->ramp_rate);
+        if (next->exit == PROFILE_EXIT_DURATION)
+        {
+            remaining += next->duration_s;
+        }
+        previous = next->setpoint;
+    }
+
+    return remaining;
+}
@@ -0,0 +1,147 @@
+#include <stdio.h>
+#include <string.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include "esp_log.h"
+#include "drying_profile_store.h"
+
+static const char *TAG = "PROFILE_STORE";
+
+#define PROFILE_FILE_EXT ".csv"
+
+/**
+ * @brief Build the LittleFS path of a profile file
+ * @return true if the name is valid and the path fits
+ */
+static bool profile_path(const char *name, char *path, size_t len)
+{
+  if (!profile_name_is_valid(name))
+  {
+    return false;
+  }
+  int n = snprintf(path, len, "%s/%s%s", PROFILE_STORE_DIR, name, PROFILE_FILE_EXT);
+  return n > 0 && (size_t)n < len;
+}
+
+esp_err_t profile_store_save(const drying_profile_t *profile)
+{
+  char path[64];
+  if (profile == NULL || !profile_path(profile->name, path, sizeof(path)))
+  {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  char text[PROFILE_TEXT_MAX];
+  int len = profile_format(profile, text, sizeof(text));
+  if (len < 0)
+  {
+    return ESP_ERR_INVALID_SIZE;
+  }
+
+  // Directory may already exist; fopen below reports any real failure
+  mkdir(PROFILE_STORE_DIR, 0775);
+
+  FILE *file = fopen(path, "w");
+  if (file == NULL)
+  {
+    ESP_LOGE(TAG, "Failed to open %s for writing", path);
+    return ESP_FAIL;
+  }
+
+  size_t written = fwrite(text, 1, (size_t)len, file);
+  fclose(file);
+  if (written != (size_t)len)
+  {
+    ESP_LOGE(TAG, "Short write to %s (%zu of %d bytes)", path, written, len);
+    return ESP_FAIL;
+  }
+
+  ESP_LOGI(TAG, "Saved profile %s (%u steps)", profile->name, profile->step_count);
+  return ESP_OK;
+}
+
+esp_err_t profile_store_load(const char *name, drying_profile_t *profile)
+{
+  char path[64];
+  if (profile == NULL || !profile_path(name, path, sizeof(path)))
+  {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  FILE *file = fopen(path, "r");
+  if (file == NULL)
+  {
+    return ESP_ERR_NOT_FOUND;
+  }
+
+  char text[PROFILE_TEXT_MAX];
+  size_t len = fread(text, 1, sizeof(text) - 1, file);
+  fclose(file);
+  text[len] = '\0';
+
+  if (!profile_parse(name, text, profile))
+  {
+    ESP_LOGW(TAG, "Stored profile %s is malformed", name);
+    return ESP_ERR_INVALID_STATE;
+  }
+  return ESP_OK;
+}
+
+esp_err_t profile_store_delete(const char *name)
+{
+  char path[64];
+  if (!profile_path(name, path, sizeof(path)))
+  {
+    return ESP_ERR_INVALID_ARG;
+  }
+  return remove(path) == 0 ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+size_t profile_store_list(char names[][PROFILE_NAME_MAX], size_t max_names)
+{
+  DIR *dir = opendir(PROFILE_STORE_DIR);
+  if (dir == NULL)
+  {
+    return 0; // Nothing uploaded yet
+  }
+
+  size_t count = 0;
+  struct dirent *entry;
+  while (count < max_names && (entry = readdir(dir)) != NULL)
+  {
+    const char *ext = strrchr(entry->d_name, '.');
+    if (ext == NULL || strcmp(ext, PROFILE_FILE_EXT) != 0)
+    {
+      continue;
+    }
+
+    size_t name_len = (size_t)(ext - entry->d_name);
+    if (name_len == 0 || name_len >= PROFILE_NAME_MAX)
+    {
+      continue;
+    }
+    memcpy(names[count], entry->d_name, name_len);
+    names[count][name_len] = '\0';
+    count++;
+  }
+
+  closedir(dir);
+  return count;
+}
+
+esp_err_t profile_store_find(const char *name, drying_profile_t *profile)
+{
+  esp_err_t ret = profile_store_load(name, profile);
+  if (ret == ESP_OK)
+  {
+    return ESP_OK;
+  }
+
+  const drying_profile_t *builtin = profile_builtin_find(name);
+  if (builtin == NULL)
+  {
+    return ESP_ERR_NOT_FOUND;
+  }
+  *profile = *builtin;
+  return ESP_OK;
+}
@@ -0,0 +1,100 @@
+#include "energy_session_store.h"
+#include "nvs.h"
+#include "esp_log.h"
+#include <string.h>
+
+static const char *TAG = "ENERGY_NVS";
+
+// Stored blob: a ring of the most recent sessions
+typedef struct
+{
+    uint32_t version;
+    uint32_t count; // Valid entries
+    uint32_t next;  // Slot the next session goes into
+    energy_session_t sessions[ENERGY_SESSION_HISTORY];
+} stored_energy_sessions_t;
+
+// Reads the ring from an open handle; an empty ring if nothing valid is stored
+static void read_history(nvs_handle_t handle, stored_energy_sessions_t *stored)
+{
+    size_t size = sizeof(*stored);
+    esp_err_t ret = nvs_get_blob(handle, ENERGY_NVS_KEY, stored, &size);
+    if (ret != ESP_OK || size != sizeof(*stored) || stored->version != ENERGY_SESSION_VERSION ||
+        stored->count > ENERGY_SESSION_HISTORY || stored->next >= ENERGY_SESSION_HISTORY)
+    {
+        if (ret == ESP_OK)
+        {
+            ESP_LOGW(TAG, "Ignoring stored energy history (version %lu, %u bytes)",
+                     (unsigned long)stored->version, (unsigned)size);
+        }
+        memset(stored, 0, sizeof(*stored));
+        stored->version = ENERGY_SESSION_VERSION;
+    }
+}
+
+esp_err_t energy_session_save(const energy_session_t *session)
+{
+    if (session == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    nvs_handle_t handle;
+    esp_err_t ret = nvs_open(ENERGY_NVS_NAMESPACE, NVS_READWRITE, &handle);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to open NVS: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    stored_energy_sessions_t stored; // ~550 bytes
+    read_history(handle, &stored);
+    stored.sessions[stored.next] = *session;
+    stored.next = (stored.next + 1) % ENERGY_SESSION_HISTORY;
+    if (stored.count < ENERGY_SESSION_HISTORY)
+    {
+        stored.count++;
+    }
+
+    ret = nvs_set_blob(handle, ENERGY_NVS_KEY, &stored, sizeof(stored));
+    if (ret == ESP_OK)
+    {
+        ret = nvs_commit(handle);
+    }
+    nvs_close(handle);
+
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to save energy session: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    ESP_LOGI(TAG, "Saved session %s: %.1f Wh over %lu s", session->profile, session->energy_wh,
+             (unsigned long)session->duration_s);
+    return ESP_OK;
+}
+
+size_t energy_session_load(energy_session_t *sessions, size_t max)
+{
+    if (sessions == NULL || max == 0)
+    {
+        return 0;
+    }
+
+    nvs_handle_t handle;
+    if (nvs_open(ENERGY_NVS_NAMESPACE, NVS_READONLY, &handle) != ESP_OK)
+    {
+        return 0; // Nothing stored yet
+    }
+
+    stored_energy_sessions_t stored;
+    read_history(handle, &stored);
+    nvs_close(handle);
+
+    size_t count = stored.count < max ? stored.count : max;
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t slot = (stored.next + ENERGY_SESSION_HISTORY - 1 - i) % ENERGY_SESSION_HISTORY;
+        sessions[i] = stored.sessions[slot];
+    }
+    return count;
+}
@@ -0,0 +1,153 @@
+#include "fan.h"
+#include "esp_log.h"
+#include "driver/ledc.h"
+#include "driver/pulse_cnt.h"
+#include "driver/gpio.h"
+#include "product_pins.h" // For BOARD_FAN_PWM_GPIO / BOARD_FAN_TACH_GPIO
+
+static const char *TAG = "FAN";
+
+#define FAN_TACH_HIGH_LIMIT 32767 // Counter range; a second at 6000 RPM is 200 pulses
+
+static pcnt_unit_handle_t s_tach_unit = NULL;
+static uint8_t s_duty_percent = 0;
+
+/**
+ * @brief Sets up the PCNT unit that counts rising edges on the tach line
+ * @return ESP_OK on success
+ */
+static esp_err_t tach_init(void)
+{
+    pcnt_unit_config_t unit_config = {
+        .low_limit = -1, // Only counts up
+        .high_limit = FAN_TACH_HIGH_LIMIT,
+    };
+    esp_err_t ret = pcnt_new_unit(&unit_config, &s_tach_unit);
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+
+    pcnt_glitch_filter_config_t filter_config = {
+        .max_glitch_ns = FAN_TACH_GLITCH_NS,
+    };
+    ret = pcnt_unit_set_glitch_filter(s_tach_unit, &filter_config);
+
+    pcnt_chan_config_t chan_config = {
+        .edge_gpio_num = BOARD_FAN_TACH_GPIO,
+        .level_gpio_num = -1,
+    };
+    pcnt_channel_handle_t channel = NULL;
+    if (ret == ESP_OK)
+    {
+        ret = pcnt_new_channel(s_tach_unit, &chan_config, &channel);
+    }
+    if (ret == ESP_OK)
+    {
+        ret = pcnt_channel_set_edge_action(channel, PCNT_CHANNEL_EDGE_ACTION_INCREASE, PCNT_CHANNEL_EDGE_ACTION_HOLD);
+    }
+    if (ret == ESP_OK)
+    {
+        // The tach output is open-collector; the pull-up is applied after PCNT claimed the pin
+        gpio_pullup_en(BOARD_FAN_TACH_GPIO);
+        ret = pcnt_unit_enable(s_tach_unit);
+    }
+    if (ret == ESP_OK)
+    {
+        ret = pcnt_unit_clear_count(s_tach_unit);
+    }
+    if (ret == ESP_OK)
+    {
+        ret = pcnt_unit_start(s_tach_unit);
+    }
+    return ret;
+}
+
+esp_err_t fan_init(void)
+{
+    // LEDC timer 0 runs the heater at 100 Hz; the fan needs its own timer for 25 kHz
+    ledc_timer_config_t ledc_timer = {
+        .speed_mode = LEDC_LOW_SPEED_MODE,
+        .timer_num = LEDC_TIMER_1,
+        .duty_resolution = (ledc_timer_bit_t)FAN_PWM_RESOLUTION_BITS,
+        .freq_hz = FAN_PWM_FREQ_HZ,
+        .clk_cfg = LEDC_AUTO_CLK,
+    };
+    esp_err_t ret = ledc_timer_config(&ledc_timer);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to configure fan PWM timer: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    ledc_channel_config_t ledc_channel = {
+        .speed_mode = LEDC_LOW_SPEED_MODE,
+        .channel = LEDC_CHANNEL_1,
+        .timer_sel = LEDC_TIMER_1,
+        .intr_type = LEDC_INTR_DISABLE,
+        .gpio_num = BOARD_FAN_PWM_GPIO,
+        .duty = 0,
+        .hpoint = 0};
+    ret = ledc_channel_config(&ledc_channel);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to configure fan PWM channel: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    s_duty_percent = 0;
+
+    ret = tach_init();
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to initialize fan tachometer: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    ESP_LOGI(TAG, "Fan initialized: PWM on GPIO %d (%d Hz), tach on GPIO %d", BOARD_FAN_PWM_GPIO, FAN_PWM_FREQ_HZ,
+             BOARD_FAN_TACH_GPIO);
+    return ESP_OK;
+}
+
+void fan_set_duty(uint8_t percent)
+{
+    if (percent > 100)
+    {
+        percent = 100;
+    }
+    if (percent == s_duty_percent)
+    {
+        return;
+    }
+
+    uint32_t duty = ((uint32_t)percent * FAN_DUTY_MAX + 50) / 100;
+    esp_err_t ret = ledc_set_duty_and_update(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_1, duty, 0);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to set fan duty %u%%: %s", percent, esp_err_to_name(ret));
+        return;
+    }
+    s_duty_percent = percent;
+    ESP_LOGD(TAG, "Fan duty set to %u%%", percent);
+}
+
+uint8_t fan_get_duty(void)
+{
+    return s_duty_percent;
+}
+
+uint32_t fan_read_tach_pulses(void)
+{
+    if (s_tach_unit == NULL)
+    {
+        return 0;
+    }
+
+    // Pulses arriving between the read and the clear are lost; at most one per read, well under 1%
+    int count = 0;
+    if (pcnt_unit_get_count(s_tach_unit, &count) != ESP_OK)
+    {
+        return 0;
+    }
+    pcnt_unit_clear_count(s_tach_unit);
+    return count > 0 ? (uint32_t)count : 0;
+}
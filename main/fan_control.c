@@ -0,0 +1,114 @@
+#include "fan_control.h"
+#include "esp_log.h"
+#include <string.h>
+
+static const char *TAG = "FAN_CONTROL";
+
+void fan_control_reset(fan_control_t *fc)
+{
+    memset(fc, 0, sizeof(*fc));
+}
+
+void fan_control_set_target(fan_control_t *fc, const fan_control_config_t *config, uint16_t rpm)
+{
+    if (rpm > config->max_rpm)
+    {
+        rpm = config->max_rpm;
+    }
+    if (fc->target_rpm == 0 && rpm > 0)
+    {
+        // Starting from rest: the fan needs a moment before the tach reports anything
+        fc->spinup_left_ms = config->spinup_ms;
+        fc->slow_ms = 0;
+    }
+    fc->target_rpm = rpm;
+}
+
+// Stall detection; returns true while the fan is stalled
+static bool update_stall(fan_control_t *fc, const fan_control_config_t *config, uint32_t elapsed_ms)
+{
+    if (fc->spinup_left_ms > 0)
+    {
+        fc->spinup_left_ms = elapsed_ms >= fc->spinup_left_ms ? 0 : fc->spinup_left_ms - elapsed_ms;
+        return fc->stalled;
+    }
+
+    if (fc->rpm >= config->stall_rpm)
+    {
+        if (fc->stalled)
+        {
+            ESP_LOGI(TAG, "Fan turning again at %u RPM", fc->rpm);
+            fc->integral = 0.0f; // Restart the loop from feed-forward
+        }
+        fc->stalled = false;
+        fc->slow_ms = 0;
+        return false;
+    }
+
+    fc->slow_ms += elapsed_ms;
+    if (!fc->stalled && fc->slow_ms >= config->stall_time_ms)
+    {
+        ESP_LOGE(TAG, "Fan stalled: %u RPM at %u%% duty for %lu ms", fc->rpm, fc->duty, (unsigned long)fc->slow_ms);
+        fc->stalled = true;
+    }
+    return fc->stalled;
+}
+
+uint8_t fan_control_update(fan_control_t *fc, const fan_control_config_t *config, uint32_t pulses, uint32_t elapsed_ms)
+{
+    if (elapsed_ms == 0 || config->pulses_per_rev == 0 || config->max_rpm == 0)
+    {
+        return fc->duty;
+    }
+
+    uint32_t rpm = (uint32_t)(((uint64_t)pulses * 60000u) / ((uint32_t)config->pulses_per_rev * elapsed_ms));
+    fc->rpm = rpm > UINT16_MAX ? UINT16_MAX : (uint16_t)rpm;
+
+    if (fc->target_rpm == 0)
+    {
+        fc->duty = 0;
+        fc->integral = 0.0f;
+        fc->slow_ms = 0;
+        fc->stalled = false;
+        return 0;
+    }
+
+    if (update_stall(fc, config, elapsed_ms))
+    {
+        fc->duty = 100;
+        return fc->duty;
+    }
+
+    // PI around a feed-forward estimate of the duty for the target speed
+    float dt_s = elapsed_ms / 1000.0f;
+    float error = (float)fc->target_rpm - (float)fc->rpm;
+    float feed_forward = (float)fc->target_rpm * 100.0f / (float)config->max_rpm;
+    float integral = fc->integral + config->ki * error * dt_s;
+    float output = feed_forward + config->kp * error + integral;
+
+    // Conditional integration: hold the integral while saturated in the direction of the error
+    if ((output > 100.0f && error > 0.0f) || (output < config->min_duty && error < 0.0f))
+    {
+        output = feed_forward + config->kp * error + fc->integral;
+    }
+    else
+    {
+        fc->integral = integral;
+    }
+
+    if (output > 100.0f)
+    {
+        output = 100.0f;
+    }
+    else if (output < config->min_duty)
+    {
+        output = config->min_duty;
+    }
+    fc->duty = (uint8_t)(output + 0.5f);
+    return fc->duty;
+}
+
+bool fan_control_airflow_ok(const fan_control_t *fc, const fan_control_config_t *config)
+{
+    return fc->target_rpm > 0 && !fc->stalled && fc->rpm >= config->stall_rpm;
+}
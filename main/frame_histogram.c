@@ -0,0 +1,64 @@
+#include "frame_histogram.h"
+#include <string.h>
+
+void frame_histogram_init(frame_histogram_t *h, uint32_t unit)
+{
+    memset(h, 0, sizeof(*h));
+    h->unit = unit > 0 ? unit : 1;
+}
+
+void frame_histogram_add(frame_histogram_t *h, uint32_t value)
+{
+    // Bucket = number of significant bits of value / unit: 0 -> 0, 1 -> 1, 2..3 -> 2, 4..7 -> 3, ...
+    uint32_t q = value / h->unit;
+    int bucket = q == 0 ? 0 : 32 - __builtin_clz(q);
+    if (bucket > FRAME_HISTOGRAM_BUCKETS - 1)
+    {
+        bucket = FRAME_HISTOGRAM_BUCKETS - 1;
+    }
+
+    h->counts[bucket]++;
+    h->samples++;
+    h->sum += value;
+    if (value > h->max)
+    {
+        h->max = value;
+    }
+}
+
+uint32_t frame_histogram_bucket_limit(const frame_histogram_t *h, int bucket)
+{
+    if (bucket >= FRAME_HISTOGRAM_BUCKETS - 1)
+    {
+        return UINT32_MAX;
+    }
+    uint64_t limit = (uint64_t)h->unit << bucket;
+    return limit > UINT32_MAX ? UINT32_MAX : (uint32_t)limit;
+}
+
+uint32_t frame_histogram_mean(const frame_histogram_t *h)
+{
+    return h->samples == 0 ? 0 : (uint32_t)(h->sum / h->samples);
+}
+
+uint32_t frame_histogram_percentile(const frame_histogram_t *h, uint32_t percent)
+{
+    if (h->samples == 0)
+    {
+        return 0;
+    }
+
+    // Rank of the sample at the percentile, rounded up so p100 is the last sample
+    uint64_t rank = ((uint64_t)h->samples * percent + 99) / 100;
+    uint64_t seen = 0;
+    for (int i = 0; i < FRAME_HISTOGRAM_BUCKETS; i++)
+    {
+        seen += h->counts[i];
+        if (seen >= rank)
+        {
+            uint32_t limit = frame_histogram_bucket_limit(h, i);
+            return limit < h->max ? limit : h->max;
+        }
+    }
+    return h->max;
+}
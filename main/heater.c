@@ -1,11 +1,60 @@
 #include "heater.h"
+#include "sigma_delta.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "driver/gpio.h"
 #include "driver/ledc.h"
 #include "product_pins.h" // For BOARD_HEATER_GPIO
+#include <stdatomic.h>
 
 static const char *TAG = "HEATER";
 
+#define HEATER_DUTY_UNKNOWN UINT32_MAX // Forces the next write through
+
+static volatile bool s_forced_off = false;                 // Latched by heater_force_off(), blocks set_heat_power()
+static volatile uint32_t s_duty = HEATER_DUTY_UNKNOWN;     // Duty last written to LEDC channel 0
+static uint32_t s_fade_ms = HEATER_DEFAULT_FADE_MS;
+static bool s_fade_installed = false;
+
+static volatile heater_modulation_t s_modulation = HEATER_MODULATION_PWM;
+static esp_timer_handle_t s_sd_timer = NULL;
+static sigma_delta_t s_sd;            // Only touched by the timer callback (and while the timer is stopped)
+static atomic_uint s_sd_level;        // Duty requested by heater_set_duty() in sigma-delta mode
+static uint32_t s_sd_output = 0;      // Level last written by the timer callback (0 or HEATER_DUTY_MAX)
+static power_limiter_t s_limiter;     // Power budget applied after the controller's decision
+
+// Writes a duty straight to the LEDC channel; false on error
+static bool write_output(uint32_t duty)
+{
+    esp_err_t ret = ledc_set_duty_and_update(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_0, duty, 0);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to set heater duty %lu: %s", (unsigned long)duty, esp_err_to_name(ret));
+        return false;
+    }
+    return true;
+}
+
+// Sigma-delta slot: runs in the esp_timer task every HEATER_SIGMA_DELTA_PERIOD_MS
+static void sigma_delta_timer_callback(void *arg)
+{
+    if (s_modulation != HEATER_MODULATION_SIGMA_DELTA)
+    {
+        return; // A slot that was already running when the mode switched back to PWM
+    }
+    sigma_delta_set_level(&s_sd, s_forced_off ? 0 : atomic_load(&s_sd_level));
+    uint32_t output = sigma_delta_step(&s_sd) ? HEATER_DUTY_MAX : 0;
+
+    // Only edges touch the peripheral: at low power that is a couple of writes per second
+    if (output != s_sd_output && !(output > 0 && s_forced_off))
+    {
+        if (write_output(output))
+        {
+            s_sd_output = output;
+        }
+    }
+}
+
 void heater_init(void)
 {
     // Configure heater GPIO as output
@@ -16,8 +65,8 @@ void heater_init(void)
     ledc_timer_config_t ledc_timer = {
         .speed_mode = LEDC_LOW_SPEED_MODE,
         .timer_num = LEDC_TIMER_0,
-        .duty_resolution = LEDC_TIMER_8_BIT, // 0 - 255
-        .freq_hz = 100,                      // Set output frequency at 100 Hz
+        .duty_resolution = (ledc_timer_bit_t)HEATER_PWM_RESOLUTION_BITS, // 0 - HEATER_DUTY_MAX
+        .freq_hz = HEATER_PWM_FREQ_HZ,
         .clk_cfg = LEDC_AUTO_CLK,
     };
     ESP_ERROR_CHECK(ledc_timer_config(&ledc_timer));
@@ -32,12 +81,190 @@ void heater_init(void)
         .duty = 0, // Set duty cycle to 0%
         .hpoint = 0};
     ESP_ERROR_CHECK(ledc_channel_config(&ledc_channel));
-    ESP_LOGI(TAG, "Heater initialized using GPIO %d", BOARD_HEATER_GPIO);
+    s_duty = 0;
+
+    // The fade engine is optional: without it every change is a step
+    esp_err_t ret = ledc_fade_func_install(0);
+    s_fade_installed = (ret == ESP_OK);
+    if (!s_fade_installed)
+    {
+        ESP_LOGW(TAG, "LEDC fade unavailable (%s), heater power changes will step", esp_err_to_name(ret));
+    }
+
+    const power_limit_config_t limit = {
+        .max_average = HEATER_DUTY_MAX * HEATER_POWER_LIMIT_AVG_PERCENT / 100,
+        .peak = HEATER_DUTY_MAX * HEATER_POWER_LIMIT_PEAK_PERCENT / 100,
+        .window_ms = HEATER_POWER_LIMIT_AVG_PERCENT < 100 ? HEATER_POWER_LIMIT_WINDOW_S * 1000 : 0,
+    };
+    heater_set_power_limit(&limit);
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = sigma_delta_timer_callback,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "heater_sd",
+    };
+    ESP_ERROR_CHECK(esp_timer_create(&timer_args, &s_sd_timer));
+    sigma_delta_init(&s_sd, HEATER_DUTY_MAX);
+    heater_set_modulation(HEATER_DEFAULT_MODULATION);
+
+    ESP_LOGI(TAG, "Heater initialized using GPIO %d (%d-bit PWM at %d Hz)", BOARD_HEATER_GPIO,
+             HEATER_PWM_RESOLUTION_BITS, HEATER_PWM_FREQ_HZ);
+}
+
+void heater_set_modulation(heater_modulation_t mode)
+{
+    if (mode == s_modulation || s_sd_timer == NULL)
+    {
+        return;
+    }
+
+    uint32_t duty = heater_get_duty();
+    if (mode == HEATER_MODULATION_SIGMA_DELTA)
+    {
+        if (s_fade_installed)
+        {
+            ledc_fade_stop(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_0);
+        }
+        write_output(0);
+        s_sd_output = 0;
+        sigma_delta_init(&s_sd, HEATER_DUTY_MAX);
+        atomic_store(&s_sd_level, duty);
+        s_modulation = mode;
+        esp_timer_start_periodic(s_sd_timer, HEATER_SIGMA_DELTA_PERIOD_MS * 1000);
+        ESP_LOGI(TAG, "Heater modulation: sigma-delta, %d ms slots", HEATER_SIGMA_DELTA_PERIOD_MS);
+    }
+    else
+    {
+        s_modulation = mode; // First, so a slot already in progress leaves the output alone
+        esp_timer_stop(s_sd_timer);
+        s_duty = HEATER_DUTY_UNKNOWN; // The output holds the last slot, not the duty
+        heater_set_duty(s_limiter.requested);
+        ESP_LOGI(TAG, "Heater modulation: PWM at %d Hz", HEATER_PWM_FREQ_HZ);
+    }
+}
+
+heater_modulation_t heater_get_modulation(void)
+{
+    return s_modulation;
+}
+
+void heater_set_duty(uint32_t duty)
+{
+    if (s_forced_off)
+    {
+        duty = 0;
+    }
+    if (duty > HEATER_DUTY_MAX)
+    {
+        duty = HEATER_DUTY_MAX;
+    }
+    // Runs on every call, not just on changes: it also integrates the duty delivered so far.
+    // heater_tick() repeats the call so a duty held between controller writes stays metered.
+    duty = power_limiter_apply(&s_limiter, duty, esp_timer_get_time() / 1000);
+
+    // The controller repeats the same level every cycle; only touch the peripheral on a change
+    if (duty == s_duty)
+    {
+        return;
+    }
+
+    if (s_modulation == HEATER_MODULATION_SIGMA_DELTA)
+    {
+        atomic_store(&s_sd_level, duty); // Picked up by the next slot
+        s_duty = duty;
+        ESP_LOGD(TAG, "Heater sigma-delta level set to %lu/%u", (unsigned long)duty, HEATER_DUTY_MAX);
+        return;
+    }
+
+    esp_err_t ret;
+    if (s_fade_installed && s_fade_ms > 0 && duty > 0)
+    {
+        ret = ledc_set_fade_time_and_start(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_0, duty, s_fade_ms, LEDC_FADE_NO_WAIT);
+    }
+    else
+    {
+        // Switching off never fades; stop any fade in progress so it cannot overwrite the step
+        if (s_fade_installed)
+        {
+            ledc_fade_stop(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_0);
+        }
+        // Set duty cycle and update atomically for thread safety
+        ret = ledc_set_duty_and_update(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_0, duty, 0);
+    }
+
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to set heater duty %lu: %s", (unsigned long)duty, esp_err_to_name(ret));
+        s_duty = HEATER_DUTY_UNKNOWN; // Retry on the next call
+        return;
+    }
+    s_duty = duty;
+    ESP_LOGD(TAG, "Heater duty set to %lu/%u", (unsigned long)duty, HEATER_DUTY_MAX);
+}
+
+void heater_tick(void)
+{
+    heater_set_duty(s_limiter.requested);
 }
 
 void set_heat_power(uint8_t power)
 {
-    // Set duty cycle and update atomically for thread safety
-    ESP_ERROR_CHECK(ledc_set_duty_and_update(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_0, power, 0));
-    ESP_LOGD(TAG, "Setting heat power to %u", power);
+    // Rounded so that 255 maps exactly to HEATER_DUTY_MAX
+    heater_set_duty(((uint32_t)power * HEATER_DUTY_MAX + 127) / 255);
+}
+
+uint32_t heater_get_duty(void)
+{
+    uint32_t duty = s_duty;
+    return duty == HEATER_DUTY_UNKNOWN ? 0 : duty;
+}
+
+void heater_set_fade_time(uint32_t fade_ms)
+{
+    s_fade_ms = fade_ms;
+}
+
+void heater_set_power_limit(const power_limit_config_t *config)
+{
+    power_limiter_init(&s_limiter, config);
+    if (config->max_average < HEATER_DUTY_MAX || config->peak < HEATER_DUTY_MAX)
+    {
+        ESP_LOGI(TAG, "Heater power budget: %lu%% average over %lu s, %lu%% peak",
+                 (unsigned long)(config->max_average * 100 / HEATER_DUTY_MAX), (unsigned long)(config->window_ms / 1000),
+                 (unsigned long)(config->peak * 100 / HEATER_DUTY_MAX));
+    }
+}
+
+void heater_get_power_limit(power_limit_config_t *config)
+{
+    *config = s_limiter.config;
+}
+
+bool heater_power_limited(void)
+{
+    return s_limiter.limiting;
+}
+
+uint32_t heater_power_average(void)
+{
+    return power_limiter_average(&s_limiter);
+}
+
+void heater_force_off(void)
+{
+    s_forced_off = true;
+    atomic_store(&s_sd_level, 0);
+    // No ESP_ERROR_CHECK: this runs from the watchdog timer and must never abort halfway
+    if (s_fade_installed)
+    {
+        ledc_fade_stop(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_0);
+    }
+    ledc_set_duty(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_0, 0);
+    ledc_update_duty(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_0);
+    s_duty = 0;
+}
+
+void heater_clear_force_off(void)
+{
+    s_forced_off = false;
 }
@@ -1,84 +1,311 @@
 #include "heater_controller.h"
+#include "controller_autotune.h"
+#include "controller_runaway.h"
+#include "controller_trace.h"
 #include "heater.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include "esp_log.h"
 #include <stddef.h> // Required for NULL
+#include <string.h>
+#include <math.h>
 
 static const char *TAG = "CONTROLLER";
 
-static controller_internal_state_t s_controller_state;
+// Static instance pool; slot 0 is the default instance behind the controller_* free functions
+static controller_internal_state_t s_controllers[CONTROLLER_MAX_INSTANCES];
+static autotune_t s_autotune[CONTROLLER_MAX_INSTANCES]; // Kept out of the instance struct, only used while tuning
+static runaway_monitor_t s_runaway[CONTROLLER_MAX_INSTANCES]; // Thermal protection windows, one per instance
 
-void controller_init(const controller_config_t *config, float initial_target_temp)
+// Output used by instances configured without one: the board heater on LEDC channel 0
+static void default_output(uint8_t power, void *ctx)
 {
-    if (s_controller_state.initialized)
+    (void)ctx;
+    set_heat_power(power);
+}
+
+// Commands the heater and records the level for telemetry; the interlock can veto any heat
+static void apply_power(controller_handle_t ctrl, uint8_t power)
+{
+    bool blocked = power > 0 && ctrl->interlock != NULL && !ctrl->interlock(ctrl->interlock_ctx);
+    if (blocked)
     {
-        ESP_LOGW(TAG, "Controller already initialized.");
-        return;
+        if (!ctrl->interlocked)
+        {
+            ESP_LOGW(TAG, "Controller %s: interlock open, heater held off", ctrl->name);
+            ctrl->telemetry.interlock_trips++;
+        }
+        power = 0;
     }
+    ctrl->interlocked = blocked;
+    ctrl->current_power = power;
+    ctrl->set_power(power, ctrl->output_ctx);
+}
 
-    if (config == NULL)
+/**
+ * @brief Publishes the instance state for lock-free readers (seqlock write side)
+ * Must be called with the mutex held, which serializes writers.
+ */
+static void publish_snapshot(controller_handle_t ctrl, float heater_temp, float air_temp)
+{
+    atomic_fetch_add_explicit(&ctrl->snapshot_seq, 1, memory_order_relaxed); // Odd: write in progress
+    atomic_thread_fence(memory_order_release);
+
+    ctrl->snapshot.state = ctrl->state;
+    ctrl->snapshot.active = ctrl->active;
+    ctrl->snapshot.heater_safety_override_active = ctrl->heater_safety_override_active;
+    ctrl->snapshot.target_temp = ctrl->target_temp;
+    ctrl->snapshot.reference_temp = ctrl->ramp_valid ? ctrl->ramp_reference : ctrl->target_temp;
+    ctrl->snapshot.heater_temp = heater_temp;
+    ctrl->snapshot.air_temp = air_temp;
+    ctrl->snapshot.power = ctrl->current_power;
+    ctrl->snapshot.autotuning = ctrl->autotuning;
+    ctrl->snapshot.fault = ctrl->fault;
+    ctrl->snapshot.interlocked = ctrl->interlocked;
+    ctrl->snapshot.telemetry = ctrl->telemetry;
+
+    atomic_thread_fence(memory_order_release);
+    atomic_fetch_add_explicit(&ctrl->snapshot_seq, 1, memory_order_relaxed); // Even: consistent again
+}
+
+/**
+ * @brief Initializes an instance slot from its configuration
+ * @return true on success
+ */
+static bool instance_init(controller_handle_t ctrl, const controller_instance_config_t *config)
+{
+    if (ctrl->initialized)
     {
-        ESP_LOGE(TAG, "Controller configuration is NULL!");
-        return;
+        ESP_LOGW(TAG, "Controller already initialized.");
+        return false;
     }
 
     // Copy configuration
-    s_controller_state.config = *config;
-    s_controller_state.target_temp = initial_target_temp;
-    s_controller_state.active = true;                         // Active by default
-    s_controller_state.state = CONTROLLER_STATE_IDLE;         // Start in IDLE state
-    s_controller_state.heater_safety_override_active = false; // Not active initially
-    s_controller_state.current_power = 0;                     // Heater off initially
+    ctrl->config = config->params;
+    ctrl->name = config->name ? config->name : "default";
+    ctrl->air_sensor = config->air_sensor;
+    ctrl->heater_sensor = config->heater_sensor;
+    ctrl->set_power = config->set_power ? config->set_power : default_output;
+    ctrl->output_ctx = config->output_ctx;
+    ctrl->interlock = config->interlock;
+    ctrl->interlock_ctx = config->interlock_ctx;
+    ctrl->interlocked = false;
+    ctrl->target_temp = config->initial_target_temp;
+    ctrl->active = true;                         // Active by default
+    ctrl->state = CONTROLLER_STATE_IDLE;         // Start in IDLE state
+    ctrl->heater_safety_override_active = false; // Not active initially
+    ctrl->current_power = 0;                     // Heater off initially
+    ctrl->ramp_valid = false;                    // Ramp reference seeded on first run
+    ctrl->scheduled_for = NAN;                   // Schedule evaluated on first run
+    ctrl->autotuning = false;
+    ctrl->fault = CONTROLLER_FAULT_NONE;
+    runaway_reset(&s_runaway[ctrl - s_controllers], &ctrl->config);
+    memset(&ctrl->telemetry, 0, sizeof(ctrl->telemetry));
 
     // Create mutex for thread-safe access
-    s_controller_state.mutex = xSemaphoreCreateMutex();
-    if (s_controller_state.mutex == NULL)
+    ctrl->mutex = xSemaphoreCreateMutex();
+    if (ctrl->mutex == NULL)
     {
         ESP_LOGE(TAG, "Failed to create controller mutex!");
+        return false;
+    }
+
+    publish_snapshot(ctrl, 0.0f, 0.0f);
+    ctrl->initialized = true;
+    ESP_LOGI(TAG, "Controller %s initialized successfully. Max Heater Temp: %.2f, Initial Target: %.2f",
+             ctrl->name, ctrl->config.max_heater_temp, ctrl->target_temp);
+    return true;
+}
+
+void controller_init(const controller_config_t *config, float initial_target_temp)
+{
+    if (config == NULL)
+    {
+        ESP_LOGE(TAG, "Controller configuration is NULL!");
         return;
     }
 
-    s_controller_state.initialized = true;
-    ESP_LOGI(TAG, "Controller initialized successfully. Max Heater Temp: %.2f, Initial Target: %.2f",
-             s_controller_state.config.max_heater_temp, s_controller_state.target_temp);
+    controller_instance_config_t instance_config = {
+        .name = "default",
+        .params = *config,
+        .initial_target_temp = initial_target_temp,
+        .set_power = NULL, // Board heater
+    };
+    instance_init(&s_controllers[0], &instance_config);
+}
+
+controller_handle_t controller_create(const controller_instance_config_t *config)
+{
+    if (config == NULL)
+    {
+        ESP_LOGE(TAG, "Controller configuration is NULL!");
+        return NULL;
+    }
+
+    for (size_t i = 0; i < CONTROLLER_MAX_INSTANCES; i++)
+    {
+        if (!s_controllers[i].initialized)
+        {
+            return instance_init(&s_controllers[i], config) ? &s_controllers[i] : NULL;
+        }
+    }
+
+    ESP_LOGE(TAG, "No free controller instance for %s (max %d)", config->name ? config->name : "?", CONTROLLER_MAX_INSTANCES);
+    return NULL;
+}
+
+controller_handle_t controller_get_default(void)
+{
+    return &s_controllers[0];
 }
 
 // Function to provide access to internal state for testing purposes
 controller_internal_state_t *controller_get_state(void)
 {
-    return &s_controller_state;
+    return &s_controllers[0];
 }
 
-void controller_deinit(void)
+void controller_destroy(controller_handle_t ctrl)
 {
-    if (!s_controller_state.initialized)
+    if (ctrl == NULL || !ctrl->initialized)
     {
         ESP_LOGW(TAG, "Controller not initialized, cannot deinitialize.");
         return;
     }
 
-    if (s_controller_state.mutex != NULL)
+    if (ctrl->mutex != NULL)
     {
-        vSemaphoreDelete(s_controller_state.mutex);
-        s_controller_state.mutex = NULL;
+        vSemaphoreDelete(ctrl->mutex);
+        ctrl->mutex = NULL;
     }
-    s_controller_state.initialized = false;
-    ESP_LOGI(TAG, "Controller deinitialized.");
+    ctrl->initialized = false;
+    ESP_LOGI(TAG, "Controller %s deinitialized.", ctrl->name);
 }
 
-void controller_set_target_temp(float temp)
+void controller_deinit(void)
+{
+    controller_destroy(&s_controllers[0]);
+}
+
+void controller_schedule_lookup(const controller_config_t *config, float setpoint, controller_schedule_point_t *out)
+{
+    const controller_gain_schedule_t *schedule = &config->schedule;
+    if (schedule->count == 0)
+    {
+        out->setpoint = setpoint;
+        out->air_temp_hysteresis = config->air_temp_hysteresis;
+        out->heater_temp_hysteresis = config->heater_temp_hysteresis;
+        out->full_power_delta = config->full_power_delta;
+        return;
+    }
+
+    const controller_schedule_point_t *first = &schedule->points[0];
+    const controller_schedule_point_t *last = &schedule->points[schedule->count - 1];
+    if (setpoint <= first->setpoint)
+    {
+        *out = *first;
+        return;
+    }
+    if (setpoint >= last->setpoint)
+    {
+        *out = *last;
+        return;
+    }
+
+    for (uint8_t i = 1; i < schedule->count; i++)
+    {
+        const controller_schedule_point_t *hi = &schedule->points[i];
+        if (setpoint <= hi->setpoint)
+        {
+            const controller_schedule_point_t *lo = &schedule->points[i - 1];
+            float t = (setpoint - lo->setpoint) / (hi->setpoint - lo->setpoint);
+            out->setpoint = setpoint;
+            out->air_temp_hysteresis = lo->air_temp_hysteresis + t * (hi->air_temp_hysteresis - lo->air_temp_hysteresis);
+            out->heater_temp_hysteresis = lo->heater_temp_hysteresis + t * (hi->heater_temp_hysteresis - lo->heater_temp_hysteresis);
+            out->full_power_delta = lo->full_power_delta + t * (hi->full_power_delta - lo->full_power_delta);
+            return;
+        }
+    }
+}
+
+// Parameters in effect for the current target; re-interpolated only when the target changes
+static const controller_schedule_point_t *scheduled_params(controller_handle_t ctrl)
 {
-    if (!s_controller_state.initialized)
+    if (ctrl->scheduled_for != ctrl->target_temp)
+    {
+        controller_schedule_lookup(&ctrl->config, ctrl->target_temp, &ctrl->scheduled);
+        ctrl->scheduled_for = ctrl->target_temp;
+    }
+    return &ctrl->scheduled;
+}
+
+/**
+ * @brief Advances the ramped reference toward the target
+ * Rises are slew-rate limited; with `ramp_accel` set, the rate itself ramps up and
+ * brakes into the target (S-curve). Drops apply at once since the heater cannot cool.
+ * Must be called with the mutex held.
+ * @param air_temp Current air temperature, used to seed the reference
+ * @return The setpoint the state machine should track this cycle
+ */
+static float update_reference(controller_handle_t ctrl, float air_temp)
+{
+    const controller_config_t *config = &ctrl->config;
+    if (config->ramp_rate <= 0.0f || config->control_period_s <= 0.0f)
+    {
+        return ctrl->target_temp; // Ramp disabled
+    }
+
+    if (!ctrl->ramp_valid)
+    {
+        // Start the ramp from where the air is now
+        ctrl->ramp_reference = fminf(air_temp, ctrl->target_temp);
+        ctrl->ramp_velocity = 0.0f;
+        ctrl->ramp_valid = true;
+    }
+
+    float remaining = ctrl->target_temp - ctrl->ramp_reference;
+    if (remaining <= 0.0f)
+    {
+        ctrl->ramp_reference = ctrl->target_temp;
+        ctrl->ramp_velocity = 0.0f;
+        return ctrl->ramp_reference;
+    }
+
+    float dt = config->control_period_s;
+    float max_velocity = config->ramp_rate / 60.0f; // C/s
+    if (config->ramp_accel > 0.0f)
+    {
+        float accel = config->ramp_accel / 3600.0f;                        // C/s^2
+        float desired = fminf(max_velocity, sqrtf(2.0f * accel * remaining)); // Brake into the target
+        ctrl->ramp_velocity = fminf(ctrl->ramp_velocity + accel * dt, desired);
+    }
+    else
+    {
+        ctrl->ramp_velocity = max_velocity;
+    }
+
+    ctrl->ramp_reference += ctrl->ramp_velocity * dt;
+    if (ctrl->ramp_reference >= ctrl->target_temp)
+    {
+        ctrl->ramp_reference = ctrl->target_temp;
+        ctrl->ramp_velocity = 0.0f;
+    }
+    return ctrl->ramp_reference;
+}
+
+void controller_instance_set_target_temp(controller_handle_t ctrl, float temp)
+{
+    if (ctrl == NULL || !ctrl->initialized)
     {
         ESP_LOGW(TAG, "Controller not initialized, cannot set target temp.");
         return;
     }
-    if (xSemaphoreTake(s_controller_state.mutex, portMAX_DELAY) == pdTRUE)
+    if (xSemaphoreTake(ctrl->mutex, portMAX_DELAY) == pdTRUE)
     {
-        s_controller_state.target_temp = temp;
+        ctrl->target_temp = temp;
         ESP_LOGD(TAG, "Target temperature set to %.2f", temp);
-        xSemaphoreGive(s_controller_state.mutex);
+        publish_snapshot(ctrl, ctrl->snapshot.heater_temp, ctrl->snapshot.air_temp);
+        xSemaphoreGive(ctrl->mutex);
     }
     else
     {
@@ -86,18 +313,24 @@ void controller_set_target_temp(float temp)
     }
 }
 
-void controller_set_active(bool active)
+void controller_set_target_temp(float temp)
 {
-    if (!s_controller_state.initialized)
+    controller_instance_set_target_temp(&s_controllers[0], temp);
+}
+
+void controller_instance_set_active(controller_handle_t ctrl, bool active)
+{
+    if (ctrl == NULL || !ctrl->initialized)
     {
         ESP_LOGW(TAG, "Controller not initialized, cannot set active state.");
         return;
     }
-    if (xSemaphoreTake(s_controller_state.mutex, portMAX_DELAY) == pdTRUE)
+    if (xSemaphoreTake(ctrl->mutex, portMAX_DELAY) == pdTRUE)
     {
-        s_controller_state.active = active;
-        ESP_LOGI(TAG, "Controller set to %s", active ? "ACTIVE" : "INACTIVE");
-        xSemaphoreGive(s_controller_state.mutex);
+        ctrl->active = active;
+        ESP_LOGI(TAG, "Controller %s set to %s", ctrl->name, active ? "ACTIVE" : "INACTIVE");
+        publish_snapshot(ctrl, ctrl->snapshot.heater_temp, ctrl->snapshot.air_temp);
+        xSemaphoreGive(ctrl->mutex);
     }
     else
     {
@@ -105,145 +338,454 @@ void controller_set_active(bool active)
     }
 }
 
-void controller_run(float heater_temp, float air_temp)
+void controller_set_active(bool active)
+{
+    controller_instance_set_active(&s_controllers[0], active);
+}
+
+// Auto-tune cycle: the tuner drives the heater, the element safety limit still applies
+static void autotune_run_locked(controller_handle_t ctrl, float heater_temp, float air_temp)
 {
-    if (!s_controller_state.initialized)
+    autotune_t *at = &s_autotune[ctrl - s_controllers];
+    uint8_t power = autotune_step(at, air_temp, ctrl->config.control_period_s);
+
+    if (heater_temp >= ctrl->config.max_heater_temp)
     {
-        ESP_LOGW(TAG, "Controller not initialized, cannot run.");
+        if (!ctrl->heater_safety_override_active)
+        {
+            ctrl->telemetry.safety_trips++;
+        }
+        ctrl->heater_safety_override_active = true;
+        power = 0;
+    }
+    else if (heater_temp <= ctrl->config.max_heater_temp - ctrl->config.heater_temp_hysteresis)
+    {
+        ctrl->heater_safety_override_active = false;
+    }
+    else if (ctrl->heater_safety_override_active)
+    {
+        power = 0; // Still cooling down from a trip
+    }
+
+    if (at->phase == AUTOTUNE_DONE || at->phase == AUTOTUNE_FAILED)
+    {
+        if (at->phase == AUTOTUNE_DONE)
+        {
+            ctrl->config.schedule = at->result;
+            ctrl->scheduled_for = NAN; // Re-evaluate with the new schedule
+        }
+        ESP_LOGI(TAG, "Controller %s auto-tune %s", ctrl->name, at->phase == AUTOTUNE_DONE ? "complete" : "failed");
+        ctrl->autotuning = false;
+        ctrl->active = false;
+        ctrl->ramp_valid = false;
+        ctrl->state = CONTROLLER_STATE_IDLE;
+        power = 0;
+    }
+
+    apply_power(ctrl, power);
+}
+
+// One control cycle; must be called with the mutex held
+static void run_locked(controller_handle_t ctrl, float heater_temp, float air_temp)
+{
+    if (ctrl->autotuning)
+    {
+        autotune_run_locked(ctrl, heater_temp, air_temp);
+        return;
+    }
+
+    // Global Control State: If deactivated, force IDLE
+    if (!ctrl->active)
+    {
+        if (ctrl->state != CONTROLLER_STATE_IDLE)
+        {
+            ESP_LOGI(TAG, "Controller deactivated, forcing IDLE state.");
+            ctrl->state = CONTROLLER_STATE_IDLE;
+            apply_power(ctrl, 0);
+        }
+        ctrl->ramp_valid = false; // Re-seed the ramp when reactivated
+        return;                   // Exit if not active
+    }
+
+    float target = update_reference(ctrl, air_temp);
+    const controller_schedule_point_t *params = scheduled_params(ctrl);
+
+    // Global Safety Override: Check heater_temp regardless of state
+    if (heater_temp >= ctrl->config.max_heater_temp)
+    {
+        if (ctrl->state != CONTROLLER_STATE_IDLE)
+        {
+            ESP_LOGW(TAG, "Heater temp %.2fC >= Max Heater Temp %.2fC. Forcing IDLE (safety override).",
+                     heater_temp, ctrl->config.max_heater_temp);
+            ctrl->state = CONTROLLER_STATE_IDLE;
+            apply_power(ctrl, 0);
+        }
+        if (!ctrl->heater_safety_override_active)
+        {
+            ctrl->telemetry.safety_trips++;
+        }
+        ctrl->heater_safety_override_active = true;
+        return; // Exit if safety override is active
+    }
+
+    // Only allow heater to come out of IDLE (due to safety override) once temp has dropped sufficiently
+    if (ctrl->state == CONTROLLER_STATE_IDLE &&
+        ctrl->heater_safety_override_active &&
+        heater_temp > (ctrl->config.max_heater_temp - params->heater_temp_hysteresis))
+    {
+        ESP_LOGD(TAG, "Heater still too hot (%.2fC) to exit safety override. Remaining IDLE.", heater_temp);
         return;
     }
+    else if (ctrl->heater_safety_override_active &&
+             heater_temp <= (ctrl->config.max_heater_temp - params->heater_temp_hysteresis))
+    {
+        ESP_LOGI(TAG, "Heater temp %.2fC below safety threshold. Exiting safety override.", heater_temp);
+        ctrl->heater_safety_override_active = false;
+    }
 
-    if (xSemaphoreTake(s_controller_state.mutex, portMAX_DELAY) == pdTRUE)
+    // State Machine Logic
+    switch (ctrl->state)
     {
-        // Global Control State: If deactivated, force IDLE
-        if (!s_controller_state.active)
+    case CONTROLLER_STATE_IDLE:
+        // Transition out of IDLE if conditions met
+        if (air_temp < (target - params->full_power_delta) &&
+            !ctrl->heater_safety_override_active)
+        {
+            ESP_LOGI(TAG, "AIR Temp %.2fC < Target %.2fC - Delta %.2fC. Transitioning to HEATING_FULL_POWER.",
+                     air_temp, target, params->full_power_delta);
+            ctrl->state = CONTROLLER_STATE_HEATING_FULL_POWER;
+            apply_power(ctrl, 255);
+        }
+        else
+        {
+            apply_power(ctrl, 0); // Ensure heater is off in IDLE
+        }
+        break;
+
+    case CONTROLLER_STATE_HEATING_FULL_POWER:
+        if (heater_temp >= ctrl->config.max_heater_temp)
         {
-            if (s_controller_state.state != CONTROLLER_STATE_IDLE)
-            {
-                ESP_LOGI(TAG, "Controller deactivated, forcing IDLE state.");
-                s_controller_state.state = CONTROLLER_STATE_IDLE;
-                set_heat_power(0);
-            }
-            xSemaphoreGive(s_controller_state.mutex);
-            return; // Exit if not active
+            ESP_LOGI(TAG, "HEATER Temp %.2fC >= Max Heater Temp %.2fC. Transitioning to MODULATING_HEATER_TEMP.",
+                     heater_temp, ctrl->config.max_heater_temp);
+            ctrl->state = CONTROLLER_STATE_MODULATING_HEATER_TEMP;
+            apply_power(ctrl, 255); // Start modulating, might immediately turn off based on current temp
         }
+        else if (air_temp >= (target - params->air_temp_hysteresis))
+        {
+            // Air temp is approaching target, bypass modulating heater temp state
+            ESP_LOGI(TAG, "AIR Temp %.2fC approaching Target %.2fC. Transitioning to MAINTAINING_AIR_TEMP.",
+                     air_temp, target);
+            ctrl->state = CONTROLLER_STATE_MAINTAINING_AIR_TEMP;
+            // Power will be set by MAINTAINING_AIR_TEMP logic
+        }
+        else
+        {
+            apply_power(ctrl, 255); // Continue full power
+        }
+        break;
 
-        // Global Safety Override: Check heater_temp regardless of state
-        if (heater_temp >= s_controller_state.config.max_heater_temp)
+    case CONTROLLER_STATE_MODULATING_HEATER_TEMP:
+        if (air_temp >= (target - params->air_temp_hysteresis))
         {
-            if (s_controller_state.state != CONTROLLER_STATE_IDLE)
-            {
-                ESP_LOGW(TAG, "Heater temp %.2fC >= Max Heater Temp %.2fC. Forcing IDLE (safety override).",
-                         heater_temp, s_controller_state.config.max_heater_temp);
-                s_controller_state.state = CONTROLLER_STATE_IDLE;
-                set_heat_power(0);
-            }
-            s_controller_state.heater_safety_override_active = true;
-            xSemaphoreGive(s_controller_state.mutex);
-            return; // Exit if safety override is active
+            ESP_LOGI(TAG, "AIR Temp %.2fC approaching Target %.2fC. Transitioning to MAINTAINING_AIR_TEMP.",
+                     air_temp, target);
+            ctrl->state = CONTROLLER_STATE_MAINTAINING_AIR_TEMP;
+            // Power will be set by MAINTAINING_AIR_TEMP logic
         }
+        else if (heater_temp > ctrl->config.max_heater_temp)
+        {
+            apply_power(ctrl, 0); // Exceeded max heater temp, turn off
+        }
+        else if (heater_temp < (ctrl->config.max_heater_temp - params->heater_temp_hysteresis))
+        {
+            apply_power(ctrl, 255); // Below lower bound, turn on
+        }
+        break;
 
-        // Only allow heater to come out of IDLE (due to safety override) once temp has dropped sufficiently
-        if (s_controller_state.state == CONTROLLER_STATE_IDLE &&
-            s_controller_state.heater_safety_override_active &&
-            heater_temp > (s_controller_state.config.max_heater_temp - s_controller_state.config.heater_temp_hysteresis))
+    case CONTROLLER_STATE_MAINTAINING_AIR_TEMP:
+        if (air_temp > (target + params->air_temp_hysteresis))
+        {
+            apply_power(ctrl, 0); // Above target hysteresis, turn off
+        }
+        else if (air_temp < (target - params->air_temp_hysteresis))
+        {
+            apply_power(ctrl, 255); // Below target hysteresis, turn on full power
+        }
+        // No else, power remains as is if within hysteresis band
+        break;
+
+    default:
+        ESP_LOGE(TAG, "Unknown controller state: %d. Forcing IDLE.", ctrl->state);
+        ctrl->state = CONTROLLER_STATE_IDLE;
+        apply_power(ctrl, 0);
+        break;
+    }
+
+    ESP_LOGD(TAG, "State: %d, Heater: %.2fC, Air: %.2fC, Target: %.2fC, Power: %u",
+             ctrl->state, heater_temp, air_temp, target, ctrl->current_power);
+}
+
+/**
+ * @brief Feeds the thermal protection window and latches a fault when the heater misbehaves
+ * Must be called with the mutex held, after the cycle has run.
+ * @param applied_power Power that drove the heater since the previous cycle
+ */
+static void runaway_check_locked(controller_handle_t ctrl, float heater_temp, uint8_t applied_power)
+{
+    if (ctrl->fault == CONTROLLER_FAULT_NONE)
+    {
+        controller_fault_t fault = runaway_update(&s_runaway[ctrl - s_controllers], &ctrl->config,
+                                                  heater_temp, applied_power);
+        if (fault == CONTROLLER_FAULT_NONE)
         {
-            ESP_LOGD(TAG, "Heater still too hot (%.2fC) to exit safety override. Remaining IDLE.", heater_temp);
-            xSemaphoreGive(s_controller_state.mutex);
             return;
         }
-        else if (s_controller_state.heater_safety_override_active &&
-                 heater_temp <= (s_controller_state.config.max_heater_temp - s_controller_state.config.heater_temp_hysteresis))
-        {
-            ESP_LOGI(TAG, "Heater temp %.2fC below safety threshold. Exiting safety override.", heater_temp);
-            s_controller_state.heater_safety_override_active = false;
-        }
-
-        // State Machine Logic
-        switch (s_controller_state.state)
-        {
-        case CONTROLLER_STATE_IDLE:
-            // Transition out of IDLE if conditions met
-            if (air_temp < (s_controller_state.target_temp - s_controller_state.config.full_power_delta) &&
-                !s_controller_state.heater_safety_override_active)
-            {
-                ESP_LOGI(TAG, "AIR Temp %.2fC < Target %.2fC - Delta %.2fC. Transitioning to HEATING_FULL_POWER.",
-                         air_temp, s_controller_state.target_temp, s_controller_state.config.full_power_delta);
-                s_controller_state.state = CONTROLLER_STATE_HEATING_FULL_POWER;
-                set_heat_power(255);
-            }
-            else
-            {
-                set_heat_power(0); // Ensure heater is off in IDLE
-            }
-            break;
-
-        case CONTROLLER_STATE_HEATING_FULL_POWER:
-            if (heater_temp >= s_controller_state.config.max_heater_temp)
-            {
-                ESP_LOGI(TAG, "HEATER Temp %.2fC >= Max Heater Temp %.2fC. Transitioning to MODULATING_HEATER_TEMP.",
-                         heater_temp, s_controller_state.config.max_heater_temp);
-                s_controller_state.state = CONTROLLER_STATE_MODULATING_HEATER_TEMP;
-                set_heat_power(255); // Start modulating, might immediately turn off based on current temp
-            }
-            else if (air_temp >= (s_controller_state.target_temp - s_controller_state.config.air_temp_hysteresis))
-            {
-                // Air temp is approaching target, bypass modulating heater temp state
-                ESP_LOGI(TAG, "AIR Temp %.2fC approaching Target %.2fC. Transitioning to MAINTAINING_AIR_TEMP.",
-                         air_temp, s_controller_state.target_temp);
-                s_controller_state.state = CONTROLLER_STATE_MAINTAINING_AIR_TEMP;
-                // Power will be set by MAINTAINING_AIR_TEMP logic
-            }
-            else
-            {
-                set_heat_power(255); // Continue full power
-            }
-            break;
-
-        case CONTROLLER_STATE_MODULATING_HEATER_TEMP:
-            if (air_temp >= (s_controller_state.target_temp - s_controller_state.config.air_temp_hysteresis))
-            {
-                ESP_LOGI(TAG, "AIR Temp %.2fC approaching Target %.2fC. Transitioning to MAINTAINING_AIR_TEMP.",
-                         air_temp, s_controller_state.target_temp);
-                s_controller_state.state = CONTROLLER_STATE_MAINTAINING_AIR_TEMP;
-                // Power will be set by MAINTAINING_AIR_TEMP logic
-            }
-            else if (heater_temp > s_controller_state.config.max_heater_temp)
-            {
-                set_heat_power(0); // Exceeded max heater temp, turn off
-            }
-            else if (heater_temp < (s_controller_state.config.max_heater_temp - s_controller_state.config.heater_temp_hysteresis))
-            {
-                set_heat_power(255); // Below lower bound, turn on
-            }
-            break;
-
-        case CONTROLLER_STATE_MAINTAINING_AIR_TEMP:
-            if (air_temp > (s_controller_state.target_temp + s_controller_state.config.air_temp_hysteresis))
-            {
-                set_heat_power(0); // Above target hysteresis, turn off
-            }
-            else if (air_temp < (s_controller_state.target_temp - s_controller_state.config.air_temp_hysteresis))
-            {
-                set_heat_power(255); // Below target hysteresis, turn on full power
-            }
-            // No else, power remains as is if within hysteresis band
-            break;
-
-        default:
-            ESP_LOGE(TAG, "Unknown controller state: %d. Forcing IDLE.", s_controller_state.state);
-            s_controller_state.state = CONTROLLER_STATE_IDLE;
-            set_heat_power(0);
-            break;
-        }
-
-        ESP_LOGD(TAG, "State: %d, Heater: %.2fC, Air: %.2fC, Target: %.2fC, Power: %u",
-                 s_controller_state.state, heater_temp, air_temp, s_controller_state.target_temp, s_controller_state.current_power);
-
-        xSemaphoreGive(s_controller_state.mutex);
+
+        ESP_LOGE(TAG, "Controller %s: %s at %.1fC, heater latched off", ctrl->name,
+                 fault == CONTROLLER_FAULT_HEATING_FAILED ? "heating failure" : "thermal runaway", heater_temp);
+        ctrl->fault = fault;
+        ctrl->autotuning = false;
+        ctrl->state = CONTROLLER_STATE_IDLE;
+        ctrl->ramp_valid = false;
+    }
+
+    // Latched: nothing but an explicit clear turns the heater back on
+    apply_power(ctrl, 0);
+}
+
+// Appends this cycle to the trace ring; must be called with the mutex held after publish_snapshot()
+static void trace_cycle(controller_handle_t ctrl, int64_t start_us)
+{
+    int64_t now_us = controller_trace_now_us();
+    int64_t loop_us = now_us - start_us;
+    uint8_t flags = (uint8_t)(ctrl->state & CONTROLLER_TRACE_STATE_MASK) |
+                    (uint8_t)((ctrl - s_controllers) << CONTROLLER_TRACE_ZONE_SHIFT);
+    if (ctrl->heater_safety_override_active)
+    {
+        flags |= CONTROLLER_TRACE_FLAG_OVERRIDE;
+    }
+    if (ctrl->active)
+    {
+        flags |= CONTROLLER_TRACE_FLAG_ACTIVE;
+    }
+    if (ctrl->autotuning)
+    {
+        flags |= CONTROLLER_TRACE_FLAG_AUTOTUNE;
+    }
+    if (ctrl->fault != CONTROLLER_FAULT_NONE)
+    {
+        flags |= CONTROLLER_TRACE_FLAG_FAULT;
+    }
+
+    controller_trace_record_t record = {
+        .timestamp_ms = (uint32_t)(now_us / 1000),
+        .heater_temp = controller_trace_temp(ctrl->snapshot.heater_temp),
+        .air_temp = controller_trace_temp(ctrl->snapshot.air_temp),
+        .reference = controller_trace_temp(ctrl->snapshot.reference_temp),
+        .power = ctrl->current_power,
+        .flags = flags,
+        .loop_us = loop_us > UINT16_MAX ? UINT16_MAX : (uint16_t)loop_us,
+    };
+    controller_trace_record(&record);
+}
+
+// Forces the heater off for a cycle without trustworthy input and counts it
+static void sensor_fault(controller_handle_t ctrl)
+{
+    if (xSemaphoreTake(ctrl->mutex, portMAX_DELAY) == pdTRUE)
+    {
+        ESP_LOGW(TAG, "Controller %s: sensor data unavailable, heater forced off", ctrl->name);
+        ctrl->telemetry.sensor_faults++;
+        apply_power(ctrl, 0);
+        publish_snapshot(ctrl, ctrl->snapshot.heater_temp, ctrl->snapshot.air_temp);
+        xSemaphoreGive(ctrl->mutex);
+    }
+}
+
+// Rejects the -999 invalid marker, NAN and anything outside the sensor's plausible range
+static bool temp_is_valid(float temperature)
+{
+    return temperature >= TEMP_MIN_VALID_CELSIUS && temperature <= TEMP_MAX_VALID_CELSIUS;
+}
+
+void controller_instance_run(controller_handle_t ctrl, float heater_temp, float air_temp)
+{
+    if (ctrl == NULL || !ctrl->initialized)
+    {
+        ESP_LOGW(TAG, "Controller not initialized, cannot run.");
+        return;
+    }
+
+    // Never act on an invalid reading: a -999 heater temperature would otherwise demand full power
+    if (!temp_is_valid(heater_temp) || !temp_is_valid(air_temp))
+    {
+        sensor_fault(ctrl);
+        return;
+    }
+
+    bool tracing = controller_trace_enabled();
+    int64_t start_us = tracing ? controller_trace_now_us() : 0;
+
+    if (xSemaphoreTake(ctrl->mutex, portMAX_DELAY) == pdTRUE)
+    {
+        uint8_t applied_power = ctrl->current_power; // Drove the heater since the last cycle
+        if (ctrl->fault == CONTROLLER_FAULT_NONE)
+        {
+            run_locked(ctrl, heater_temp, air_temp);
+        }
+        runaway_check_locked(ctrl, heater_temp, applied_power);
+
+        ctrl->telemetry.cycles++;
+        if (ctrl->current_power > 0)
+        {
+            ctrl->telemetry.heating_cycles++;
+        }
+        publish_snapshot(ctrl, heater_temp, air_temp);
+        if (tracing)
+        {
+            trace_cycle(ctrl, start_us);
+        }
+
+        xSemaphoreGive(ctrl->mutex);
     }
     else
     {
         ESP_LOGE(TAG, "Failed to take mutex to run controller.");
     }
 }
+
+void controller_run(float heater_temp, float air_temp)
+{
+    controller_instance_run(&s_controllers[0], heater_temp, air_temp);
+}
+
+bool controller_step(controller_handle_t ctrl)
+{
+    if (ctrl == NULL || !ctrl->initialized)
+    {
+        return false;
+    }
+
+    float heater_temp = 0.0f;
+    float air_temp = 0.0f;
+    if (temp_sensor_read_ok(ctrl->heater_sensor, &heater_temp) && temp_sensor_read_ok(ctrl->air_sensor, &air_temp))
+    {
+        controller_instance_run(ctrl, heater_temp, air_temp);
+        return true;
+    }
+
+    // No trustworthy input: never leave the heater on blind
+    sensor_fault(ctrl);
+    return false;
+}
+
+void controller_step_all(void)
+{
+    for (size_t i = 0; i < CONTROLLER_MAX_INSTANCES; i++)
+    {
+        controller_handle_t ctrl = &s_controllers[i];
+        if (ctrl->initialized && ctrl->air_sensor != NULL && ctrl->heater_sensor != NULL)
+        {
+            controller_step(ctrl);
+        }
+    }
+}
+
+bool controller_instance_start_autotune(controller_handle_t ctrl, const float *setpoints, uint8_t count)
+{
+    if (ctrl == NULL || !ctrl->initialized || ctrl->config.control_period_s <= 0.0f)
+    {
+        ESP_LOGW(TAG, "Controller not initialized or has no control period, cannot auto-tune.");
+        return false;
+    }
+
+    bool started = false;
+    if (xSemaphoreTake(ctrl->mutex, portMAX_DELAY) == pdTRUE)
+    {
+        started = autotune_start(&s_autotune[ctrl - s_controllers], setpoints, count);
+        if (started)
+        {
+            ctrl->autotuning = true;
+            ctrl->active = true;
+            ctrl->state = CONTROLLER_STATE_IDLE;
+            publish_snapshot(ctrl, ctrl->snapshot.heater_temp, ctrl->snapshot.air_temp);
+        }
+        xSemaphoreGive(ctrl->mutex);
+    }
+    return started;
+}
+
+void controller_instance_cancel_autotune(controller_handle_t ctrl)
+{
+    if (ctrl == NULL || !ctrl->initialized)
+    {
+        return;
+    }
+    if (xSemaphoreTake(ctrl->mutex, portMAX_DELAY) == pdTRUE)
+    {
+        if (ctrl->autotuning)
+        {
+            ESP_LOGI(TAG, "Controller %s auto-tune cancelled", ctrl->name);
+            ctrl->autotuning = false;
+            ctrl->active = false;
+            apply_power(ctrl, 0);
+            publish_snapshot(ctrl, ctrl->snapshot.heater_temp, ctrl->snapshot.air_temp);
+        }
+        xSemaphoreGive(ctrl->mutex);
+    }
+}
+
+void controller_instance_clear_fault(controller_handle_t ctrl)
+{
+    if (ctrl == NULL || !ctrl->initialized)
+    {
+        return;
+    }
+    if (xSemaphoreTake(ctrl->mutex, portMAX_DELAY) == pdTRUE)
+    {
+        if (ctrl->fault != CONTROLLER_FAULT_NONE)
+        {
+            ESP_LOGI(TAG, "Controller %s fault cleared", ctrl->name);
+            ctrl->fault = CONTROLLER_FAULT_NONE;
+            runaway_reset(&s_runaway[ctrl - s_controllers], &ctrl->config);
+            publish_snapshot(ctrl, ctrl->snapshot.heater_temp, ctrl->snapshot.air_temp);
+        }
+        xSemaphoreGive(ctrl->mutex);
+    }
+}
+
+bool controller_instance_get_config(controller_handle_t ctrl, controller_config_t *config)
+{
+    if (ctrl == NULL || config == NULL || !ctrl->initialized)
+    {
+        return false;
+    }
+    if (xSemaphoreTake(ctrl->mutex, portMAX_DELAY) != pdTRUE)
+    {
+        return false;
+    }
+    *config = ctrl->config;
+    xSemaphoreGive(ctrl->mutex);
+    return true;
+}
+
+bool controller_get_snapshot(controller_handle_t ctrl, controller_snapshot_t *snapshot)
+{
+    if (ctrl == NULL || snapshot == NULL || !ctrl->initialized)
+    {
+        return false;
+    }
+
+    // Seqlock read side: retry until no write overlapped the copy
+    unsigned int start;
+    unsigned int end;
+    do
+    {
+        start = atomic_load_explicit(&ctrl->snapshot_seq, memory_order_acquire);
+        *snapshot = ctrl->snapshot;
+        atomic_thread_fence(memory_order_acquire);
+        end = atomic_load_explicit(&ctrl->snapshot_seq, memory_order_relaxed);
+    } while ((start & 1U) != 0 || start != end);
+
+    return true;
+}
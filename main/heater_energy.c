@@ -0,0 +1,55 @@
+#include "heater_energy.h"
+#include <string.h>
+
+#define US_PER_HOUR 3600000000.0
+
+void heater_energy_reset(heater_energy_t *e, uint32_t duty_max, uint32_t duty, int64_t now_us)
+{
+    memset(e, 0, sizeof(*e));
+    e->duty_max = duty_max > 0 ? duty_max : 1;
+    e->duty = duty > e->duty_max ? e->duty_max : duty;
+    e->last_us = now_us;
+}
+
+void heater_energy_update(heater_energy_t *e, uint32_t duty, int64_t now_us)
+{
+    if (now_us > e->last_us)
+    {
+        uint64_t dt_us = (uint64_t)(now_us - e->last_us);
+        e->duty_us += (uint64_t)e->duty * dt_us;
+        e->elapsed_us += dt_us;
+
+        // duty_max + 1 keeps full power in the last bin
+        uint32_t bin = (uint32_t)(((uint64_t)e->duty * HEATER_ENERGY_HISTOGRAM_BINS) / ((uint64_t)e->duty_max + 1));
+        e->histogram_us[bin] += dt_us;
+        e->last_us = now_us;
+    }
+    e->duty = duty > e->duty_max ? e->duty_max : duty;
+}
+
+float heater_energy_wh(const heater_energy_t *e, float watts)
+{
+    // Double only for the final scaling; the accumulator itself stays exact
+    return (float)((double)e->duty_us * watts / ((double)e->duty_max * US_PER_HOUR));
+}
+
+void heater_energy_summarize(const heater_energy_t *e, float watts, energy_session_t *session)
+{
+    session->duration_s = (uint32_t)(e->elapsed_us / 1000000);
+    session->energy_wh = heater_energy_wh(e, watts);
+    if (e->elapsed_us == 0)
+    {
+        session->avg_power_w = 0.0f;
+        session->duty_percent = 0.0f;
+        memset(session->histogram_permille, 0, sizeof(session->histogram_permille));
+        return;
+    }
+
+    double duty_fraction = (double)e->duty_us / ((double)e->duty_max * (double)e->elapsed_us);
+    session->duty_percent = (float)(duty_fraction * 100.0);
+    session->avg_power_w = (float)(duty_fraction * watts);
+    for (int i = 0; i < HEATER_ENERGY_HISTOGRAM_BINS; i++)
+    {
+        session->histogram_permille[i] = (uint16_t)((e->histogram_us[i] * 1000 + e->elapsed_us / 2) / e->elapsed_us);
+    }
+}
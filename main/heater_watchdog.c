@@ -0,0 +1,110 @@
+#include "heater_watchdog.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include <stdatomic.h>
+#include <stddef.h>
+
+static const char *TAG = "HEATER_WATCHDOG";
+
+static heater_watchdog_config_t s_config;
+static atomic_bool s_armed;
+static atomic_bool s_tripped;
+static atomic_uint s_last_feed_ms; // Wraps after ~49 days; only differences are used
+static uint32_t s_last_sequence;   // Sequence of the last accepted sample, only touched by the feeding task
+static bool s_has_sequence;        // False until the first accepted feed after init
+
+static uint32_t now_ms(void)
+{
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+bool heater_watchdog_init(const heater_watchdog_config_t *config)
+{
+    if (config == NULL || config->cutoff == NULL || config->timeout_ms == 0)
+    {
+        ESP_LOGE(TAG, "Invalid watchdog configuration");
+        return false;
+    }
+
+    s_config = *config;
+    s_has_sequence = false;
+    atomic_store(&s_tripped, false);
+    atomic_store(&s_last_feed_ms, now_ms());
+    atomic_store(&s_armed, true);
+    ESP_LOGI(TAG, "Heater watchdog armed (timeout %lu ms)", (unsigned long)config->timeout_ms);
+    return true;
+}
+
+void heater_watchdog_deinit(void)
+{
+    atomic_store(&s_armed, false);
+    atomic_store(&s_tripped, false);
+}
+
+bool heater_watchdog_feed(float heater_temp, uint32_t sample_sequence)
+{
+    // NaN fails both comparisons and is rejected with the rest
+    if (!atomic_load(&s_armed) || !(heater_temp >= HEATER_WATCHDOG_MIN_VALID_TEMP) ||
+        !(heater_temp <= HEATER_WATCHDOG_MAX_VALID_TEMP))
+    {
+        return false;
+    }
+
+    // The same sample fed again means the sensor task stopped, not that the heater is watched
+    if (s_has_sequence && sample_sequence == s_last_sequence)
+    {
+        return false;
+    }
+    s_last_sequence = sample_sequence;
+    s_has_sequence = true;
+
+    atomic_store(&s_last_feed_ms, now_ms());
+    return true;
+}
+
+bool heater_watchdog_check(void)
+{
+    if (!atomic_load(&s_armed))
+    {
+        return false;
+    }
+
+    uint32_t elapsed_ms = now_ms() - atomic_load(&s_last_feed_ms);
+    if (!atomic_load(&s_tripped))
+    {
+        if (elapsed_ms <= s_config.timeout_ms)
+        {
+            return false;
+        }
+
+        // Cut first, report second: reporting may block on the UI lock
+        s_config.cutoff();
+        if (!atomic_exchange(&s_tripped, true))
+        {
+            ESP_LOGE(TAG, "No valid heater update for %lu ms, heater cut off", (unsigned long)elapsed_ms);
+            if (s_config.on_trip != NULL)
+            {
+                s_config.on_trip();
+            }
+        }
+        return true;
+    }
+
+    // Latched: keep asserting the cutoff in case something re-enabled the output
+    s_config.cutoff();
+    return true;
+}
+
+bool heater_watchdog_tripped(void)
+{
+    return atomic_load(&s_tripped);
+}
+
+void heater_watchdog_clear(void)
+{
+    atomic_store(&s_last_feed_ms, now_ms());
+    if (atomic_exchange(&s_tripped, false))
+    {
+        ESP_LOGI(TAG, "Heater watchdog fault cleared");
+    }
+}
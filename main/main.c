@@ -10,6 +10,8 @@
 #include "esp_log.h"
 #include "startup_tests.h"
 #include "display.h"
+#include "display_benchmark.h"
+#include "display_power.h"
 #include "ui/ui.h"
 #include "ui/subjects.h"
 #include "diagnostic.h"
@@ -17,6 +19,10 @@
 #include "ota.h"
 #include "web_server.h"
 #include "temp.h"
+#include "heater.h"
+#include "fan.h"
+#include "control_task.h"
+#include "controller_trace.h"
 #include <sysmon.h>
 #include <sysmon_stack.h>
 
@@ -50,6 +56,9 @@ void app_main(void)
 
     // Initialize LCD display
     init_display();
+#ifdef CONFIG_DISPLAY_BENCHMARK
+    display_benchmark_run(NULL, 0); // Before any widgets exist: it recreates the LVGL display
+#endif
 
     // Initialize UI subjects first (before temperature sensors)
     subjects_init();
@@ -57,6 +66,14 @@ void app_main(void)
     // Initialize temperature sensors (publishes to subjects via callbacks)
     temp_sensor_init();
 
+    // Initialize heater PWM and start the control loop (heater stays off until a profile runs)
+    heater_init();
+#ifdef CONFIG_ENABLE_FAN
+    ESP_ERROR_CHECK(fan_init());
+#endif
+    controller_trace_init(); // Optional: control runs without the trace if PSRAM is short
+    ESP_ERROR_CHECK(control_task_start());
+
     // Start web server
     ESP_ERROR_CHECK(web_server_start());
 
@@ -65,4 +82,7 @@ void app_main(void)
 
     // Initialize and start UI (creates widgets bound to subjects)
     init_ui();
+
+    // Dim, throttle and finally switch off the display while nobody uses it
+    display_power_start();
 }
@@ -0,0 +1,86 @@
+#include "power_limiter.h"
+#include <string.h>
+
+void power_limiter_init(power_limiter_t *pl, const power_limit_config_t *config)
+{
+    memset(pl, 0, sizeof(*pl));
+    pl->config = *config;
+    pl->slot_ms = config->window_ms / POWER_LIMIT_SLOTS;
+    if (config->window_ms > 0 && pl->slot_ms == 0)
+    {
+        pl->slot_ms = 1;
+    }
+    pl->last_ms = -1;
+}
+
+// Adds `ms` of the current duty to the window, rolling slots as they fill
+static void accumulate(power_limiter_t *pl, uint64_t ms)
+{
+    while (ms > 0)
+    {
+        uint32_t room = pl->slot_ms - pl->head_ms;
+        uint32_t chunk = ms < room ? (uint32_t)ms : room;
+        uint64_t energy = (uint64_t)pl->duty * chunk;
+        pl->slot_sum[pl->head] += energy;
+        pl->window_sum += energy;
+        pl->head_ms += chunk;
+        ms -= chunk;
+
+        if (pl->head_ms == pl->slot_ms)
+        {
+            // Oldest slot drops out of the window and is reused
+            pl->head = (uint16_t)((pl->head + 1) % POWER_LIMIT_SLOTS);
+            pl->window_sum -= pl->slot_sum[pl->head];
+            pl->slot_sum[pl->head] = 0;
+            pl->head_ms = 0;
+
+            if (pl->duty == 0 && ms >= (uint64_t)pl->slot_ms * POWER_LIMIT_SLOTS)
+            {
+                // A whole window at zero: nothing left to roll through one slot at a time
+                memset(pl->slot_sum, 0, sizeof(pl->slot_sum));
+                pl->window_sum = 0;
+                ms %= pl->slot_ms;
+            }
+        }
+    }
+}
+
+uint32_t power_limiter_apply(power_limiter_t *pl, uint32_t requested, int64_t now_ms)
+{
+    if (pl->slot_ms > 0 && pl->last_ms >= 0 && now_ms > pl->last_ms)
+    {
+        accumulate(pl, (uint64_t)(now_ms - pl->last_ms));
+    }
+    pl->last_ms = now_ms;
+
+    uint32_t allowed = pl->config.peak;
+    if (pl->slot_ms > 0)
+    {
+        // Spend what the window has left over the next slot. The older slots hold at most the rest of
+        // the window, so a window already at max_average in them allows exactly max_average.
+        int64_t budget = (int64_t)pl->config.max_average * pl->slot_ms * POWER_LIMIT_SLOTS;
+        int64_t average_allowed = (budget - (int64_t)pl->window_sum) / pl->slot_ms;
+        if (average_allowed < 0)
+        {
+            average_allowed = 0;
+        }
+        if (average_allowed < allowed)
+        {
+            allowed = (uint32_t)average_allowed;
+        }
+    }
+
+    pl->requested = requested;
+    pl->limiting = requested > allowed;
+    pl->duty = pl->limiting ? allowed : requested;
+    return pl->duty;
+}
+
+uint32_t power_limiter_average(const power_limiter_t *pl)
+{
+    if (pl->slot_ms == 0)
+    {
+        return pl->duty;
+    }
+    return (uint32_t)(pl->window_sum / ((uint64_t)pl->slot_ms * POWER_LIMIT_SLOTS));
+}
@@ -0,0 +1,25 @@
+#include "sigma_delta.h"
+
+void sigma_delta_init(sigma_delta_t *sd, uint32_t full_scale)
+{
+    sd->full_scale = full_scale > 0 ? full_scale : 1;
+    sd->level = 0;
+    sd->accumulator = 0;
+}
+
+void sigma_delta_set_level(sigma_delta_t *sd, uint32_t level)
+{
+    sd->level = level > sd->full_scale ? sd->full_scale : level;
+}
+
+bool sigma_delta_step(sigma_delta_t *sd)
+{
+    // accumulator < full_scale and level <= full_scale, so the sum cannot overflow 32 bits
+    sd->accumulator += sd->level;
+    if (sd->accumulator >= sd->full_scale)
+    {
+        sd->accumulator -= sd->full_scale;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,217 @@
+#include "telemetry_bus.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include <stdatomic.h>
+#include <string.h>
+
+static const char *TAG = "TELEMETRY";
+
+typedef struct
+{
+    telemetry_topic_t topic;
+    telemetry_context_t context;
+    uint32_t min_interval_us; // 0 = no rate limit
+    telemetry_callback_t callback;
+    void *ctx;
+    subject_slot_t slot;       // Latest value not yet delivered
+    atomic_uint published_us;  // Publish time of the value in the slot (for latency only)
+    uint32_t last_delivery_us; // Owned by the dispatching task
+    bool delivered;            // Owned by the dispatching task
+} telemetry_subscriber_t;
+
+typedef struct
+{
+    atomic_uint publishes;
+    atomic_uint deliveries;
+    atomic_uint coalesced;
+    atomic_uint last_latency_us;
+    atomic_uint max_latency_us;
+} topic_counters_t;
+
+static const char *const s_topic_names[TELEMETRY_TOPIC_COUNT] = {
+    [TELEMETRY_TOPIC_AIR_TEMP] = "air_temp",
+    [TELEMETRY_TOPIC_HEATER_TEMP] = "heater_temp",
+    [TELEMETRY_TOPIC_POWER] = "power",
+    [TELEMETRY_TOPIC_STATE] = "state",
+    [TELEMETRY_TOPIC_FAULT] = "fault",
+    [TELEMETRY_TOPIC_AIR_VOLTAGE] = "air_voltage",
+    [TELEMETRY_TOPIC_AIR_RESISTANCE] = "air_resistance",
+    [TELEMETRY_TOPIC_HEATER_VOLTAGE] = "heater_voltage",
+    [TELEMETRY_TOPIC_HEATER_RESISTANCE] = "heater_resistance",
+};
+
+static telemetry_subscriber_t s_subscribers[TELEMETRY_MAX_SUBSCRIBERS];
+static atomic_uint s_subscriber_count; // Entries below this index are fully initialized
+static atomic_bool s_context_pending[TELEMETRY_CONTEXT_COUNT];
+static topic_counters_t s_counters[TELEMETRY_TOPIC_COUNT];
+static atomic_uint s_latest[TELEMETRY_TOPIC_COUNT]; // Raw float bits
+static atomic_bool s_has_latest[TELEMETRY_TOPIC_COUNT];
+
+// Low 32 bits of the microsecond clock; only differences are used
+static uint32_t now_us(void)
+{
+    return (uint32_t)esp_timer_get_time();
+}
+
+bool telemetry_subscribe(telemetry_topic_t topic, telemetry_context_t context, float max_rate_hz,
+                         telemetry_callback_t callback, void *ctx)
+{
+    if (topic >= TELEMETRY_TOPIC_COUNT || context >= TELEMETRY_CONTEXT_COUNT || callback == NULL || max_rate_hz < 0.0f)
+    {
+        ESP_LOGE(TAG, "Invalid subscription");
+        return false;
+    }
+
+    unsigned count = atomic_load(&s_subscriber_count);
+    if (count >= TELEMETRY_MAX_SUBSCRIBERS)
+    {
+        ESP_LOGE(TAG, "No room for another subscriber to %s", s_topic_names[topic]);
+        return false;
+    }
+
+    telemetry_subscriber_t *sub = &s_subscribers[count];
+    memset(sub, 0, sizeof(*sub));
+    sub->topic = topic;
+    sub->context = context;
+    sub->min_interval_us = max_rate_hz > 0.0f ? (uint32_t)(1000000.0f / max_rate_hz) : 0;
+    sub->callback = callback;
+    sub->ctx = ctx;
+    atomic_store_explicit(&s_subscriber_count, count + 1, memory_order_release); // Publish the entry
+    return true;
+}
+
+void telemetry_publish(telemetry_topic_t topic, float value)
+{
+    if (topic >= TELEMETRY_TOPIC_COUNT)
+    {
+        return;
+    }
+
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    atomic_store(&s_latest[topic], bits);
+    atomic_store(&s_has_latest[topic], true);
+    atomic_fetch_add(&s_counters[topic].publishes, 1);
+
+    uint32_t now = now_us();
+    unsigned count = atomic_load_explicit(&s_subscriber_count, memory_order_acquire);
+    for (unsigned i = 0; i < count; i++)
+    {
+        telemetry_subscriber_t *sub = &s_subscribers[i];
+        if (sub->topic != topic)
+        {
+            continue;
+        }
+        atomic_store(&sub->published_us, now);
+        if (subject_slot_post_float(&sub->slot, value))
+        {
+            atomic_fetch_add(&s_counters[topic].coalesced, 1);
+        }
+        atomic_store(&s_context_pending[sub->context], true);
+    }
+}
+
+bool telemetry_get_latest(telemetry_topic_t topic, float *value)
+{
+    if (topic >= TELEMETRY_TOPIC_COUNT || !atomic_load(&s_has_latest[topic]))
+    {
+        return false;
+    }
+    uint32_t bits = atomic_load(&s_latest[topic]);
+    memcpy(value, &bits, sizeof(*value));
+    return true;
+}
+
+bool telemetry_context_pending(telemetry_context_t context)
+{
+    return context < TELEMETRY_CONTEXT_COUNT && atomic_load(&s_context_pending[context]);
+}
+
+static void record_delivery(topic_counters_t *counters, uint32_t latency_us)
+{
+    atomic_fetch_add(&counters->deliveries, 1);
+    atomic_store(&counters->last_latency_us, latency_us);
+    uint32_t max = atomic_load(&counters->max_latency_us);
+    while (latency_us > max && !atomic_compare_exchange_weak(&counters->max_latency_us, &max, latency_us))
+    {
+    }
+}
+
+void telemetry_dispatch(telemetry_context_t context)
+{
+    // Cleared before the slots are read: a value published meanwhile raises it again
+    if (context >= TELEMETRY_CONTEXT_COUNT || !atomic_exchange(&s_context_pending[context], false))
+    {
+        return;
+    }
+
+    uint32_t now = now_us();
+    bool deferred = false;
+    unsigned count = atomic_load_explicit(&s_subscriber_count, memory_order_acquire);
+    for (unsigned i = 0; i < count; i++)
+    {
+        telemetry_subscriber_t *sub = &s_subscribers[i];
+        if (sub->context != context)
+        {
+            continue;
+        }
+        if (sub->min_interval_us > 0 && sub->delivered && now - sub->last_delivery_us < sub->min_interval_us)
+        {
+            deferred |= atomic_load(&sub->slot.pending); // Keep the newest value for a later dispatch
+            continue;
+        }
+
+        float value;
+        if (!subject_slot_take_float(&sub->slot, &value))
+        {
+            continue;
+        }
+        sub->last_delivery_us = now;
+        sub->delivered = true;
+        record_delivery(&s_counters[sub->topic], now - atomic_load(&sub->published_us));
+        sub->callback(sub->topic, value, sub->ctx);
+    }
+
+    if (deferred)
+    {
+        atomic_store(&s_context_pending[context], true);
+    }
+}
+
+void telemetry_get_stats(telemetry_topic_t topic, telemetry_topic_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    if (topic >= TELEMETRY_TOPIC_COUNT)
+    {
+        return;
+    }
+    stats->publishes = atomic_load(&s_counters[topic].publishes);
+    stats->deliveries = atomic_load(&s_counters[topic].deliveries);
+    stats->coalesced = atomic_load(&s_counters[topic].coalesced);
+    stats->last_latency_us = atomic_load(&s_counters[topic].last_latency_us);
+    stats->max_latency_us = atomic_load(&s_counters[topic].max_latency_us);
+}
+
+const char *telemetry_topic_name(telemetry_topic_t topic)
+{
+    return topic < TELEMETRY_TOPIC_COUNT ? s_topic_names[topic] : "unknown";
+}
+
+void telemetry_reset(void)
+{
+    atomic_store(&s_subscriber_count, 0);
+    memset(s_subscribers, 0, sizeof(s_subscribers));
+    for (int i = 0; i < TELEMETRY_CONTEXT_COUNT; i++)
+    {
+        atomic_store(&s_context_pending[i], false);
+    }
+    for (int i = 0; i < TELEMETRY_TOPIC_COUNT; i++)
+    {
+        atomic_store(&s_counters[i].publishes, 0);
+        atomic_store(&s_counters[i].deliveries, 0);
+        atomic_store(&s_counters[i].coalesced, 0);
+        atomic_store(&s_counters[i].last_latency_us, 0);
+        atomic_store(&s_counters[i].max_latency_us, 0);
+        atomic_store(&s_has_latest[i], false);
+    }
+}
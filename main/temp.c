@@ -8,6 +8,7 @@
 #include "freertos/semphr.h"
 #include "esp_log.h"
 #include "esp_heap_caps.h"
+#include "esp_timer.h"
 #include "esp_adc/adc_oneshot.h"
 #include "esp_adc/adc_cali.h"
 #include "esp_adc/adc_cali_scheme.h"
@@ -15,7 +16,7 @@
 #include "sysmon_wrapper.h"
 #include "circular_buffer.h"
 #include "temp.h"
-#include "ui/subjects.h"
+#include "telemetry_bus.h"
 
 static const char *TAG = "TEMP";
 
@@ -39,9 +40,12 @@ typedef struct
 // Temperature sensor handle structure (opaque type implementation)
 struct temp_sensor_handle
 {
-  circular_buffer_t *buffer;                      // Pointer to the sensor's buffer
-  const thermistor_config_t *config;              // Pointer to the sensor's configuration
-  void (*publish_callback)(float temperature);     // Callback to publish temperature to subject
+  circular_buffer_t *buffer;                             // Pointer to the sensor's buffer
+  const thermistor_config_t *config;                     // Pointer to the sensor's configuration
+  void (*publish_callback)(const temp_sample_t *sample); // Callback to publish the sample to the telemetry bus
+  float previous_temperature;                            // Last in-range reading for the jump check, NAN if none
+  temp_fault_counts_t faults;                            // Rejected readings, written only by temp_task
+  uint32_t sequence;                                     // Readings taken so far, written only by temp_task
 };
 
 // Global temperature buffers
@@ -116,10 +120,15 @@ static float calculate_temperature_from_resistance(float thermistor_resistance,
 /**
  * @brief Read calibrated voltage from thermistor ADC channel
  * @param config Pointer to thermistor configuration
+ * @param[out] median_raw Median ADC count the voltage was derived from
+ * @param[out] valid_count Number of ADC samples that read successfully (0 on error)
  * @return Calibrated voltage in volts, or -999.0f on error
  */
-static float read_thermistor_voltage(const thermistor_config_t *config)
+static float read_thermistor_voltage(const thermistor_config_t *config, float *median_raw, uint16_t *valid_count)
 {
+  *median_raw = 0.0f;
+  *valid_count = 0;
+
   // Allocate buffer for calculating ADC median in PSRAM
   uint16_t *adc_samples = (uint16_t *)heap_caps_malloc(config->averaging_samples * sizeof(uint16_t), MALLOC_CAP_SPIRAM);
   if (adc_samples == NULL)
@@ -202,12 +211,100 @@ static float read_thermistor_voltage(const thermistor_config_t *config)
   // Free ADC median buffer
   heap_caps_free(adc_samples);
 
-  return voltage;
+  *median_raw = median_adc_reading;
+  *valid_count = valid_samples;
+  return valid_samples > 0 ? voltage : -999.0f;
+}
+
+temp_status_t temp_classify_reading(float median_raw, uint16_t valid_samples, float temperature,
+                                    float previous_temperature)
+{
+  if (valid_samples == 0)
+  {
+    return TEMP_STATUS_ADC_ERROR;
+  }
+
+  // The divider saturates the ADC long before the conversion math fails, so check the raw counts first
+  if (median_raw >= TEMP_ADC_OPEN_CIRCUIT_RAW)
+  {
+    return TEMP_STATUS_OPEN_CIRCUIT;
+  }
+  if (median_raw <= TEMP_ADC_SHORT_CIRCUIT_RAW)
+  {
+    return TEMP_STATUS_SHORT_CIRCUIT;
+  }
+
+  // Written so that NAN fails the range check
+  if (!(temperature >= TEMP_MIN_VALID_CELSIUS && temperature <= TEMP_MAX_VALID_CELSIUS))
+  {
+    return TEMP_STATUS_IMPLAUSIBLE;
+  }
+  if (!isnan(previous_temperature) && fabsf(temperature - previous_temperature) > TEMP_MAX_JUMP_CELSIUS)
+  {
+    return TEMP_STATUS_IMPLAUSIBLE;
+  }
+  return TEMP_STATUS_OK;
+}
+
+const char *temp_status_name(temp_status_t status)
+{
+  switch (status)
+  {
+  case TEMP_STATUS_OK:
+    return "ok";
+  case TEMP_STATUS_OPEN_CIRCUIT:
+    return "open";
+  case TEMP_STATUS_SHORT_CIRCUIT:
+    return "short";
+  case TEMP_STATUS_ADC_ERROR:
+    return "adc";
+  case TEMP_STATUS_IMPLAUSIBLE:
+    return "implausible";
+  default:
+    return "unknown";
+  }
+}
+
+// Counts a rejected reading against its sensor
+static void count_fault(temp_sensor_handle_t sensor, temp_status_t status)
+{
+  switch (status)
+  {
+  case TEMP_STATUS_OPEN_CIRCUIT:
+    sensor->faults.open_circuit++;
+    break;
+  case TEMP_STATUS_SHORT_CIRCUIT:
+    sensor->faults.short_circuit++;
+    break;
+  case TEMP_STATUS_ADC_ERROR:
+    sensor->faults.adc_error++;
+    break;
+  case TEMP_STATUS_IMPLAUSIBLE:
+    sensor->faults.implausible++;
+    break;
+  default:
+    break;
+  }
 }
 
 // Temperature reading task handle
 static TaskHandle_t temp_task_handle = NULL;
 
+// Publishing is wait-free, so a busy UI or web server never delays sampling
+static void publish_air_sample(const temp_sample_t *sample)
+{
+  telemetry_publish(TELEMETRY_TOPIC_AIR_TEMP, sample->temperature);
+  telemetry_publish(TELEMETRY_TOPIC_AIR_VOLTAGE, sample->voltage);
+  telemetry_publish(TELEMETRY_TOPIC_AIR_RESISTANCE, sample->resistance);
+}
+
+static void publish_heater_sample(const temp_sample_t *sample)
+{
+  telemetry_publish(TELEMETRY_TOPIC_HEATER_TEMP, sample->temperature);
+  telemetry_publish(TELEMETRY_TOPIC_HEATER_VOLTAGE, sample->voltage);
+  telemetry_publish(TELEMETRY_TOPIC_HEATER_RESISTANCE, sample->resistance);
+}
+
 /**
  * @brief Multi-sensor temperature reading task
  * Reads all sensors passed via parameters in a loop
@@ -232,7 +329,9 @@ static void temp_task(void *pvParameters)
       if (sensor_handle != NULL && sensor_handle->config != NULL && sensor_handle->buffer != NULL)
       {
         // Read voltage from this sensor
-        float voltage = read_thermistor_voltage(sensor_handle->config);
+        float median_raw = 0.0f;
+        uint16_t valid_count = 0;
+        float voltage = read_thermistor_voltage(sensor_handle->config, &median_raw, &valid_count);
 
         // Calculate thermistor resistance from voltage
         float resistance = calculate_thermistor_resistance(voltage, sensor_handle->config);
@@ -240,10 +339,20 @@ static void temp_task(void *pvParameters)
         // Calculate temperature from resistance using Steinhart-Hart equation
         float temperature = calculate_temperature_from_resistance(resistance, sensor_handle->config);
 
-        // Check for invalid readings
-        if (temperature < -50.0f || temperature > 150.0f)
+        // Classify the reading; consumers must treat anything but OK as no reading
+        temp_status_t status = temp_classify_reading(median_raw, valid_count, temperature,
+                                                     sensor_handle->previous_temperature);
+        bool in_range = temperature >= TEMP_MIN_VALID_CELSIUS && temperature <= TEMP_MAX_VALID_CELSIUS;
+        bool circuit_ok = status == TEMP_STATUS_OK || status == TEMP_STATUS_IMPLAUSIBLE;
+
+        // A genuine step is accepted on the next reading, which is compared against this one
+        sensor_handle->previous_temperature = (circuit_ok && in_range) ? temperature : NAN;
+
+        if (status != TEMP_STATUS_OK)
         {
-          ESP_LOGW(TAG, "Invalid temperature reading: %.2fC (Voltage: %.3fV, Resistance: %.0f ohm)", temperature, voltage, resistance);
+          ESP_LOGW(TAG, "Rejected temperature reading (%s): %.2fC (Raw: %.0f, Voltage: %.3fV, Resistance: %.0f ohm)",
+                   temp_status_name(status), temperature, median_raw, voltage, resistance);
+          count_fault(sensor_handle, status);
           temperature = -999.0f; // Mark as invalid
         }
         else
@@ -256,15 +365,18 @@ static void temp_task(void *pvParameters)
             .temperature = temperature,
             .voltage = voltage,
             .resistance = resistance,
-            .timestamp = (uint32_t)time(NULL)};
+            .timestamp = (uint32_t)time(NULL),
+            .status = status,
+            .sequence = ++sensor_handle->sequence,
+            .time_us = esp_timer_get_time()};
 
         // Store in buffer
         circular_buffer_push(sensor_handle->buffer, &sample);
 
-        // Publish temperature to subject callback
+        // Publish the reading to the telemetry bus
         if (sensor_handle->publish_callback != NULL)
         {
-          sensor_handle->publish_callback(temperature);
+          sensor_handle->publish_callback(&sample);
         }
       }
 
@@ -393,11 +505,13 @@ void temp_sensor_init(void)
   // Initialize sensor handles
   air_sensor_handle.buffer = &temp_buffer_1;
   air_sensor_handle.config = air_config_ptr;
-  air_sensor_handle.publish_callback = subjects_set_air_temp;
+  air_sensor_handle.publish_callback = publish_air_sample;
+  air_sensor_handle.previous_temperature = NAN;
 
   heater_sensor_handle.buffer = &temp_buffer_2;
   heater_sensor_handle.config = heater_config_ptr;
-  heater_sensor_handle.publish_callback = subjects_set_heater_temp;
+  heater_sensor_handle.publish_callback = publish_heater_sample;
+  heater_sensor_handle.previous_temperature = NAN;
 
   ESP_LOGI(TAG, "Heater sensor calibration: %.0fC@%.0f ohm, %.0fC@%.0f ohm, %.0fC@%.0f ohm",
            heater_cal_point_1.temperature_celsius, heater_cal_point_1.resistance_ohms,
@@ -600,6 +714,47 @@ bool temp_sensor_get_latest_sample(temp_sensor_handle_t sensor, temp_sample_t *s
   return circular_buffer_get_latest(sensor->buffer, sample);
 }
 
+/**
+ * @brief Get the latest sample of a sensor if it can be used for control
+ * @param sensor Handle to the temperature sensor (NULL allowed)
+ * @param[out] sample Latest sample, untouched on failure
+ * @return true if the sample was classified TEMP_STATUS_OK and is at most TEMP_MAX_SAMPLE_AGE_MS old
+ */
+bool temp_sensor_get_usable_sample(temp_sensor_handle_t sensor, temp_sample_t *sample)
+{
+  temp_sample_t latest;
+  if (sample == NULL || !temp_sensor_get_latest_sample(sensor, &latest) || latest.status != TEMP_STATUS_OK)
+  {
+    return false;
+  }
+
+  // A hung temp_task leaves the last good sample in the buffer forever
+  int64_t age_us = esp_timer_get_time() - latest.time_us;
+  if (age_us > (int64_t)TEMP_MAX_SAMPLE_AGE_MS * 1000)
+  {
+    return false;
+  }
+  *sample = latest;
+  return true;
+}
+
+/**
+ * @brief Get the latest temperature of a sensor if it can be used for control
+ * @param sensor Handle to the temperature sensor (NULL allowed)
+ * @param[out] temperature Latest temperature in Celsius, untouched on failure
+ * @return true if temp_sensor_get_usable_sample() succeeds
+ */
+bool temp_sensor_read_ok(temp_sensor_handle_t sensor, float *temperature)
+{
+  temp_sample_t sample;
+  if (temperature == NULL || !temp_sensor_get_usable_sample(sensor, &sample))
+  {
+    return false;
+  }
+  *temperature = sample.temperature;
+  return true;
+}
+
 /**
  * @brief Get number of stored temperature samples from a sensor
  * @param sensor Handle to the temperature sensor
@@ -635,6 +790,24 @@ float temp_sensor_get_voltage(temp_sensor_handle_t sensor)
   return -999.0f;
 }
 
+  /**
+   * @brief Get the number of rejected readings of a sensor, by fault
+   * @param sensor Handle to the temperature sensor
+   * @param[out] counts Counters to fill
+   * @return true on success, false for an invalid sensor
+   */
+  bool temp_sensor_get_fault_counts(temp_sensor_handle_t sensor, temp_fault_counts_t *counts)
+  {
+    if (sensor == NULL || counts == NULL)
+    {
+      return false;
+    }
+
+    // Each counter is a single aligned word written only by temp_task
+    *counts = sensor->faults;
+    return true;
+  }
+
   /**
    * @brief Get the most recent thermistor resistance reading from a sensor
    * @param sensor Handle to the temperature sensor
@@ -1,17 +1,26 @@
 #include "lvgl.h"
 #include "ui/analog_dial.h"
+#include "ui/needle_physics.h"
+#include "ui/value_text.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <math.h>
+#ifdef ESP_PLATFORM
+#include "esp_heap_caps.h"
+#endif
 
-/* Physics update rate: 60fps = ~16.67ms */
+/* Physics update rate: 60fps = ~16.67ms; the model steps by the real elapsed time, so slower is fine */
 #define PHYSICS_UPDATE_PERIOD_MS 16
-#define PHYSICS_DT_S (PHYSICS_UPDATE_PERIOD_MS / 1000.0f)
 
-/* Spring-damper physics parameters */
-#define SPRING_CONSTANT_K 15.0f    /* Higher = stiffer spring, more overshoot */
-#define DAMPING_COEFFICIENT_C 0.8f /* Higher = more damping, less oscillation */
-#define NEEDLE_MASS_M 0.1f         /* Mass of the needle (affects inertia) */
+/* Section styles for one band color - must persist for LVGL, shared by every dial using the palette */
+typedef struct
+{
+  lv_style_t main;      /* Arc color */
+  lv_style_t indicator; /* Major ticks and labels */
+  lv_style_t items;     /* Minor ticks */
+  uint32_t users;       /* Dials referencing the styles; they are reset when the last one is freed */
+} dial_band_styles_t;
 
 struct analog_dial_t
 {
@@ -21,60 +30,258 @@ struct analog_dial_t
   lv_obj_t *value_label;
   int32_t needle_length;
 
-  /* Section styles for green range (target) - must persist for LVGL */
-  lv_style_t style_green_main;       /* Arc color */
-  lv_style_t style_green_indicator;  /* Major ticks and labels */
-  lv_style_t style_green_items;      /* Minor ticks */
+  /* Shared section styles for the green range (target) and the red range (above target) */
+  dial_band_styles_t *styles_green;
+  dial_band_styles_t *styles_red;
 
-  /* Section styles for red range (above target) - must persist for LVGL */
-  lv_style_t style_red_main;         /* Arc color */
-  lv_style_t style_red_indicator;    /* Major ticks and labels */
-  lv_style_t style_red_items;        /* Minor ticks */
+  /* Sections, kept so the target band can be moved later */
+  lv_scale_section_t *section_green;
+  lv_scale_section_t *section_red;
+  float min_value;
+  float max_value;
 
   /* Range boundaries for value label coloring */
   float green_range_low;
   float green_range_high;
 
+  /* Label state last written, so unchanged readings do not invalidate the label */
+  int32_t shown_value; /* value_text_quantize() of the label text */
+  int shown_zone;      /* Color zone of the label: -1 below, 0 green, 1 above the green range */
+
+  /* Static scale rendered once and shown as the container background; the scale itself stays hidden */
+  lv_draw_buf_t background;
+  void *background_data;
+
+  /* Needle geometry: the line object is sized to the needle's bounding box */
+  lv_point_t center; /* Scale center relative to the container content area */
+  lv_point_precise_t needle_points[2];
+
   /* Physics state - using floats for smooth motion */
-  float position;        /* Current needle position */
-  float target_position; /* Target position from subject */
-  float velocity;        /* Current velocity */
+  needle_model_t needle;
+  int32_t drawn_position; /* Needle value currently drawn */
 
-  /* Physics timer for continuous updates */
-  lv_timer_t *physics_timer;
+  /* Next dial in the physics scheduler's list */
+  struct analog_dial_t *next;
 };
 
+/* Interned band styles, one slot per palette, initialized on first use */
+static dial_band_styles_t s_band_styles[LV_PALETTE_LAST];
+
+/* Physics scheduler: one timer steps every dial, paused while all needles are settled */
+static struct analog_dial_t *s_dials;
+static lv_timer_t *s_physics_timer;
+static bool s_physics_running;
+static uint32_t s_last_tick; /* lv_tick of the previous physics step */
+
+static dial_band_styles_t *band_styles_acquire(lv_palette_t palette)
+{
+  dial_band_styles_t *styles = &s_band_styles[palette];
+  if (styles->users++ == 0)
+  {
+    lv_style_init(&styles->main);
+    lv_style_set_arc_color(&styles->main, lv_palette_main(palette));
+    lv_style_set_arc_width(&styles->main, 4);
+
+    lv_style_init(&styles->indicator);
+    lv_style_set_text_color(&styles->indicator, lv_palette_main(palette));
+    lv_style_set_line_color(&styles->indicator, lv_palette_main(palette));
+
+    lv_style_init(&styles->items);
+    lv_style_set_line_color(&styles->items, lv_palette_main(palette));
+  }
+  return styles;
+}
+
+/* The scales using the styles must already be deleted */
+static void band_styles_release(dial_band_styles_t *styles)
+{
+  if (--styles->users == 0)
+  {
+    lv_style_reset(&styles->main);
+    lv_style_reset(&styles->indicator);
+    lv_style_reset(&styles->items);
+  }
+}
+
+static void dial_add_section(struct analog_dial_t *dial, lv_scale_section_t *section, dial_band_styles_t *styles)
+{
+  lv_scale_set_section_style_main(dial->scale, section, &styles->main);
+  lv_scale_set_section_style_indicator(dial->scale, section, &styles->indicator);
+  lv_scale_set_section_style_items(dial->scale, section, &styles->items);
+}
+
 /**
- * Physics update callback - runs at 60fps
- * Calculates spring-damper forces and updates needle position
+ * Places the needle line for a scale value
+ * The line object spans only the needle's bounding box, so a move invalidates the old and new
+ * boxes and the cached background is blitted back under them; the scale is never redrawn
  */
-static void physics_update_cb(lv_timer_t *timer)
+static void dial_draw_needle(struct analog_dial_t *dial, int32_t value)
 {
-  struct analog_dial_t *dial = lv_timer_get_user_data(timer);
+  if (value < dial->min_value)
+  {
+    value = (int32_t)dial->min_value;
+  }
+  else if (value > dial->max_value)
+  {
+    value = (int32_t)dial->max_value;
+  }
+
+  /* Same mapping as lv_scale: rotation plus the value's share of the angle range, clockwise */
+  float span = dial->max_value - dial->min_value;
+  float angle_deg = lv_scale_get_rotation(dial->scale) + (value - dial->min_value) * ANALOG_DIAL_ANGLE_RANGE / span;
+  float angle_rad = angle_deg * 3.14159265f / 180.0f;
+  int32_t end_x = dial->center.x + (int32_t)lroundf(dial->needle_length * cosf(angle_rad));
+  int32_t end_y = dial->center.y + (int32_t)lroundf(dial->needle_length * sinf(angle_rad));
+
+  int32_t left = LV_MIN(dial->center.x, end_x);
+  int32_t top = LV_MIN(dial->center.y, end_y);
+  dial->needle_points[0].x = dial->center.x - left;
+  dial->needle_points[0].y = dial->center.y - top;
+  dial->needle_points[1].x = end_x - left;
+  dial->needle_points[1].y = end_y - top;
+
+  lv_obj_set_pos(dial->needle_line, left, top);
+  lv_line_set_points(dial->needle_line, dial->needle_points, 2);
+}
+
+/**
+ * Sets the green (target) and red (above target) bands and the label color thresholds
+ */
+static void dial_set_sections(struct analog_dial_t *dial, float target_value, float target_range)
+{
+  /* Calculate green band range: target +/- (range/2) */
+  float green_low = target_value - (target_range / 2.0f);
+  float green_high = target_value + (target_range / 2.0f);
+
+  /* Clamp to min/max bounds */
+  if (green_low < dial->min_value)
+  {
+    green_low = dial->min_value;
+  }
+  if (green_high > dial->max_value)
+  {
+    green_high = dial->max_value;
+  }
+
+  /* Store range boundaries for value label coloring */
+  dial->green_range_low = green_low;
+  dial->green_range_high = green_high;
+
+  /* A section with an empty range draws nothing */
+  lv_scale_set_section_range(dial->scale, dial->section_green, green_low, LV_MAX(green_low, green_high));
+  lv_scale_set_section_range(dial->scale, dial->section_red, green_high, dial->max_value);
+}
+
+static void *alloc_background(size_t size)
+{
+#ifdef ESP_PLATFORM
+  /* Blitting from PSRAM is still far cheaper than re-rendering the scale, and keeps internal RAM for DMA */
+  void *data = heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
+  if (data != NULL)
+  {
+    return data;
+  }
+#endif
+  return malloc(size);
+}
+
+/**
+ * Renders the static scale (arc, ticks, labels, sections) once into a buffer and shows it as the
+ * container background. Called at creation and whenever the target band changes.
+ * If the buffer cannot be allocated (or LV_USE_SNAPSHOT is off, or CONFIG_UI_DIAL_LIVE_SCALE is set for a
+ * before/after measurement) the scale stays visible and is drawn live.
+ */
+static void dial_cache_background(struct analog_dial_t *dial)
+{
+#if LV_USE_SNAPSHOT && !defined(CONFIG_UI_DIAL_LIVE_SCALE)
+  lv_obj_t *container = dial->container;
+
+  /* Render the scale alone on the container's background */
+  lv_obj_set_style_bg_image_src(container, NULL, LV_PART_MAIN);
+  lv_obj_remove_flag(dial->scale, LV_OBJ_FLAG_HIDDEN);
+  lv_obj_add_flag(dial->needle_line, LV_OBJ_FLAG_HIDDEN);
+  lv_obj_add_flag(dial->value_label, LV_OBJ_FLAG_HIDDEN);
+  lv_obj_update_layout(container);
+
+  if (dial->background_data == NULL)
+  {
+    uint32_t width = lv_obj_get_width(container);
+    uint32_t height = lv_obj_get_height(container);
+    uint32_t stride = lv_draw_buf_width_to_stride(width, LV_COLOR_FORMAT_NATIVE);
+    dial->background_data = alloc_background(stride * height);
+    if (dial->background_data != NULL)
+    {
+      lv_draw_buf_init(&dial->background, width, height, LV_COLOR_FORMAT_NATIVE, stride,
+                       dial->background_data, stride * height);
+    }
+  }
+  else
+  {
+    lv_image_cache_drop(&dial->background); /* Same source pointer, new pixels */
+  }
 
-  /* Calculate spring force: F_spring = -k × displacement */
-  float displacement = dial->target_position - dial->position;
-  float spring_force = SPRING_CONSTANT_K * displacement;
+  bool cached = dial->background_data != NULL &&
+                lv_snapshot_take_to_draw_buf(container, LV_COLOR_FORMAT_NATIVE, &dial->background) == LV_RESULT_OK;
+  if (cached)
+  {
+    lv_obj_set_style_bg_image_src(container, &dial->background, LV_PART_MAIN);
+    lv_obj_add_flag(dial->scale, LV_OBJ_FLAG_HIDDEN);
+  }
 
-  /* Calculate damper force: F_damper = -c × velocity */
-  float damper_force = DAMPING_COEFFICIENT_C * dial->velocity;
+  lv_obj_remove_flag(dial->needle_line, LV_OBJ_FLAG_HIDDEN);
+  lv_obj_remove_flag(dial->value_label, LV_OBJ_FLAG_HIDDEN);
+  lv_obj_invalidate(container);
+#else
+  lv_obj_invalidate(dial->scale);
+#endif
+}
 
-  /* Net force */
-  float net_force = spring_force - damper_force;
+/**
+ * Physics update callback - runs every PHYSICS_UPDATE_PERIOD_MS while any needle moves
+ * Steps the spring-damper model of every dial that is not settled, redraws a needle only when its
+ * integer position changes and pauses itself once all needles have settled
+ */
+static void physics_update_cb(lv_timer_t *timer)
+{
+  /* Step by the time that really passed; late or dropped frames do not slow the needles down */
+  uint32_t elapsed_ms = lv_tick_elaps(s_last_tick);
+  s_last_tick += elapsed_ms;
+  float dt_s = elapsed_ms / 1000.0f;
 
-  /* Update velocity: v += (F / m) × dt */
-  float acceleration = net_force / NEEDLE_MASS_M;
-  dial->velocity += acceleration * PHYSICS_DT_S;
+  bool any_moving = false;
+  for (struct analog_dial_t *dial = s_dials; dial != NULL; dial = dial->next)
+  {
+    if (dial->needle.settled)
+    {
+      continue;
+    }
+    any_moving |= needle_model_step(&dial->needle, dt_s);
+
+    /* The needle only moves in whole values; anything finer would invalidate it for nothing */
+    int32_t position = (int32_t)dial->needle.position;
+    if (position != dial->drawn_position)
+    {
+      dial->drawn_position = position;
+      dial_draw_needle(dial, position);
+    }
+  }
 
-  /* Update position: x += v × dt */
-  dial->position += dial->velocity * PHYSICS_DT_S;
+  if (!any_moving)
+  {
+    lv_timer_pause(timer);
+    s_physics_running = false;
+  }
+}
 
-  /* Update LVGL needle position */
-  lv_scale_set_line_needle_value(
-      dial->scale,
-      dial->needle_line,
-      dial->needle_length,
-      (int32_t)dial->position);
+/* Wakes the shared physics timer; time starts counting now if it was paused */
+static void physics_wake(void)
+{
+  if (!s_physics_running)
+  {
+    s_last_tick = lv_tick_get();
+    lv_timer_resume(s_physics_timer);
+    s_physics_running = true;
+  }
 }
 
 /**
@@ -87,30 +294,43 @@ static void dial_value_observer_cb(lv_observer_t *observer, lv_subject_t *subjec
   float new_value = lv_subject_get_float(subject);
 
   /* Update target position */
-  dial->target_position = new_value;
+  bool was_settled = dial->needle.settled;
+  needle_model_set_target(&dial->needle, new_value);
 
-  /* Update value label with exact emitted value (1 decimal precision) */
-  char value_text[16];
-  snprintf(value_text, sizeof(value_text), "%.1f", new_value);
-  lv_label_set_text(dial->value_label, value_text);
+  /* Update value label (1 decimal precision); setting text or color invalidates it even when unchanged */
+  int32_t shown = value_text_quantize(new_value, 1.0f, 1);
+  if (shown != dial->shown_value)
+  {
+    char value_text[16];
+    value_text_format(value_text, sizeof(value_text), shown, 1, NULL, NULL);
+    lv_label_set_text(dial->value_label, value_text);
+    dial->shown_value = shown;
+  }
 
   /* Update value label color based on which range the value falls into */
+  int zone = -1;
   if (new_value >= dial->green_range_low && new_value <= dial->green_range_high)
   {
-    lv_obj_set_style_text_color(dial->value_label, lv_palette_main(LV_PALETTE_GREEN), LV_PART_MAIN);
+    zone = 0;
   }
   else if (new_value > dial->green_range_high)
   {
-    lv_obj_set_style_text_color(dial->value_label, lv_palette_main(LV_PALETTE_RED), LV_PART_MAIN);
+    zone = 1;
   }
-  else
+  if (zone != dial->shown_zone)
   {
-    /* Below green range - use default black color */
-    lv_obj_set_style_text_color(dial->value_label, lv_color_black(), LV_PART_MAIN);
+    lv_color_t color = zone == 0   ? lv_palette_main(LV_PALETTE_GREEN)
+                       : zone == 1 ? lv_palette_main(LV_PALETTE_RED)
+                                   : lv_color_black(); /* Below green range - use default black color */
+    lv_obj_set_style_text_color(dial->value_label, color, LV_PART_MAIN);
+    dial->shown_zone = zone;
   }
 
-  /* Resume physics timer if it was paused */
-  lv_timer_resume(dial->physics_timer);
+  /* Wake the physics timer only if the needle has somewhere to go */
+  if (was_settled && !dial->needle.settled)
+  {
+    physics_wake();
+  }
 }
 
 struct analog_dial_t *create_analog_dial(
@@ -161,12 +381,11 @@ struct analog_dial_t *create_analog_dial(
   int top_padding = d2 + ANALOG_DIAL_VERT_SHIFT - c2;
   int bottom_padding = d2 - ANALOG_DIAL_VERT_SHIFT - c2;
 
-  struct analog_dial_t *dial = malloc(sizeof(struct analog_dial_t));
+  struct analog_dial_t *dial = calloc(1, sizeof(struct analog_dial_t));
 
   /* Initialize physics state */
-  dial->position = 0.0f;
-  dial->target_position = 0.0f;
-  dial->velocity = 0.0f;
+  needle_model_init(&dial->needle, 0.0f);
+  dial->drawn_position = 0;
 
   lv_obj_t *container = lv_obj_create(parent);
   dial->container = container;
@@ -220,67 +439,17 @@ struct analog_dial_t *create_analog_dial(
 
   lv_scale_set_angle_range(scale_line, ANALOG_DIAL_ANGLE_RANGE);
 
-  /* Calculate green band range: target +/- (range/2) */
-  float green_low = target_value - (target_range / 2.0f);
-  float green_high = target_value + (target_range / 2.0f);
+  /* Add green and red sections with the shared styles of their palette */
+  dial->min_value = min_value;
+  dial->max_value = max_value;
+  dial->styles_green = band_styles_acquire(LV_PALETTE_GREEN);
+  dial->styles_red = band_styles_acquire(LV_PALETTE_RED);
+  dial->section_green = lv_scale_add_section(scale_line);
+  dial_add_section(dial, dial->section_green, dial->styles_green);
+  dial->section_red = lv_scale_add_section(scale_line);
+  dial_add_section(dial, dial->section_red, dial->styles_red);
 
-  /* Clamp to min/max bounds */
-  if (green_low < min_value)
-  {
-    green_low = min_value;
-  }
-  if (green_high > max_value)
-  {
-    green_high = max_value;
-  }
-
-  /* Store range boundaries for value label coloring */
-  dial->green_range_low = green_low;
-  dial->green_range_high = green_high;
-
-  /* Initialize green section styles */
-  lv_style_init(&dial->style_green_main);
-  lv_style_set_arc_color(&dial->style_green_main, lv_palette_main(LV_PALETTE_GREEN));
-  lv_style_set_arc_width(&dial->style_green_main, 4);
-
-  lv_style_init(&dial->style_green_indicator);
-  lv_style_set_text_color(&dial->style_green_indicator, lv_palette_main(LV_PALETTE_GREEN));
-  lv_style_set_line_color(&dial->style_green_indicator, lv_palette_main(LV_PALETTE_GREEN));
-
-  lv_style_init(&dial->style_green_items);
-  lv_style_set_line_color(&dial->style_green_items, lv_palette_main(LV_PALETTE_GREEN));
-
-  /* Initialize red section styles */
-  lv_style_init(&dial->style_red_main);
-  lv_style_set_arc_color(&dial->style_red_main, lv_palette_main(LV_PALETTE_RED));
-  lv_style_set_arc_width(&dial->style_red_main, 4);
-
-  lv_style_init(&dial->style_red_indicator);
-  lv_style_set_text_color(&dial->style_red_indicator, lv_palette_main(LV_PALETTE_RED));
-  lv_style_set_line_color(&dial->style_red_indicator, lv_palette_main(LV_PALETTE_RED));
-
-  lv_style_init(&dial->style_red_items);
-  lv_style_set_line_color(&dial->style_red_items, lv_palette_main(LV_PALETTE_RED));
-
-  /* Add green section with all style components */
-  if (green_low < green_high)
-  {
-    lv_scale_section_t *section_green = lv_scale_add_section(scale_line);
-    lv_scale_set_section_range(scale_line, section_green, green_low, green_high);
-    lv_scale_set_section_style_main(scale_line, section_green, &dial->style_green_main);
-    lv_scale_set_section_style_indicator(scale_line, section_green, &dial->style_green_indicator);
-    lv_scale_set_section_style_items(scale_line, section_green, &dial->style_green_items);
-  }
-
-  /* Add red section with all style components */
-  if (green_high < max_value)
-  {
-    lv_scale_section_t *section_red = lv_scale_add_section(scale_line);
-    lv_scale_set_section_range(scale_line, section_red, green_high, max_value);
-    lv_scale_set_section_style_main(scale_line, section_red, &dial->style_red_main);
-    lv_scale_set_section_style_indicator(scale_line, section_red, &dial->style_red_indicator);
-    lv_scale_set_section_style_items(scale_line, section_red, &dial->style_red_items);
-  }
+  dial_set_sections(dial, target_value, target_range);
 
   lv_scale_set_rotation(scale_line, 180 + (180 - ANALOG_DIAL_ANGLE_RANGE) / 2);
 
@@ -292,10 +461,13 @@ struct analog_dial_t *create_analog_dial(
   lv_obj_set_style_bg_opa(value_label, LV_OPA_TRANSP, LV_PART_MAIN);
   lv_obj_set_style_text_opa(value_label, LV_OPA_COVER, LV_PART_MAIN);
   lv_label_set_text(value_label, "0.0");
+  dial->shown_value = 0;
+  dial->shown_zone = -1;
   /* Move up from bottom - container is 80px high, place label at visible bottom area */
   lv_obj_align(value_label, LV_ALIGN_BOTTOM_MID, 0, -35);
 
-  lv_obj_t *needle_line = lv_line_create(scale_line);
+  /* Needle is a sibling of the scale so it stays visible while the scale is hidden behind its cached image */
+  lv_obj_t *needle_line = lv_line_create(container);
   dial->needle_line = needle_line;
 
   lv_obj_set_style_line_width(needle_line, 1, LV_PART_MAIN);
@@ -304,9 +476,27 @@ struct analog_dial_t *create_analog_dial(
 
   dial->needle_length = d2 + major_tick_length;
 
-  /* Create physics timer - initially paused */
-  dial->physics_timer = lv_timer_create(physics_update_cb, PHYSICS_UPDATE_PERIOD_MS, dial);
-  lv_timer_pause(dial->physics_timer);
+  /* Scale center in the container's content coordinates, where the needle line is positioned */
+  lv_obj_update_layout(container);
+  lv_area_t scale_area;
+  lv_area_t container_area;
+  lv_obj_get_coords(scale_line, &scale_area);
+  lv_obj_get_coords(container, &container_area);
+  dial->center.x = scale_area.x1 + lv_area_get_width(&scale_area) / 2 - (container_area.x1 + horiz_padding);
+  dial->center.y = scale_area.y1 + lv_area_get_height(&scale_area) / 2 - (container_area.y1 + top_padding);
+  dial_draw_needle(dial, dial->drawn_position);
+
+  dial_cache_background(dial);
+
+  /* Register with the physics scheduler; the first dial creates its timer, initially paused */
+  if (s_physics_timer == NULL)
+  {
+    s_physics_timer = lv_timer_create(physics_update_cb, PHYSICS_UPDATE_PERIOD_MS, NULL);
+    lv_timer_pause(s_physics_timer);
+    s_physics_running = false;
+  }
+  dial->next = s_dials;
+  s_dials = dial;
 
   /* Bind observer to subject - initial notification will set target and wake physics */
   lv_subject_add_observer_obj(subject, dial_value_observer_cb, container, dial);
@@ -314,12 +504,28 @@ struct analog_dial_t *create_analog_dial(
   return dial;
 }
 
+void analog_dial_set_target(struct analog_dial_t *dial, float target_value, float target_range)
+{
+  dial_set_sections(dial, target_value, target_range);
+  dial_cache_background(dial);
+}
+
 void free_analog_dial(struct analog_dial_t *dial)
 {
-  /* Stop physics timer first */
-  if (dial->physics_timer != NULL)
+  /* Unregister from the physics scheduler first; the last dial takes the timer with it */
+  for (struct analog_dial_t **link = &s_dials; *link != NULL; link = &(*link)->next)
   {
-    lv_timer_del(dial->physics_timer);
+    if (*link == dial)
+    {
+      *link = dial->next;
+      break;
+    }
+  }
+  if (s_dials == NULL && s_physics_timer != NULL)
+  {
+    lv_timer_delete(s_physics_timer);
+    s_physics_timer = NULL;
+    s_physics_running = false;
   }
 
   /* deletes recursively delete children too but we will still try to delete
@@ -328,5 +534,12 @@ void free_analog_dial(struct analog_dial_t *dial)
   lv_obj_delete(dial->value_label);
   lv_obj_delete(dial->scale);
   lv_obj_delete(dial->container);
+  band_styles_release(dial->styles_green);
+  band_styles_release(dial->styles_red);
+  if (dial->background_data != NULL)
+  {
+    lv_image_cache_drop(&dial->background);
+    free(dial->background_data);
+  }
   free(dial);
 }
@@ -0,0 +1,60 @@
+#include "ui/needle_physics.h"
+#include <math.h>
+
+void needle_model_init(needle_model_t *model, float position)
+{
+  model->position = position;
+  model->target = position;
+  model->velocity = 0.0f;
+  model->settled = true;
+}
+
+void needle_model_set_target(needle_model_t *model, float target)
+{
+  model->target = target;
+  if (fabsf(target - model->position) >= NEEDLE_SETTLE_EPSILON)
+  {
+    model->settled = false;
+  }
+}
+
+bool needle_model_step(needle_model_t *model, float dt_s)
+{
+  if (model->settled)
+  {
+    return false;
+  }
+
+  if (dt_s > NEEDLE_MAX_DT_S)
+  {
+    dt_s = NEEDLE_MAX_DT_S;
+  }
+
+  /*
+   * Exact solution of m x'' + c x' + k (x - target) = 0 over dt for a fixed target:
+   *   e(t) = exp(-a t) (e0 cos(w t) + (v0 + a e0) / w sin(w t))
+   *   v(t) = exp(-a t) (v0 cos(w t) - (a v0 + w0^2 e0) / w sin(w t))
+   * with a = c / 2m, w0^2 = k / m and w = sqrt(w0^2 - a^2)
+   */
+  const float a = NEEDLE_DAMPING_C / (2.0f * NEEDLE_MASS_M);
+  const float w0_sq = NEEDLE_SPRING_K / NEEDLE_MASS_M;
+  const float w = sqrtf(w0_sq - a * a);
+
+  float e0 = model->position - model->target;
+  float v0 = model->velocity;
+  float decay = expf(-a * dt_s);
+  float c = cosf(w * dt_s);
+  float s = sinf(w * dt_s);
+
+  model->position = model->target + decay * (e0 * c + (v0 + a * e0) / w * s);
+  model->velocity = decay * (v0 * c - (a * v0 + w0_sq * e0) / w * s);
+
+  if (fabsf(model->target - model->position) < NEEDLE_SETTLE_EPSILON &&
+      fabsf(model->velocity) < NEEDLE_SETTLE_EPSILON)
+  {
+    model->position = model->target;
+    model->velocity = 0.0f;
+    model->settled = true;
+  }
+  return !model->settled;
+}
@@ -0,0 +1,53 @@
+#include "ui/subject_mailbox.h"
+#include <string.h>
+
+static bool post_bits(subject_slot_t *slot, uint32_t bits)
+{
+    atomic_store_explicit(&slot->value, bits, memory_order_relaxed);
+    return atomic_exchange_explicit(&slot->pending, true, memory_order_release);
+}
+
+static bool take_bits(subject_slot_t *slot, uint32_t *bits)
+{
+    if (!atomic_exchange_explicit(&slot->pending, false, memory_order_acquire))
+    {
+        return false;
+    }
+    // A post racing with this read raises pending again, so its value is applied next frame too
+    *bits = atomic_load_explicit(&slot->value, memory_order_relaxed);
+    return true;
+}
+
+bool subject_slot_post_float(subject_slot_t *slot, float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return post_bits(slot, bits);
+}
+
+bool subject_slot_post_int(subject_slot_t *slot, int32_t value)
+{
+    return post_bits(slot, (uint32_t)value);
+}
+
+bool subject_slot_take_float(subject_slot_t *slot, float *value)
+{
+    uint32_t bits;
+    if (!take_bits(slot, &bits))
+    {
+        return false;
+    }
+    memcpy(value, &bits, sizeof(*value));
+    return true;
+}
+
+bool subject_slot_take_int(subject_slot_t *slot, int32_t *value)
+{
+    uint32_t bits;
+    if (!take_bits(slot, &bits))
+    {
+        return false;
+    }
+    *value = (int32_t)bits;
+    return true;
+}
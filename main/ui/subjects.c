@@ -1,7 +1,10 @@
 #include "ui/subjects.h"
 #include "esp_lvgl_port.h"
 #include "esp_log.h"
-#include "web_server.h"
+#include "ui/subject_mailbox.h"
+#include "telemetry_bus.h"
+
+static const char *TAG = "SUBJECTS";
 
 /* Define all subjects */
 lv_subject_t g_subject_heater_temp;
@@ -9,6 +12,91 @@ lv_subject_t g_subject_air_temp;
 lv_subject_t g_subject_heater_power;
 lv_subject_t g_subject_fan_speed;
 lv_subject_t g_subject_system_state;
+lv_subject_t g_subject_profile_step;
+lv_subject_t g_subject_profile_remaining;
+lv_subject_t g_subject_heater_fault;
+lv_subject_t g_subject_energy_wh;
+lv_subject_t g_subject_heater_avg_power;
+lv_subject_t g_subject_power_limited;
+lv_subject_t g_subject_air_voltage;
+lv_subject_t g_subject_air_resistance;
+lv_subject_t g_subject_heater_voltage;
+lv_subject_t g_subject_heater_resistance;
+
+/* One latest-value mailbox slot per subject written through a setter (the rest follow the telemetry bus) */
+typedef enum
+{
+    SLOT_FAN_SPEED,
+    SLOT_PROFILE_STEP,
+    SLOT_PROFILE_REMAINING,
+    SLOT_ENERGY_WH,
+    SLOT_HEATER_AVG_POWER,
+    SLOT_POWER_LIMITED,
+    SLOT_COUNT
+} subject_slot_id_t;
+
+static subject_slot_t s_slots[SLOT_COUNT];
+static lv_subject_t *const s_slot_subjects[SLOT_COUNT] = {
+    [SLOT_FAN_SPEED] = &g_subject_fan_speed,
+    [SLOT_PROFILE_STEP] = &g_subject_profile_step,
+    [SLOT_PROFILE_REMAINING] = &g_subject_profile_remaining,
+    [SLOT_ENERGY_WH] = &g_subject_energy_wh,
+    [SLOT_HEATER_AVG_POWER] = &g_subject_heater_avg_power,
+    [SLOT_POWER_LIMITED] = &g_subject_power_limited,
+};
+static lv_timer_t *s_apply_timer;
+
+/* Telemetry bus subscribers, run by telemetry_dispatch() in the LVGL task */
+static void telemetry_float_cb(telemetry_topic_t topic, float value, void *ctx)
+{
+    lv_subject_set_float((lv_subject_t *)ctx, value);
+}
+
+static void telemetry_int_cb(telemetry_topic_t topic, float value, void *ctx)
+{
+    lv_subject_set_int((lv_subject_t *)ctx, (int32_t)value);
+}
+
+static void subscribe_telemetry(void)
+{
+    /* No rate limit: the apply timer already paces delivery to the frame rate */
+    telemetry_subscribe(TELEMETRY_TOPIC_AIR_TEMP, TELEMETRY_CONTEXT_LVGL, 0.0f, telemetry_float_cb, &g_subject_air_temp);
+    telemetry_subscribe(TELEMETRY_TOPIC_HEATER_TEMP, TELEMETRY_CONTEXT_LVGL, 0.0f, telemetry_float_cb, &g_subject_heater_temp);
+    telemetry_subscribe(TELEMETRY_TOPIC_POWER, TELEMETRY_CONTEXT_LVGL, 0.0f, telemetry_float_cb, &g_subject_heater_power);
+    telemetry_subscribe(TELEMETRY_TOPIC_STATE, TELEMETRY_CONTEXT_LVGL, 0.0f, telemetry_float_cb, &g_subject_system_state);
+    telemetry_subscribe(TELEMETRY_TOPIC_FAULT, TELEMETRY_CONTEXT_LVGL, 0.0f, telemetry_int_cb, &g_subject_heater_fault);
+    telemetry_subscribe(TELEMETRY_TOPIC_AIR_VOLTAGE, TELEMETRY_CONTEXT_LVGL, 0.0f, telemetry_float_cb, &g_subject_air_voltage);
+    telemetry_subscribe(TELEMETRY_TOPIC_AIR_RESISTANCE, TELEMETRY_CONTEXT_LVGL, 0.0f, telemetry_float_cb, &g_subject_air_resistance);
+    telemetry_subscribe(TELEMETRY_TOPIC_HEATER_VOLTAGE, TELEMETRY_CONTEXT_LVGL, 0.0f, telemetry_float_cb, &g_subject_heater_voltage);
+    telemetry_subscribe(TELEMETRY_TOPIC_HEATER_RESISTANCE, TELEMETRY_CONTEXT_LVGL, 0.0f, telemetry_float_cb, &g_subject_heater_resistance);
+}
+
+/* Runs in the LVGL task: applies every pending slot and telemetry value to its subject */
+static void apply_pending_cb(lv_timer_t *timer)
+{
+    (void)timer;
+    telemetry_dispatch(TELEMETRY_CONTEXT_LVGL);
+    for (int i = 0; i < SLOT_COUNT; i++)
+    {
+        lv_subject_t *subject = s_slot_subjects[i];
+        if (subject->type == LV_SUBJECT_TYPE_FLOAT)
+        {
+            float value;
+            if (subject_slot_take_float(&s_slots[i], &value))
+            {
+                lv_subject_set_float(subject, value);
+            }
+        }
+        else
+        {
+            int32_t value;
+            if (subject_slot_take_int(&s_slots[i], &value))
+            {
+                lv_subject_set_int(subject, value);
+            }
+        }
+    }
+}
 
 void subjects_init(void)
 {
@@ -36,56 +124,99 @@ void subjects_init(void)
     lv_subject_init_float(&g_subject_system_state, 0.0f);
     lv_subject_set_min_value_float(&g_subject_system_state, 0.0f);
     lv_subject_set_max_value_float(&g_subject_system_state, 3.0f);
+
+    /* Initialize drying profile subjects (no profile running) as int */
+    lv_subject_init_int(&g_subject_profile_step, -1);
+    lv_subject_init_int(&g_subject_profile_remaining, 0);
+
+    /* Initialize heater fault subject (no fault) as int */
+    lv_subject_init_int(&g_subject_heater_fault, 0);
+
+    /* Initialize session energy subjects (no session yet) as float */
+    lv_subject_init_float(&g_subject_energy_wh, 0.0f);
+    lv_subject_init_float(&g_subject_heater_avg_power, 0.0f);
+
+    /* Initialize power budget limiting subject (not limiting) as int */
+    lv_subject_init_int(&g_subject_power_limited, 0);
+
+    /* Initialize thermistor voltage/resistance subjects (no reading yet, unclamped so -999 gets through) as float */
+    lv_subject_init_float(&g_subject_air_voltage, -999.0f);
+    lv_subject_init_float(&g_subject_air_resistance, -999.0f);
+    lv_subject_init_float(&g_subject_heater_voltage, -999.0f);
+    lv_subject_init_float(&g_subject_heater_resistance, -999.0f);
+
+    /* Start applying mailbox updates once per frame (subjects_init may run more than once) */
+    lvgl_port_lock(0);
+    if (s_apply_timer == NULL)
+    {
+        subscribe_telemetry();
+        s_apply_timer = lv_timer_create(apply_pending_cb, LV_DEF_REFR_PERIOD, NULL);
+        ESP_LOGI(TAG, "Subject mailbox applied every %d ms", LV_DEF_REFR_PERIOD);
+    }
+    lvgl_port_unlock();
 }
 
 void subjects_deinit(void)
 {
+    lvgl_port_lock(0);
+    if (s_apply_timer != NULL)
+    {
+        lv_timer_delete(s_apply_timer);
+        s_apply_timer = NULL;
+    }
+    lvgl_port_unlock();
+
     /* Deinitialize all subjects */
     lv_subject_deinit(&g_subject_heater_temp);
     lv_subject_deinit(&g_subject_air_temp);
     lv_subject_deinit(&g_subject_heater_power);
     lv_subject_deinit(&g_subject_fan_speed);
     lv_subject_deinit(&g_subject_system_state);
+    lv_subject_deinit(&g_subject_profile_step);
+    lv_subject_deinit(&g_subject_profile_remaining);
+    lv_subject_deinit(&g_subject_heater_fault);
+    lv_subject_deinit(&g_subject_energy_wh);
+    lv_subject_deinit(&g_subject_heater_avg_power);
+    lv_subject_deinit(&g_subject_power_limited);
+    lv_subject_deinit(&g_subject_air_voltage);
+    lv_subject_deinit(&g_subject_air_resistance);
+    lv_subject_deinit(&g_subject_heater_voltage);
+    lv_subject_deinit(&g_subject_heater_resistance);
 }
 
 /*
  * Thread-safe setter implementations
- * These use LVGL port locking to ensure safe access from any task
+ * Setters only post to the subject's mailbox slot and never take the LVGL lock, so sensor and
+ * control tasks cannot stall behind a frame render or a stopped LVGL port. The apply timer runs in
+ * the LVGL task and pushes pending values into the subjects once per frame.
  */
 
-void subjects_set_heater_temp(float temperature)
+void subjects_set_fan_speed(float speed)
 {
-    lvgl_port_lock(0);
-    lv_subject_set_float(&g_subject_heater_temp, temperature);
-    lvgl_port_unlock();
-    ws_broadcast_data("heater", temperature);
+    subject_slot_post_float(&s_slots[SLOT_FAN_SPEED], speed);
 }
 
-void subjects_set_air_temp(float temperature)
+void subjects_set_profile_step(int step)
 {
-    lvgl_port_lock(0);
-    lv_subject_set_float(&g_subject_air_temp, temperature);
-    lvgl_port_unlock();
-    ws_broadcast_data("air", temperature);
+    subject_slot_post_int(&s_slots[SLOT_PROFILE_STEP], step);
 }
 
-void subjects_set_heater_power(float power)
+void subjects_set_profile_remaining(int seconds)
 {
-    lvgl_port_lock(0);
-    lv_subject_set_float(&g_subject_heater_power, power);
-    lvgl_port_unlock();
+    subject_slot_post_int(&s_slots[SLOT_PROFILE_REMAINING], seconds);
 }
 
-void subjects_set_fan_speed(float speed)
+void subjects_set_energy_wh(float wh)
 {
-    lvgl_port_lock(0);
-    lv_subject_set_float(&g_subject_fan_speed, speed);
-    lvgl_port_unlock();
+    subject_slot_post_float(&s_slots[SLOT_ENERGY_WH], wh);
 }
 
-void subjects_set_system_state(float state)
+void subjects_set_heater_avg_power(float watts)
 {
-    lvgl_port_lock(0);
-    lv_subject_set_float(&g_subject_system_state, state);
-    lvgl_port_unlock();
+    subject_slot_post_float(&s_slots[SLOT_HEATER_AVG_POWER], watts);
+}
+
+void subjects_set_power_limited(int limited)
+{
+    subject_slot_post_int(&s_slots[SLOT_POWER_LIMITED], limited);
 }
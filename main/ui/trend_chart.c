@@ -0,0 +1,140 @@
+#include "lvgl.h"
+#include "ui/trend_chart.h"
+#include "ui/trend_plot.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#ifdef ESP_PLATFORM
+#include "esp_heap_caps.h"
+#endif
+
+#define TREND_SERIES_AIR 0
+#define TREND_SERIES_HEATER 1
+
+/* Mean of the subject updates received since the last column */
+typedef struct
+{
+  float sum;
+  uint32_t count;
+} trend_series_t;
+
+typedef struct
+{
+  lv_obj_t *canvas;
+  lv_timer_t *timer;
+  lv_draw_buf_t buf;
+  uint16_t *pixels;
+  trend_plot_t plot;
+  trend_series_t series[TREND_PLOT_MAX_SERIES];
+} trend_chart_t;
+
+static void *alloc_pixels(size_t size)
+{
+#ifdef ESP_PLATFORM
+  /* Scrolled a few times a minute; PSRAM is plenty fast and keeps internal RAM for DMA */
+  void *data = heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
+  if (data != NULL)
+  {
+    return data;
+  }
+#endif
+  return malloc(size);
+}
+
+/**
+ * Observer callback - runs when a temperature subject changes
+ * Only accumulates; the column is drawn by the timer
+ */
+static void trend_series_observer_cb(lv_observer_t *observer, lv_subject_t *subject)
+{
+  trend_series_t *series = lv_observer_get_user_data(observer);
+  float value = lv_subject_get_float(subject);
+  if (isnan(value) || value <= TREND_PLOT_INVALID_THRESHOLD)
+  {
+    return; /* Missing reading */
+  }
+  series->sum += value;
+  series->count++;
+}
+
+/* Pushes one column and shows it */
+static void trend_chart_push(trend_chart_t *chart, const float *values)
+{
+  trend_plot_push(&chart->plot, values);
+  lv_image_cache_drop(&chart->buf); /* Same source pointer, new pixels */
+  lv_obj_invalidate(chart->canvas);
+}
+
+/**
+ * Column timer - runs once per column interval
+ * Turns the accumulated updates into one column; an interval without updates leaves a gap
+ */
+static void trend_chart_timer_cb(lv_timer_t *timer)
+{
+  trend_chart_t *chart = lv_timer_get_user_data(timer);
+  float values[TREND_PLOT_MAX_SERIES];
+  for (uint8_t i = 0; i < TREND_PLOT_MAX_SERIES; i++)
+  {
+    trend_series_t *series = &chart->series[i];
+    values[i] = series->count > 0 ? series->sum / series->count : NAN;
+    series->sum = 0.0f;
+    series->count = 0;
+  }
+  trend_chart_push(chart, values);
+}
+
+static void trend_chart_delete_cb(lv_event_t *e)
+{
+  trend_chart_t *chart = lv_event_get_user_data(e);
+  lv_timer_delete(chart->timer);
+  free(chart->pixels);
+  free(chart);
+}
+
+lv_obj_t *trend_chart_create(lv_obj_t *parent, lv_subject_t *air, lv_subject_t *heater, uint32_t window_s)
+{
+  trend_chart_t *chart = calloc(1, sizeof(trend_chart_t));
+  if (chart == NULL)
+  {
+    return NULL;
+  }
+
+  /* RGB565 whatever the display depth: the plot writes 16-bit pixels and LVGL converts on blit */
+  uint32_t stride = lv_draw_buf_width_to_stride(TREND_CHART_WIDTH, LV_COLOR_FORMAT_RGB565);
+  chart->pixels = alloc_pixels(stride * TREND_CHART_HEIGHT);
+  if (chart->pixels == NULL)
+  {
+    free(chart);
+    return NULL;
+  }
+  lv_draw_buf_init(&chart->buf, TREND_CHART_WIDTH, TREND_CHART_HEIGHT, LV_COLOR_FORMAT_RGB565, stride, chart->pixels,
+                   stride * TREND_CHART_HEIGHT);
+
+  trend_plot_init(&chart->plot, chart->pixels, TREND_CHART_WIDTH, TREND_CHART_HEIGHT, stride / sizeof(uint16_t),
+                  TREND_CHART_MIN_VALUE, TREND_CHART_MAX_VALUE);
+  chart->plot.background = lv_color_to_u16(lv_palette_darken(LV_PALETTE_GREY, 4));
+  chart->plot.grid = lv_color_to_u16(lv_palette_darken(LV_PALETTE_GREY, 2));
+  chart->plot.grid_step = TREND_CHART_GRID_STEP;
+  trend_plot_add_series(&chart->plot, lv_color_to_u16(lv_palette_main(LV_PALETTE_LIGHT_BLUE))); /* Air */
+  trend_plot_add_series(&chart->plot, lv_color_to_u16(lv_palette_main(LV_PALETTE_ORANGE)));     /* Heater */
+  trend_plot_clear(&chart->plot);
+
+  uint32_t step_ms = window_s * 1000 / TREND_CHART_WIDTH;
+  if (step_ms == 0)
+  {
+    step_ms = 1;
+  }
+  chart->canvas = lv_canvas_create(parent);
+  lv_canvas_set_draw_buf(chart->canvas, &chart->buf);
+  lv_obj_add_event_cb(chart->canvas, trend_chart_delete_cb, LV_EVENT_DELETE, chart);
+
+  chart->timer = lv_timer_create(trend_chart_timer_cb, step_ms, chart);
+
+  /* Observers are removed with the canvas */
+  lv_subject_add_observer_obj(air, trend_series_observer_cb, chart->canvas, &chart->series[TREND_SERIES_AIR]);
+  lv_subject_add_observer_obj(heater, trend_series_observer_cb, chart->canvas, &chart->series[TREND_SERIES_HEATER]);
+
+  /* Drop the initial notification: the subjects' startup values are not readings */
+  memset(chart->series, 0, sizeof(chart->series));
+  return chart->canvas;
+}
@@ -0,0 +1,123 @@
+#include "ui/trend_plot.h"
+#include <math.h>
+#include <string.h>
+
+void trend_plot_init(trend_plot_t *plot, uint16_t *pixels, uint16_t width, uint16_t height, uint32_t stride,
+                     float min_value, float max_value)
+{
+  memset(plot, 0, sizeof(*plot));
+  plot->pixels = pixels;
+  plot->width = width;
+  plot->height = height;
+  plot->stride = stride;
+  plot->min_value = min_value;
+  plot->max_value = max_value;
+}
+
+bool trend_plot_add_series(trend_plot_t *plot, uint16_t color)
+{
+  if (plot->series_count >= TREND_PLOT_MAX_SERIES)
+  {
+    return false;
+  }
+  plot->colors[plot->series_count] = color;
+  plot->last_row[plot->series_count] = -1;
+  plot->series_count++;
+  return true;
+}
+
+int16_t trend_plot_row(const trend_plot_t *plot, float value)
+{
+  if (isnan(value) || value <= TREND_PLOT_INVALID_THRESHOLD || plot->height == 0)
+  {
+    return -1;
+  }
+
+  float span = plot->max_value - plot->min_value;
+  float fraction = span > 0.0f ? (value - plot->min_value) / span : 0.0f;
+  if (fraction < 0.0f)
+  {
+    fraction = 0.0f;
+  }
+  else if (fraction > 1.0f)
+  {
+    fraction = 1.0f;
+  }
+  return (int16_t)((plot->height - 1) - lroundf(fraction * (plot->height - 1)));
+}
+
+/* Background and grid for one column */
+static void draw_background_column(trend_plot_t *plot, uint16_t x)
+{
+  for (uint16_t y = 0; y < plot->height; y++)
+  {
+    plot->pixels[y * plot->stride + x] = plot->background;
+  }
+
+  if (plot->grid_step <= 0.0f)
+  {
+    return;
+  }
+  for (float v = plot->min_value; v <= plot->max_value; v += plot->grid_step)
+  {
+    plot->pixels[trend_plot_row(plot, v) * plot->stride + x] = plot->grid;
+  }
+}
+
+void trend_plot_clear(trend_plot_t *plot)
+{
+  if (plot->width == 0)
+  {
+    return;
+  }
+
+  draw_background_column(plot, 0);
+  for (uint16_t y = 0; y < plot->height; y++)
+  {
+    uint16_t *row = &plot->pixels[y * plot->stride];
+    for (uint16_t x = 1; x < plot->width; x++)
+    {
+      row[x] = row[0];
+    }
+  }
+
+  for (uint8_t s = 0; s < plot->series_count; s++)
+  {
+    plot->last_row[s] = -1;
+  }
+}
+
+void trend_plot_push(trend_plot_t *plot, const float *values)
+{
+  if (plot->width == 0)
+  {
+    return;
+  }
+
+  /* Move the history instead of redrawing it */
+  for (uint16_t y = 0; y < plot->height; y++)
+  {
+    uint16_t *row = &plot->pixels[y * plot->stride];
+    memmove(row, row + 1, (plot->width - 1) * sizeof(uint16_t));
+  }
+
+  uint16_t x = plot->width - 1;
+  draw_background_column(plot, x);
+
+  for (uint8_t s = 0; s < plot->series_count; s++)
+  {
+    int16_t row = trend_plot_row(plot, values[s]);
+    if (row >= 0)
+    {
+      /* Join to the previous point so steep changes stay continuous */
+      int16_t from = plot->last_row[s] >= 0 ? plot->last_row[s] : row;
+      int16_t top = from < row ? from : row;
+      int16_t bottom = from < row ? row : from;
+      for (int16_t y = top; y <= bottom; y++)
+      {
+        plot->pixels[y * plot->stride + x] = plot->colors[s];
+      }
+    }
+    plot->last_row[s] = row;
+  }
+}
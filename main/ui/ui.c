@@ -2,12 +2,41 @@
 #include "lvgl.h"
 #include "ui/ui.h"
 #include "ui/analog_dial.h"
+#include "ui/value_label.h"
+#include "ui/trend_chart.h"
 #include "ui/subjects.h"
 #include "esp_log.h"
 #include "esp_lvgl_port.h"
 
 static const char *TAG = "UI";
 
+#ifdef CONFIG_UI_TREND_WINDOW_MIN
+#define TREND_WINDOW_MIN CONFIG_UI_TREND_WINDOW_MIN
+#else
+#define TREND_WINDOW_MIN 30
+#endif
+
+/* One row of sensor readouts: name, temperature, thermistor voltage and resistance */
+static void create_sensor_row(lv_obj_t *parent, const char *name, lv_subject_t *temp, lv_subject_t *voltage,
+                              lv_subject_t *resistance)
+{
+    lv_obj_t *row = lv_obj_create(parent);
+    lv_obj_remove_style_all(row);
+    lv_obj_set_size(row, lv_pct(100), LV_SIZE_CONTENT);
+    lv_obj_set_layout(row, LV_LAYOUT_FLEX);
+    lv_obj_set_flex_flow(row, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(row, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_set_style_text_color(row, lv_color_white(), LV_PART_MAIN);
+
+    lv_obj_t *name_label = lv_label_create(row);
+    lv_label_set_text(name_label, name);
+
+    /* Bound to the subjects: text changes only when the shown digits do */
+    value_label_create(row, temp, NULL, "°C", 1, 1.0f);
+    value_label_create(row, voltage, NULL, "V", 2, 1.0f);
+    value_label_create(row, resistance, NULL, "k", 1, 0.001f);
+}
+
 /* Initialize user interface */
 void init_ui(void)
 {
@@ -41,6 +70,14 @@ void init_ui(void)
         0.0f,    /* min_value */
         120.0f); /* max_value */
 
+    /* Sensor readouts */
+    create_sensor_row(lv_screen_active(), "Air", &g_subject_air_temp, &g_subject_air_voltage, &g_subject_air_resistance);
+    create_sensor_row(lv_screen_active(), "Heat", &g_subject_heater_temp, &g_subject_heater_voltage,
+                      &g_subject_heater_resistance);
+
+    /* Air and heater temperature over the last TREND_WINDOW_MIN minutes */
+    trend_chart_create(lv_screen_active(), &g_subject_air_temp, &g_subject_heater_temp, TREND_WINDOW_MIN * 60);
+
     /* Try any of the demos by uncommenting one of the lines below */
     // lv_demo_widgets();
     // lv_demo_keypad_encoder();
@@ -0,0 +1,62 @@
+#include "lvgl.h"
+#include "ui/value_label.h"
+#include "ui/value_text.h"
+#include <stdlib.h>
+#include <stdbool.h>
+
+typedef struct
+{
+  const char *prefix;
+  const char *suffix;
+  uint8_t decimals;
+  float scale;
+  int32_t shown; /* Quantized value currently in the label text */
+  bool has_text; /* shown is valid */
+} value_label_t;
+
+/**
+ * Observer callback - runs when the subject changes
+ * Rebuilds the text only if the displayed digits differ from what is shown
+ */
+static void value_label_observer_cb(lv_observer_t *observer, lv_subject_t *subject)
+{
+  value_label_t *data = lv_observer_get_user_data(observer);
+  int32_t quantized = value_text_quantize(lv_subject_get_float(subject), data->scale, data->decimals);
+  if (data->has_text && quantized == data->shown)
+  {
+    return;
+  }
+
+  char text[32];
+  value_text_format(text, sizeof(text), quantized, data->decimals, data->prefix, data->suffix);
+  lv_label_set_text(lv_observer_get_target_obj(observer), text);
+  data->shown = quantized;
+  data->has_text = true;
+}
+
+static void value_label_delete_cb(lv_event_t *e)
+{
+  free(lv_event_get_user_data(e));
+}
+
+lv_obj_t *value_label_create(lv_obj_t *parent, lv_subject_t *subject, const char *prefix, const char *suffix,
+                             uint8_t decimals, float scale)
+{
+  lv_obj_t *label = lv_label_create(parent);
+
+  value_label_t *data = calloc(1, sizeof(value_label_t));
+  if (data == NULL)
+  {
+    lv_label_set_text(label, "");
+    return label;
+  }
+  data->prefix = prefix;
+  data->suffix = suffix;
+  data->decimals = decimals;
+  data->scale = scale;
+  lv_obj_add_event_cb(label, value_label_delete_cb, LV_EVENT_DELETE, data);
+
+  /* Initial notification sets the text; the observer is removed with the label */
+  lv_subject_add_observer_obj(subject, value_label_observer_cb, label, data);
+  return label;
+}
@@ -0,0 +1,63 @@
+#include "ui/value_text.h"
+#include <math.h>
+#include <stdio.h>
+
+#define VALUE_TEXT_MAX_DECIMALS 6
+
+static int32_t pow10_i(uint8_t decimals)
+{
+  int32_t p = 1;
+  for (uint8_t i = 0; i < decimals; i++)
+  {
+    p *= 10;
+  }
+  return p;
+}
+
+int32_t value_text_quantize(float value, float scale, uint8_t decimals)
+{
+  if (isnan(value) || value <= VALUE_TEXT_INVALID_THRESHOLD)
+  {
+    return VALUE_TEXT_INVALID;
+  }
+  if (decimals > VALUE_TEXT_MAX_DECIMALS)
+  {
+    decimals = VALUE_TEXT_MAX_DECIMALS;
+  }
+
+  double scaled = round((double)value * scale * pow10_i(decimals));
+  if (scaled >= INT32_MAX)
+  {
+    return INT32_MAX;
+  }
+  if (scaled <= -INT32_MAX)
+  {
+    return -INT32_MAX; // INT32_MIN is reserved for invalid
+  }
+  return (int32_t)scaled;
+}
+
+int value_text_format(char *buf, size_t len, int32_t quantized, uint8_t decimals, const char *prefix,
+                      const char *suffix)
+{
+  prefix = prefix != NULL ? prefix : "";
+  suffix = suffix != NULL ? suffix : "";
+  if (quantized == VALUE_TEXT_INVALID)
+  {
+    return snprintf(buf, len, "%s--%s", prefix, suffix);
+  }
+  if (decimals > VALUE_TEXT_MAX_DECIMALS)
+  {
+    decimals = VALUE_TEXT_MAX_DECIMALS;
+  }
+
+  int32_t p = pow10_i(decimals);
+  uint32_t magnitude = quantized < 0 ? (uint32_t)(-(int64_t)quantized) : (uint32_t)quantized;
+  const char *sign = quantized < 0 ? "-" : "";
+  if (decimals == 0)
+  {
+    return snprintf(buf, len, "%s%s%lu%s", prefix, sign, (unsigned long)magnitude, suffix);
+  }
+  return snprintf(buf, len, "%s%s%lu.%0*lu%s", prefix, sign, (unsigned long)(magnitude / p), (int)decimals,
+                  (unsigned long)(magnitude % p), suffix);
+}
@@ -0,0 +1,70 @@
+#include "web_server.h"
+#include "esp_http_server.h"
+#include "diagnostic.h"
+#include "display_power.h"
+#include <stdio.h>
+
+// Formats one histogram as a JSON object: summary plus bucket bounds and counts
+static int format_histogram(char *buf, size_t len, const char *name, const frame_histogram_t *h)
+{
+  int n = snprintf(buf, len, "\"%s\":{\"mean\":%lu,\"p50\":%lu,\"p95\":%lu,\"max\":%lu,\"limits\":[", name,
+                   (unsigned long)frame_histogram_mean(h), (unsigned long)frame_histogram_percentile(h, 50),
+                   (unsigned long)frame_histogram_percentile(h, 95), (unsigned long)h->max);
+
+  // The last bucket is open-ended and has no limit
+  for (int i = 0; i < FRAME_HISTOGRAM_BUCKETS - 1 && n < (int)len; i++)
+  {
+    n += snprintf(buf + n, len - n, "%s%lu", i > 0 ? "," : "", (unsigned long)frame_histogram_bucket_limit(h, i));
+  }
+  for (int i = 0; i < FRAME_HISTOGRAM_BUCKETS && n < (int)len; i++)
+  {
+    n += snprintf(buf + n, len - n, "%s%lu", i > 0 ? "," : "],\"counts\":[", (unsigned long)h->counts[i]);
+  }
+  if (n < (int)len)
+  {
+    n += snprintf(buf + n, len - n, "]}");
+  }
+  return n;
+}
+
+// Handler for GET /api/display - frame rate, render/flush/interval/area histograms and display power
+esp_err_t display_profile_handler(httpd_req_t *req)
+{
+  char buf[320];
+  display_profile_t profile;
+  fps_monitor_get_profile(&profile);
+
+  httpd_resp_set_type(req, "application/json");
+  snprintf(buf, sizeof(buf), "{\"monitoring\":%s,\"fps\":%lu,\"frames\":%lu,",
+           fps_monitor_is_running() ? "true" : "false", (unsigned long)fps_monitor_get_fps(),
+           (unsigned long)profile.frames);
+  httpd_resp_sendstr_chunk(req, buf);
+
+  format_histogram(buf, sizeof(buf), "render_us", &profile.render_us);
+  httpd_resp_sendstr_chunk(req, buf);
+  httpd_resp_sendstr_chunk(req, ",");
+  format_histogram(buf, sizeof(buf), "flush_us", &profile.flush_us);
+  httpd_resp_sendstr_chunk(req, buf);
+  httpd_resp_sendstr_chunk(req, ",");
+  format_histogram(buf, sizeof(buf), "interval_us", &profile.interval_us);
+  httpd_resp_sendstr_chunk(req, buf);
+  httpd_resp_sendstr_chunk(req, ",");
+  format_histogram(buf, sizeof(buf), "area_px", &profile.area_px);
+  httpd_resp_sendstr_chunk(req, buf);
+
+  // Time and LVGL task CPU time per refresh mode: full rate, throttled, paused
+  display_power_stats_t power;
+  display_power_get_stats(&power);
+  snprintf(buf, sizeof(buf),
+           ",\"power\":{\"state\":%d,\"render_mode\":%d,\"wakes\":%lu,\"time_ms\":[%llu,%llu,%llu],"
+           "\"lvgl_cpu_ms\":[%llu,%llu,%llu]}",
+           (int)power.state, (int)power.render_mode, (unsigned long)power.wakes,
+           (unsigned long long)(power.time_us[0] / 1000), (unsigned long long)(power.time_us[1] / 1000),
+           (unsigned long long)(power.time_us[2] / 1000), (unsigned long long)(power.lvgl_run_us[0] / 1000),
+           (unsigned long long)(power.lvgl_run_us[1] / 1000), (unsigned long long)(power.lvgl_run_us[2] / 1000));
+  httpd_resp_sendstr_chunk(req, buf);
+
+  httpd_resp_sendstr_chunk(req, "}");
+  httpd_resp_sendstr_chunk(req, NULL);
+  return ESP_OK;
+}
@@ -0,0 +1,69 @@
+#include "web_server.h"
+#include "esp_http_server.h"
+#include "control_task.h"
+#include "energy_session_store.h"
+#include "heater.h"
+#include <stdio.h>
+
+int web_format_energy_session(char *buf, size_t len, const energy_session_t *session)
+{
+  int n = snprintf(buf, len,
+                   "{\"profile\":\"%s\",\"start_time\":%lu,\"duration_s\":%lu,\"energy_wh\":%.2f,"
+                   "\"avg_power_w\":%.1f,\"duty_percent\":%.1f,\"histogram\":[",
+                   session->profile, (unsigned long)session->start_time, (unsigned long)session->duration_s,
+                   session->energy_wh, session->avg_power_w, session->duty_percent);
+  for (int i = 0; i < HEATER_ENERGY_HISTOGRAM_BINS && n > 0 && (size_t)n < len; i++)
+  {
+    n += snprintf(buf + n, len - n, "%s%.1f", i > 0 ? "," : "", session->histogram_permille[i] / 10.0f);
+  }
+  if (n > 0 && (size_t)n < len)
+  {
+    n += snprintf(buf + n, len - n, "]}");
+  }
+  return n;
+}
+
+// Handler for GET /api/energy - the running session, the stored history (newest first) and the power budget
+esp_err_t energy_handler(httpd_req_t *req)
+{
+  char buf[320];
+  energy_session_t session;
+
+  httpd_resp_set_type(req, "application/json");
+  httpd_resp_sendstr_chunk(req, "{\"current\":");
+  if (control_get_energy_session(&session))
+  {
+    web_format_energy_session(buf, sizeof(buf), &session);
+    httpd_resp_sendstr_chunk(req, buf);
+  }
+  else
+  {
+    httpd_resp_sendstr_chunk(req, "null");
+  }
+
+  httpd_resp_sendstr_chunk(req, ",\"sessions\":[");
+  energy_session_t history[ENERGY_SESSION_HISTORY];
+  size_t count = energy_session_load(history, ENERGY_SESSION_HISTORY);
+  for (size_t i = 0; i < count; i++)
+  {
+    if (i > 0)
+    {
+      httpd_resp_sendstr_chunk(req, ",");
+    }
+    web_format_energy_session(buf, sizeof(buf), &history[i]);
+    httpd_resp_sendstr_chunk(req, buf);
+  }
+  httpd_resp_sendstr_chunk(req, "]");
+
+  power_limit_config_t limit;
+  heater_get_power_limit(&limit);
+  snprintf(buf, sizeof(buf),
+           ",\"power_limit\":{\"active\":%s,\"average_percent\":%.1f,\"max_average_percent\":%.1f,"
+           "\"peak_percent\":%.1f,\"window_s\":%lu}}",
+           heater_power_limited() ? "true" : "false", heater_power_average() * 100.0f / HEATER_DUTY_MAX,
+           limit.max_average * 100.0f / HEATER_DUTY_MAX, limit.peak * 100.0f / HEATER_DUTY_MAX,
+           (unsigned long)(limit.window_ms / 1000));
+  httpd_resp_sendstr_chunk(req, buf);
+  httpd_resp_sendstr_chunk(req, NULL);
+  return ESP_OK;
+}
@@ -10,10 +10,10 @@ static const char *TAG = "web_server";
 // Custom URI matching function for proper wildcard support
 bool custom_uri_match(const char *reference_uri, const char *uri_to_match, size_t match_upto)
 {
-  // Handle exact matches
+  // Handle exact matches (match_upto excludes any query string)
   if (strchr(reference_uri, '*') == NULL)
   {
-    return strcmp(reference_uri, uri_to_match) == 0;
+    return strlen(reference_uri) == match_upto && strncmp(reference_uri, uri_to_match, match_upto) == 0;
   }
 
   // Handle wildcard patterns (ending with *)
@@ -21,11 +21,11 @@ bool custom_uri_match(const char *reference_uri, const char *uri_to_match, size_
   if (reference_uri[ref_len - 1] == '*')
   {
     size_t prefix_len = ref_len - 1;
-    return strncmp(reference_uri, uri_to_match, prefix_len) == 0;
+    return match_upto >= prefix_len && strncmp(reference_uri, uri_to_match, prefix_len) == 0;
   }
 
   // Fallback to exact match
-  return strcmp(reference_uri, uri_to_match) == 0;
+  return strlen(reference_uri) == match_upto && strncmp(reference_uri, uri_to_match, match_upto) == 0;
 }
 
 // Helper function to get MIME type from file extension
@@ -0,0 +1,210 @@
+#include "web_server.h"
+#include "esp_http_server.h"
+#include "esp_log.h"
+#include "drying_profile.h"
+#include "drying_profile_store.h"
+#include "control_task.h"
+#include <string.h>
+#include <stdio.h>
+
+static const char *TAG = "web_server";
+
+#define PROFILES_URI_PREFIX "/api/profiles/"
+#define MAX_STORED_PROFILES 16
+
+/**
+ * @brief Extract the profile name that follows a URI prefix (stops at '?')
+ * @return true if a valid profile name was found
+ */
+static bool name_from_uri(const char *uri, const char *prefix, char *name, size_t len)
+{
+  size_t prefix_len = strlen(prefix);
+  if (strncmp(uri, prefix, prefix_len) != 0)
+  {
+    return false;
+  }
+
+  const char *start = uri + prefix_len;
+  size_t name_len = strcspn(start, "?");
+  if (name_len == 0 || name_len >= len)
+  {
+    return false;
+  }
+  memcpy(name, start, name_len);
+  name[name_len] = '\0';
+  return profile_name_is_valid(name);
+}
+
+// Handler for GET /api/profiles - lists built-in and uploaded profiles plus the active run
+esp_err_t profile_list_handler(httpd_req_t *req)
+{
+  char stored[MAX_STORED_PROFILES][PROFILE_NAME_MAX];
+  size_t stored_count = profile_store_list(stored, MAX_STORED_PROFILES);
+
+  profile_status_t status;
+  control_get_profile_status(&status);
+
+  httpd_resp_set_type(req, "application/json");
+  httpd_resp_sendstr_chunk(req, "{\"builtin\":[");
+
+  char buf[160];
+  for (size_t i = 0; i < profile_builtin_count(); i++)
+  {
+    snprintf(buf, sizeof(buf), "%s\"%s\"", i > 0 ? "," : "", profile_builtin_get(i)->name);
+    httpd_resp_sendstr_chunk(req, buf);
+  }
+  httpd_resp_sendstr_chunk(req, "],\"stored\":[");
+
+  for (size_t i = 0; i < stored_count; i++)
+  {
+    snprintf(buf, sizeof(buf), "%s\"%s\"", i > 0 ? "," : "", stored[i]);
+    httpd_resp_sendstr_chunk(req, buf);
+  }
+  httpd_resp_sendstr_chunk(req, "]");
+
+  if (status.running)
+  {
+    snprintf(buf, sizeof(buf),
+             ",\"active\":{\"name\":\"%s\",\"step\":%u,\"step_count\":%u,\"setpoint\":%.1f,\"remaining_s\":%lu",
+             status.name, status.step, status.step_count, status.setpoint, (unsigned long)status.remaining_s);
+    httpd_resp_sendstr_chunk(req, buf);
+    energy_session_t session;
+    if (control_get_energy_session(&session))
+    {
+      char energy[320];
+      web_format_energy_session(energy, sizeof(energy), &session);
+      httpd_resp_sendstr_chunk(req, ",\"energy\":");
+      httpd_resp_sendstr_chunk(req, energy);
+    }
+    httpd_resp_sendstr_chunk(req, "}}");
+  }
+  else
+  {
+    httpd_resp_sendstr_chunk(req, ",\"active\":null}");
+  }
+  httpd_resp_sendstr_chunk(req, NULL);
+  return ESP_OK;
+}
+
+// Handler for GET /api/profiles/<name> - returns the profile in its text form
+esp_err_t profile_get_handler(httpd_req_t *req)
+{
+  char name[PROFILE_NAME_MAX];
+  drying_profile_t profile;
+  if (!name_from_uri(req->uri, PROFILES_URI_PREFIX, name, sizeof(name)) ||
+      profile_store_find(name, &profile) != ESP_OK)
+  {
+    httpd_resp_send_404(req);
+    return ESP_OK;
+  }
+
+  char text[PROFILE_TEXT_MAX];
+  int len = profile_format(&profile, text, sizeof(text));
+  if (len < 0)
+  {
+    httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Profile too large");
+    return ESP_OK;
+  }
+
+  httpd_resp_set_type(req, "text/csv");
+  httpd_resp_send(req, text, len);
+  return ESP_OK;
+}
+
+// Handler for POST /api/profiles/<name> - validates and stores an uploaded profile in LittleFS
+esp_err_t profile_upload_handler(httpd_req_t *req)
+{
+  char name[PROFILE_NAME_MAX];
+  if (!name_from_uri(req->uri, PROFILES_URI_PREFIX, name, sizeof(name)))
+  {
+    httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid profile name");
+    return ESP_OK;
+  }
+
+  if (req->content_len == 0 || req->content_len >= PROFILE_TEXT_MAX)
+  {
+    httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Profile body empty or too large");
+    return ESP_OK;
+  }
+
+  char text[PROFILE_TEXT_MAX];
+  size_t received = 0;
+  while (received < req->content_len)
+  {
+    int ret = httpd_req_recv(req, text + received, req->content_len - received);
+    if (ret == HTTPD_SOCK_ERR_TIMEOUT)
+    {
+      continue;
+    }
+    if (ret <= 0)
+    {
+      ESP_LOGE(TAG, "Failed to receive profile body");
+      return ESP_FAIL;
+    }
+    received += (size_t)ret;
+  }
+  text[received] = '\0';
+
+  drying_profile_t profile;
+  if (!profile_parse(name, text, &profile))
+  {
+    httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Malformed profile");
+    return ESP_OK;
+  }
+
+  if (profile_store_save(&profile) != ESP_OK)
+  {
+    httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to store profile");
+    return ESP_OK;
+  }
+
+  ESP_LOGI(TAG, "Profile %s uploaded (%u steps)", name, profile.step_count);
+  httpd_resp_sendstr(req, "OK");
+  return ESP_OK;
+}
+
+// Handler for POST /api/profile/start?name=<name> - starts an uploaded or built-in profile
+esp_err_t profile_start_handler(httpd_req_t *req)
+{
+  char query[64];
+  char name[PROFILE_NAME_MAX];
+  drying_profile_t profile;
+
+  if (httpd_req_get_url_query_str(req, query, sizeof(query)) != ESP_OK ||
+      httpd_query_key_value(query, "name", name, sizeof(name)) != ESP_OK ||
+      !profile_name_is_valid(name))
+  {
+    httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Missing or invalid name");
+    return ESP_OK;
+  }
+
+  if (profile_store_find(name, &profile) != ESP_OK)
+  {
+    httpd_resp_send_404(req);
+    return ESP_OK;
+  }
+
+  control_start_profile(&profile);
+  httpd_resp_sendstr(req, "OK");
+  return ESP_OK;
+}
+
+// Handler for POST /api/profile/stop - stops the running profile
+esp_err_t profile_stop_handler(httpd_req_t *req)
+{
+  control_stop_profile();
+  httpd_resp_sendstr(req, "OK");
+  return ESP_OK;
+}
+
+// Handler for POST /api/autotune - stops any profile and auto-tunes the controller gain schedule
+esp_err_t autotune_start_handler(httpd_req_t *req)
+{
+  if (control_start_autotune() != ESP_OK)
+  {
+    httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to start auto-tune");
+    return ESP_OK;
+  }
+  httpd_resp_sendstr(req, "OK");
+  return ESP_OK;
+}
@@ -0,0 +1,44 @@
+#include "web_server.h"
+#include "esp_http_server.h"
+#include "esp_log.h"
+#include "temp.h"
+#include <stdio.h>
+
+/**
+ * @brief Append one sensor's latest status and fault counters as a JSON member
+ * @return Number of characters written (as snprintf)
+ */
+static int format_sensor(char *buf, size_t len, const char *name, temp_sensor_handle_t sensor)
+{
+  temp_sample_t sample;
+  temp_fault_counts_t faults = {0};
+  if (sensor == NULL || !temp_sensor_get_latest_sample(sensor, &sample))
+  {
+    return snprintf(buf, len, "\"%s\":null", name);
+  }
+  temp_sensor_get_fault_counts(sensor, &faults);
+
+  return snprintf(buf, len,
+                  "\"%s\":{\"temperature\":%.2f,\"status\":\"%s\",\"faults\":{\"open\":%lu,\"short\":%lu,"
+                  "\"adc\":%lu,\"implausible\":%lu}}",
+                  name, sample.temperature, temp_status_name(sample.status), (unsigned long)faults.open_circuit,
+                  (unsigned long)faults.short_circuit, (unsigned long)faults.adc_error,
+                  (unsigned long)faults.implausible);
+}
+
+// Handler for GET /api/sensors - latest reading status and fault counters of each thermistor
+esp_err_t sensors_handler(httpd_req_t *req)
+{
+  char buf[192];
+
+  httpd_resp_set_type(req, "application/json");
+  httpd_resp_sendstr_chunk(req, "{");
+  format_sensor(buf, sizeof(buf), "air", temp_sensor_get_air_sensor());
+  httpd_resp_sendstr_chunk(req, buf);
+  httpd_resp_sendstr_chunk(req, ",");
+  format_sensor(buf, sizeof(buf), "heater", temp_sensor_get_heater_sensor());
+  httpd_resp_sendstr_chunk(req, buf);
+  httpd_resp_sendstr_chunk(req, "}");
+  httpd_resp_sendstr_chunk(req, NULL);
+  return ESP_OK;
+}
@@ -2,11 +2,19 @@
 #include "esp_http_server.h"
 #include "esp_log.h"
 #include "esp_littlefs.h"
+#include "display_power.h"
 
 static const char *TAG = "web_server";
 
 httpd_handle_t server = NULL;
 
+// A new client connection counts as activity and wakes the display
+static esp_err_t session_open(httpd_handle_t hd, int sockfd)
+{
+  display_power_wake();
+  return ESP_OK;
+}
+
 esp_err_t web_server_init(void)
 {
   ESP_LOGI(TAG, "Initializing littleFS");
@@ -52,11 +60,12 @@ esp_err_t web_server_start(void)
   config.server_port = 3000;
   // Reduce resource usage to avoid conflicts
   config.max_open_sockets = 4; // Reduced from default 7
-  config.max_uri_handlers = 8; // Reduced from default 8
+  config.max_uri_handlers = 16; // Version, websocket, profiles, diagnostics and static files
   config.backlog_conn = 5;     // Reduced from default 5
   config.stack_size = 4096;    // Explicit stack size
   // Use custom URI matching function for proper wildcard support
   config.uri_match_fn = custom_uri_match;
+  config.open_fn = session_open;
 
   ESP_LOGI(TAG, "Starting HTTP server on port %d", config.server_port);
   esp_err_t ret = httpd_start(&server, &config);
@@ -82,6 +91,84 @@ esp_err_t web_server_start(void)
       .is_websocket = true};
   httpd_register_uri_handler(server, &uri_sensor);
 
+  // Drying profile API
+  httpd_uri_t uri_profile_list = {
+      .uri = "/api/profiles",
+      .method = HTTP_GET,
+      .handler = profile_list_handler,
+      .user_ctx = NULL};
+  httpd_register_uri_handler(server, &uri_profile_list);
+
+  httpd_uri_t uri_profile_get = {
+      .uri = "/api/profiles/*",
+      .method = HTTP_GET,
+      .handler = profile_get_handler,
+      .user_ctx = NULL};
+  httpd_register_uri_handler(server, &uri_profile_get);
+
+  httpd_uri_t uri_profile_upload = {
+      .uri = "/api/profiles/*",
+      .method = HTTP_POST,
+      .handler = profile_upload_handler,
+      .user_ctx = NULL};
+  httpd_register_uri_handler(server, &uri_profile_upload);
+
+  httpd_uri_t uri_profile_start = {
+      .uri = "/api/profile/start",
+      .method = HTTP_POST,
+      .handler = profile_start_handler,
+      .user_ctx = NULL};
+  httpd_register_uri_handler(server, &uri_profile_start);
+
+  httpd_uri_t uri_profile_stop = {
+      .uri = "/api/profile/stop",
+      .method = HTTP_POST,
+      .handler = profile_stop_handler,
+      .user_ctx = NULL};
+  httpd_register_uri_handler(server, &uri_profile_stop);
+
+  httpd_uri_t uri_autotune = {
+      .uri = "/api/autotune",
+      .method = HTTP_POST,
+      .handler = autotune_start_handler,
+      .user_ctx = NULL};
+  httpd_register_uri_handler(server, &uri_autotune);
+
+  httpd_uri_t uri_trace = {
+      .uri = "/api/trace",
+      .method = HTTP_GET,
+      .handler = trace_handler,
+      .user_ctx = NULL};
+  httpd_register_uri_handler(server, &uri_trace);
+
+  httpd_uri_t uri_sensors = {
+      .uri = "/api/sensors",
+      .method = HTTP_GET,
+      .handler = sensors_handler,
+      .user_ctx = NULL};
+  httpd_register_uri_handler(server, &uri_sensors);
+
+  httpd_uri_t uri_energy = {
+      .uri = "/api/energy",
+      .method = HTTP_GET,
+      .handler = energy_handler,
+      .user_ctx = NULL};
+  httpd_register_uri_handler(server, &uri_energy);
+
+  httpd_uri_t uri_telemetry = {
+      .uri = "/api/telemetry",
+      .method = HTTP_GET,
+      .handler = telemetry_handler,
+      .user_ctx = NULL};
+  httpd_register_uri_handler(server, &uri_telemetry);
+
+  httpd_uri_t uri_display = {
+      .uri = "/api/display",
+      .method = HTTP_GET,
+      .handler = display_profile_handler,
+      .user_ctx = NULL};
+  httpd_register_uri_handler(server, &uri_display);
+
   // Single catch-all handler for static files (like ESP-IDF file serving example)
   httpd_uri_t uri_static = {
       .uri = "/*",
@@ -0,0 +1,28 @@
+#include "web_server.h"
+#include "esp_http_server.h"
+#include "telemetry_bus.h"
+#include <stdio.h>
+
+// Handler for GET /api/telemetry - per-topic publish/delivery counts and delivery latency
+esp_err_t telemetry_handler(httpd_req_t *req)
+{
+  char buf[200];
+
+  httpd_resp_set_type(req, "application/json");
+  httpd_resp_sendstr_chunk(req, "{\"topics\":[");
+  for (int i = 0; i < TELEMETRY_TOPIC_COUNT; i++)
+  {
+    telemetry_topic_stats_t stats;
+    telemetry_get_stats((telemetry_topic_t)i, &stats);
+    snprintf(buf, sizeof(buf),
+             "%s{\"name\":\"%s\",\"publishes\":%lu,\"deliveries\":%lu,\"coalesced\":%lu,"
+             "\"last_latency_us\":%lu,\"max_latency_us\":%lu}",
+             i > 0 ? "," : "", telemetry_topic_name((telemetry_topic_t)i), (unsigned long)stats.publishes,
+             (unsigned long)stats.deliveries, (unsigned long)stats.coalesced,
+             (unsigned long)stats.last_latency_us, (unsigned long)stats.max_latency_us);
+    httpd_resp_sendstr_chunk(req, buf);
+  }
+  httpd_resp_sendstr_chunk(req, "]}");
+  httpd_resp_sendstr_chunk(req, NULL);
+  return ESP_OK;
+}
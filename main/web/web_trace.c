@@ -0,0 +1,58 @@
+#include "web_server.h"
+#include "esp_http_server.h"
+#include "esp_log.h"
+#include "controller_trace.h"
+
+static const char *TAG = "web_server";
+
+#define TRACE_CHUNK_RECORDS 64 // 1 KB per chunk keeps the httpd task stack small
+
+// Handler for GET /api/trace - streams the controller trace ring as binary (see scripts/decode_trace.py)
+esp_err_t trace_handler(httpd_req_t *req)
+{
+  if (!controller_trace_enabled())
+  {
+    httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "Trace not enabled");
+    return ESP_OK;
+  }
+
+  // Records written while streaming only shift the window; the header count is the snapshot taken here
+  uint32_t total = controller_trace_total();
+  size_t count = controller_trace_count();
+  controller_trace_header_t header = {
+      .magic = CONTROLLER_TRACE_MAGIC,
+      .version = CONTROLLER_TRACE_VERSION,
+      .record_size = sizeof(controller_trace_record_t),
+      .count = (uint32_t)count,
+      .dropped = total - (uint32_t)count,
+  };
+
+  httpd_resp_set_type(req, "application/octet-stream");
+  httpd_resp_set_hdr(req, "Content-Disposition", "attachment; filename=\"controller_trace.bin\"");
+  if (httpd_resp_send_chunk(req, (const char *)&header, sizeof(header)) != ESP_OK)
+  {
+    return ESP_FAIL;
+  }
+
+  controller_trace_record_t chunk[TRACE_CHUNK_RECORDS];
+  size_t sent = 0;
+  while (sent < count)
+  {
+    size_t want = count - sent < TRACE_CHUNK_RECORDS ? count - sent : TRACE_CHUNK_RECORDS;
+    size_t n = controller_trace_read(sent, chunk, want);
+    if (n == 0)
+    {
+      break;
+    }
+    if (httpd_resp_send_chunk(req, (const char *)chunk, n * sizeof(controller_trace_record_t)) != ESP_OK)
+    {
+      ESP_LOGW(TAG, "Trace export aborted after %u records", (unsigned)sent);
+      return ESP_FAIL;
+    }
+    sent += n;
+  }
+
+  httpd_resp_send_chunk(req, NULL, 0);
+  ESP_LOGI(TAG, "Trace exported: %u records", (unsigned)sent);
+  return ESP_OK;
+}
@@ -3,15 +3,22 @@
 #include "esp_log.h"
 #include "circular_buffer.h"
 #include "temp.h"
-#include "ui/subjects.h"
+#include "telemetry_bus.h"
+#include "esp_timer.h"
 #include "wifi.h"
+#include <stdatomic.h>
 #include <string.h>
 #include <stdlib.h>
 
+#define WS_TELEMETRY_MAX_RATE_HZ 2.0f // Per sensor; readings arrive at 1 Hz
+#define WS_DISPATCH_PERIOD_MS 100     // How often pending telemetry is handed to the HTTP server task
+
 static const char *TAG = "web_server";
 
 static struct ws_session_ctx *g_first_session = NULL;
 static bool g_ws_registered = false;
+static esp_timer_handle_t s_ws_dispatch_timer = NULL;
+static atomic_bool s_ws_dispatch_queued;
 
 typedef struct ws_session_ctx ws_session_ctx_t;
 
@@ -63,27 +70,43 @@ void ws_broadcast_data(const char *sensor, float temperature)
 }
 
 /**
- * @brief LVGL observer callback for air temperature subject changes
- * @param observer Pointer to the observer (unused)
- * @param subject Pointer to the air temperature subject
- * @note Broadcasts only the air temperature to WebSocket clients
+ * @brief Telemetry bus subscriber for the temperature topics
+ * @param topic Topic the value was published on (unused)
+ * @param temperature Latest temperature reading
+ * @param ctx Sensor identifier passed at subscription ("air" or "heater")
+ * @note Runs in the HTTP server task, which also owns the session list
  */
-static void air_temp_subject_callback(lv_observer_t *observer, lv_subject_t *subject)
+static void ws_telemetry_callback(telemetry_topic_t topic, float temperature, void *ctx)
 {
-  float air_temp = lv_subject_get_float(subject);
-  ws_broadcast_data("air", air_temp);
+  ws_broadcast_data((const char *)ctx, temperature);
 }
 
 /**
- * @brief LVGL observer callback for heater temperature subject changes
- * @param observer Pointer to the observer (unused)
- * @param subject Pointer to the heater temperature subject
- * @note Broadcasts only the heater temperature to WebSocket clients
+ * @brief Work item queued on the HTTP server task to deliver pending telemetry
+ * @param arg Unused
  */
-static void heater_temp_subject_callback(lv_observer_t *observer, lv_subject_t *subject)
+static void ws_dispatch_work(void *arg)
 {
-  float heater_temp = lv_subject_get_float(subject);
-  ws_broadcast_data("heater", heater_temp);
+  atomic_store(&s_ws_dispatch_queued, false);
+  telemetry_dispatch(TELEMETRY_CONTEXT_WEB);
+}
+
+/**
+ * @brief Periodic esp_timer callback that schedules a web telemetry dispatch
+ * @param arg Unused
+ * @note At most one work item is queued at a time, and none while nothing is pending
+ */
+static void ws_dispatch_timer_callback(void *arg)
+{
+  if (server == NULL || !telemetry_context_pending(TELEMETRY_CONTEXT_WEB) ||
+      atomic_exchange(&s_ws_dispatch_queued, true))
+  {
+    return;
+  }
+  if (httpd_queue_work(server, ws_dispatch_work, NULL) != ESP_OK)
+  {
+    atomic_store(&s_ws_dispatch_queued, false);
+  }
 }
 
 /**
@@ -191,35 +214,44 @@ static void cleanup_session_context(httpd_req_t *req, ws_session_ctx_t *sess)
 }
 
 /**
- * @brief Initialize WebSocket client registry and subscribe to temperature subjects
+ * @brief Initialize WebSocket client registry and subscribe to the temperature topics
  * @return ESP_OK on success
- * @note Registers callbacks with LVGL subjects; only runs once (g_ws_registered guard)
+ * @note Subscribes in the web context; only runs once (g_ws_registered guard)
  */
 esp_err_t ws_clients_init(void)
 {
   if (!g_ws_registered)
   {
-    ESP_LOGI(TAG, "Registering WebSocket observers for temperature subjects");
-    lv_subject_add_observer(&g_subject_air_temp, air_temp_subject_callback, NULL);
-    lv_subject_add_observer(&g_subject_heater_temp, heater_temp_subject_callback, NULL);
+    ESP_LOGI(TAG, "Subscribing WebSocket clients to temperature telemetry");
+    if (!telemetry_subscribe(TELEMETRY_TOPIC_AIR_TEMP, TELEMETRY_CONTEXT_WEB, WS_TELEMETRY_MAX_RATE_HZ,
+                             ws_telemetry_callback, (void *)"air") ||
+        !telemetry_subscribe(TELEMETRY_TOPIC_HEATER_TEMP, TELEMETRY_CONTEXT_WEB, WS_TELEMETRY_MAX_RATE_HZ,
+                             ws_telemetry_callback, (void *)"heater"))
+    {
+      return ESP_FAIL;
+    }
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = ws_dispatch_timer_callback,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "ws_dispatch",
+    };
+    esp_err_t ret = esp_timer_create(&timer_args, &s_ws_dispatch_timer);
+    if (ret == ESP_OK)
+    {
+      ret = esp_timer_start_periodic(s_ws_dispatch_timer, WS_DISPATCH_PERIOD_MS * 1000);
+    }
+    if (ret != ESP_OK)
+    {
+      ESP_LOGE(TAG, "Failed to start WebSocket dispatch timer: %s", esp_err_to_name(ret));
+      return ret;
+    }
     g_ws_registered = true;
-    ESP_LOGI(TAG, "WebSocket subscribed to temperature subjects");
+    ESP_LOGI(TAG, "WebSocket subscribed to temperature telemetry");
   }
   return ESP_OK;
 }
 
-/**
- * @brief Broadcast current sensor readings to all WebSocket clients
- * @note Used for explicit data requests ("get_data" message)
- */
-void ws_broadcast_latest_sensor_data(void)
-{
-  float air_temp = lv_subject_get_float(&g_subject_air_temp);
-  float heater_temp = lv_subject_get_float(&g_subject_heater_temp);
-  ws_broadcast_data("air", air_temp);
-  ws_broadcast_data("heater", heater_temp);
-}
-
 /**
  * @brief Send temperature data as JSON to a specific WebSocket client
  * @param req HTTP request
@@ -228,8 +260,10 @@ void ws_broadcast_latest_sensor_data(void)
  */
 static void send_sensor_data_json(httpd_req_t *req, ws_session_ctx_t *sess)
 {
-  float air_temp = lv_subject_get_float(&g_subject_air_temp);
-  float heater_temp = lv_subject_get_float(&g_subject_heater_temp);
+  float air_temp = 0.0f;
+  float heater_temp = 0.0f;
+  telemetry_get_latest(TELEMETRY_TOPIC_AIR_TEMP, &air_temp);
+  telemetry_get_latest(TELEMETRY_TOPIC_HEATER_TEMP, &heater_temp);
   uint64_t epoch_ms = wifi_get_epoch_ms();
 
   char json_data[256];
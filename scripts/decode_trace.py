@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+"""
+Decode the controller trace exported by GET /api/trace into CSV.
+
+Usage:
+    curl -o trace.bin http://<device>:3000/api/trace
+    python scripts/decode_trace.py trace.bin > trace.csv
+
+The binary layout matches include/controller_trace.h.
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+TRACE_MAGIC = 0x43525443
+TRACE_VERSION = 1
+
+# controller_trace_header_t / controller_trace_record_t, little-endian
+HEADER = struct.Struct("<IHHII")
+RECORD = struct.Struct("<IhhhBBHH")
+
+STATE_MASK = 0x03
+FLAG_OVERRIDE = 0x04
+FLAG_ACTIVE = 0x08
+FLAG_AUTOTUNE = 0x10
+ZONE_SHIFT = 5
+ZONE_MASK = 0x60
+FLAG_FAULT = 0x80
+
+STATES = ["IDLE", "HEATING_FULL_POWER", "MODULATING_HEATER_TEMP", "MAINTAINING_AIR_TEMP"]
+
+COLUMNS = ["timestamp_s", "zone", "state", "active", "override", "autotune", "fault",
+           "heater_temp", "air_temp", "reference", "power", "loop_us", "sequence", "gap"]
+
+
+def decode(data):
+    """Yield one dict per record, oldest first."""
+    if len(data) < HEADER.size:
+        raise ValueError("file too short for trace header")
+
+    magic, version, record_size, count, dropped = HEADER.unpack_from(data, 0)
+    if magic != TRACE_MAGIC:
+        raise ValueError(f"bad magic 0x{magic:08x}, not a controller trace")
+    if version != TRACE_VERSION or record_size != RECORD.size:
+        raise ValueError(f"unsupported trace version {version} / record size {record_size}")
+
+    available = (len(data) - HEADER.size) // RECORD.size
+    if available < count:
+        print(f"warning: header says {count} records, file holds {available}", file=sys.stderr)
+        count = available
+    if dropped:
+        print(f"note: {dropped} older records were overwritten on the device", file=sys.stderr)
+
+    previous_seq = None
+    for i in range(count):
+        (timestamp_ms, heater, air, reference, power, flags, loop_us,
+         sequence) = RECORD.unpack_from(data, HEADER.size + i * RECORD.size)
+
+        # Sequence is the low 16 bits of the record number; a jump means records were lost
+        gap = 0 if previous_seq is None else (sequence - previous_seq - 1) & 0xFFFF
+        previous_seq = sequence
+
+        yield {
+            "timestamp_s": f"{timestamp_ms / 1000:.3f}",
+            "zone": (flags & ZONE_MASK) >> ZONE_SHIFT,
+            "state": STATES[flags & STATE_MASK],
+            "active": int(bool(flags & FLAG_ACTIVE)),
+            "override": int(bool(flags & FLAG_OVERRIDE)),
+            "autotune": int(bool(flags & FLAG_AUTOTUNE)),
+            "fault": int(bool(flags & FLAG_FAULT)),
+            "heater_temp": f"{heater / 10:.1f}",
+            "air_temp": f"{air / 10:.1f}",
+            "reference": f"{reference / 10:.1f}",
+            "power": power,
+            "loop_us": loop_us,
+            "sequence": sequence,
+            "gap": gap,
+        }
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode a controller trace export into CSV")
+    parser.add_argument("input", help="binary file saved from /api/trace")
+    parser.add_argument("-o", "--output", help="CSV file to write (default: stdout)")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as f:
+        data = f.read()
+
+    out = open(args.output, "w", newline="") if args.output else sys.stdout
+    try:
+        writer = csv.DictWriter(out, fieldnames=COLUMNS)
+        writer.writeheader()
+        for row in decode(data):
+            writer.writerow(row)
+    except ValueError as e:
+        print(f"error: {e}", file=sys.stderr)
+        return 1
+    finally:
+        if out is not sys.stdout:
+            out.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())